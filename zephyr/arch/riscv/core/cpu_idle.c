@@ -9,9 +9,11 @@
 /*
  * In RISC-V there is no conventional way to handle CPU power save.
  * Each RISC-V SOC handles it in its own way.
- * Hence, by default, arch_cpu_idle and arch_cpu_atomic_idle functions just
- * unlock interrupts and return to the caller, without issuing any CPU power
- * saving instruction.
+ * Hence, by default, arch_cpu_idle and arch_cpu_atomic_idle functions only
+ * wait for an interrupt with wfi before unlocking interrupts and returning
+ * to the caller. A pending interrupt enabled in mie wakes the hart up even
+ * when mstatus.MIE is clear, so waiting with interrupts still locked
+ * cannot miss a wakeup; the interrupt is taken on unlock.
  *
  * Nonetheless, define the default arch_cpu_idle and arch_cpu_atomic_idle
  * functions as weak functions, so that they can be replaced at the SOC-level.
@@ -19,10 +21,12 @@
 
 void __weak arch_cpu_idle(void)
 {
+	__asm__ volatile("wfi");
 	irq_unlock(MSTATUS_IEN);
 }
 
 void __weak arch_cpu_atomic_idle(unsigned int key)
 {
+	__asm__ volatile("wfi");
 	irq_unlock(key);
 }
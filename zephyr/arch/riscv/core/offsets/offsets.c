@@ -27,6 +27,11 @@
 
 /* thread_arch_t member offsets */
 GEN_OFFSET_SYM(_thread_arch_t, swap_return_value);
+#ifdef CONFIG_RISCV_LAZY_FPU_SHARING
+GEN_OFFSET_SYM(_thread_arch_t, fp);
+GEN_OFFSET_SYM(z_riscv_fp_context_t, fregs);
+GEN_OFFSET_SYM(z_riscv_fp_context_t, fcsr);
+#endif
 #if defined(CONFIG_USERSPACE)
 GEN_OFFSET_SYM(_thread_arch_t, priv_stack_start);
 GEN_OFFSET_SYM(_thread_arch_t, user_sp);
@@ -34,6 +39,10 @@ GEN_OFFSET_SYM(_thread_arch_t, user_sp);
 
 /* struct coop member offsets */
 GEN_OFFSET_SYM(_callee_saved_t, sp);
+GEN_OFFSET_SYM(_callee_saved_t, ra);
+#ifdef CONFIG_THREAD_LOCAL_STORAGE
+GEN_OFFSET_SYM(_callee_saved_t, tp);
+#endif
 GEN_OFFSET_SYM(_callee_saved_t, s0);
 GEN_OFFSET_SYM(_callee_saved_t, s1);
 GEN_OFFSET_SYM(_callee_saved_t, s2);
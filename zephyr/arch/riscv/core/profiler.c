@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2021 Microchip Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief RISC-V sample source of the sampling profiler
+ *
+ * Samples are taken from the machine timer interrupt. The cores at hand
+ * have no counter overflow interrupt, so the hardware performance
+ * counters do not trigger samples: their increments between two samples
+ * are recorded as weights instead.
+ */
+
+#include <kernel.h>
+#include <arch/riscv/csr.h>
+#include <debug/sampling_profiler.h>
+
+#define NUM_EVENTS CONFIG_SAMPLING_PROFILER_EVENTS
+
+#if NUM_EVENTS > 0
+static inline void read_events(uint32_t *events)
+{
+	/* Writing the selectors is cheap, and doing it on every sample
+	 * sets them up on each hart without any cross-hart call
+	 */
+	csr_write(mhpmevent3, CONFIG_RISCV_PROFILER_MHPMEVENT3);
+	events[0] = (uint32_t)csr_read(mhpmcounter3);
+#if NUM_EVENTS > 1
+	csr_write(mhpmevent4, CONFIG_RISCV_PROFILER_MHPMEVENT4);
+	events[1] = (uint32_t)csr_read(mhpmcounter4);
+#endif
+#if NUM_EVENTS > 2
+	csr_write(mhpmevent5, CONFIG_RISCV_PROFILER_MHPMEVENT5);
+	events[2] = (uint32_t)csr_read(mhpmcounter5);
+#endif
+#if NUM_EVENTS > 3
+	csr_write(mhpmevent6, CONFIG_RISCV_PROFILER_MHPMEVENT6);
+	events[3] = (uint32_t)csr_read(mhpmcounter6);
+#endif
+}
+#endif
+
+void z_sampling_profiler_sample(void)
+{
+	/* Interrupts do not nest, so mepc still holds the interrupted
+	 * program counter
+	 */
+	uintptr_t pc = csr_read(mepc);
+
+#if NUM_EVENTS > 0
+	uint32_t events[NUM_EVENTS];
+
+	read_events(events);
+	z_sampling_profiler_record(pc, events);
+#else
+	z_sampling_profiler_record(pc, NULL);
+#endif
+}
@@ -12,6 +12,7 @@
 #include <device.h>
 #include <kernel.h>
 #include <kernel_structs.h>
+#include <kernel_internal.h>
 #include <ksched.h>
 #include <soc.h>
 #include <init.h>
@@ -40,7 +41,12 @@ volatile struct {
 /* we will index directly off of mhartid so need to be careful... */
 volatile __noinit uint64_t hart_wake_flags[WAKE_FLAG_COUNT];
 
-volatile char *riscv_cpu_sp;
+/*
+ * Initial stack pointer of each secondary hart, also indexed by mhartid.
+ * Each hart reads its own entry so that several harts can be released at
+ * the same time.
+ */
+volatile char *riscv_cpu_sp[WAKE_FLAG_COUNT];
 /*
  * _curr_cpu is used to record the struct of _cpu_t of each cpu.
  * for efficient usage in assembly
@@ -62,20 +68,26 @@ void arch_start_cpu(int cpu_num, k_thread_stack_t *stack, int sz,
 	riscv_cpu_init[cpu_num].fn = fn;
 	riscv_cpu_init[cpu_num].arg = arg;
 
-	/* set the initial sp of target sp through riscv_cpu_sp
-	 * Controlled sequencing of start up will ensure
-	 * only one secondary cpu can read it per time 
-	 */
-	riscv_cpu_sp = Z_THREAD_STACK_BUFFER(stack) + sz;
+	/* set the initial sp of the target hart through its own slot */
+	riscv_cpu_sp[hart_num] = Z_THREAD_STACK_BUFFER(stack) + sz;
 
 	/* wait slave cpu to start */
 	while (hart_wake_flags[hart_num] != RV_WAKE_WAIT) {
 		counter++;
 	}
-		
+
+	/* The init record must be visible before the hart sees GO */
+	__asm__ volatile ("fence rw, w" : : : "memory");
+
 	hart_wake_flags[hart_num] = RV_WAKE_GO;
 	RISCV_CLINT->MSIP[hart_num] = 0x01U;   /*raise soft interrupt for hart(x) where x== hart ID*/
 
+#if defined(CONFIG_RISCV_SMP_PARALLEL_BOOT)
+	/* Don't wait for the hart to pick up its record, it clears its
+	 * own soft interrupt in z_riscv_secondary_start()
+	 */
+	ARG_UNUSED(counter);
+#else
 	while (hart_wake_flags[hart_num] != RV_WAKE_DONE) {
 		counter++;
 		if(0 == (counter % 64)) {
@@ -84,6 +96,7 @@ void arch_start_cpu(int cpu_num, k_thread_stack_t *stack, int sz,
 	}
 
     RISCV_CLINT->MSIP[hart_num] = 0x00U;   /* Clear int now we are done */
+#endif
 }
 
 /* the C entry of slave cores */
@@ -97,8 +110,20 @@ void z_riscv_secondary_start(int cpu_num)
 
 #endif
 #endif
+#if defined(CONFIG_RISCV_SMP_PARALLEL_BOOT)
+    /* Wake up interrupt raised by arch_start_cpu() */
+    RISCV_CLINT->MSIP[cpu_num + CONFIG_SMP_BASE_CPU] = 0x00U;
+#endif
 #if defined(CONFIG_SCHED_IPI_SUPPORTED)
     irq_enable(RISCV_MACHINE_SOFT_IRQ);
+#endif
+#if defined(CONFIG_PLIC_PER_HART_CONTEXT)
+    /* PLIC context of this hart was set up by the boot hart */
+    irq_enable(RISCV_MACHINE_EXT_IRQ);
+#endif
+#if defined(CONFIG_TIMING_FUNCTIONS)
+	/* Before the hart runs threads which may take timing samples */
+	z_riscv_timing_calibrate();
 #endif
 	/* call the function set by arch_start_cpu */
 	fn = riscv_cpu_init[cpu_num].fn;
@@ -118,18 +143,27 @@ static void sched_ipi_handler(const void *unused)
     z_sched_ipi();
 }
 
-void arch_sched_ipi(void)
+void arch_sched_directed_ipi(uint32_t cpu_bitmap)
 {
     uint32_t i;
 
-    /* broadcast sched_ipi request to other cores
-     * if the target is current core, hardware will ignore it
-     */
+    /* Only raise the soft interrupt of the harts in the mask */
     for (i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
-        RISCV_CLINT->MSIP[i + CONFIG_SMP_BASE_CPU] = 0x01U;   /*raise soft interrupt for hart(x) where x== hart ID*/
+        if ((cpu_bitmap & BIT(i)) != 0U) {
+            RISCV_CLINT->MSIP[i + CONFIG_SMP_BASE_CPU] = 0x01U;   /*raise soft interrupt for hart(x) where x== hart ID*/
+        }
     }
 }
 
+void arch_sched_ipi(void)
+{
+    /* broadcast sched_ipi request to other cores, a soft interrupt
+     * raised for the current hart would be taken too so skip it
+     */
+    arch_sched_directed_ipi(BIT_MASK(CONFIG_MP_NUM_CPUS) &
+                            ~BIT(arch_curr_cpu()->id));
+}
+
 static int riscv_smp_init(const struct device *dev)
 {
     ARG_UNUSED(dev);
@@ -9,6 +9,7 @@
 #include <ksched.h>
 #include <arch/riscv/csr.h>
 #include <stdio.h>
+#include <string.h>
 #include <core_pmp.h>
 
 #ifdef CONFIG_USERSPACE
@@ -26,6 +27,11 @@ void z_thread_entry_wrapper(k_thread_entry_t thread,
 			    void *arg2,
 			    void *arg3);
 
+#ifdef CONFIG_USE_SWITCH
+/* Restores the initial stack frame of a new thread, see isr.S */
+void z_riscv_thread_start(void);
+#endif
+
 void arch_new_thread(struct k_thread *thread, k_thread_stack_t *stack,
 		     char *stack_ptr, k_thread_entry_t entry,
 		     void *p1, void *p2, void *p3)
@@ -61,7 +67,9 @@ void arch_new_thread(struct k_thread *thread, k_thread_stack_t *stack,
 	 * This shall allow to handle nested interrupts.
 	 *
 	 * Given that context switching is performed via a system call exception
-	 * within the RISCV architecture implementation, initially set:
+	 * within the RISCV architecture implementation (or, with
+	 * CONFIG_USE_SWITCH, resumes through the same exception exit path),
+	 * initially set:
 	 * 1) MSTATUS to MSTATUS_DEF_RESTORE in the thread stack to enable
 	 *    interrupts when the newly created thread will be scheduled;
 	 * 2) MEPC to the address of the z_thread_entry_wrapper in the thread
@@ -87,7 +95,13 @@ void arch_new_thread(struct k_thread *thread, k_thread_stack_t *stack,
 	}
 #endif /* CONFIG_PMP_STACK_GUARD */
 
-#if defined(CONFIG_FPU) && defined(CONFIG_FPU_SHARING)
+#if defined(CONFIG_RISCV_LAZY_FPU_SHARING)
+	/*
+	 * Lazy shared FP mode: the FPU is off when the thread starts, its
+	 * FP context is loaded on its first floating-point instruction.
+	 */
+	(void)memset(&thread->arch.fp, 0, sizeof(thread->arch.fp));
+#elif defined(CONFIG_FPU) && defined(CONFIG_FPU_SHARING)
 	/* Shared FP mode: enable FPU of threads with K_FP_REGS. */
 	if ((thread->base.user_options & K_FP_REGS) != 0) {
 		stack_init->mstatus |= MSTATUS_FS_INIT;
@@ -122,18 +136,34 @@ void arch_new_thread(struct k_thread *thread, k_thread_stack_t *stack,
 	stack_init->soc_context = soc_esf_init;
 #endif
 
-#if defined(CONFIG_SMP)
+#ifdef CONFIG_USE_SWITCH
 	thread->switch_handle = thread;
 #endif
 	thread->callee_saved.sp = (ulong_t)stack_init;
-	
+
+#ifdef CONFIG_USE_SWITCH
+	/*
+	 * arch_switch_riscv() "returns" into z_riscv_thread_start, which
+	 * restores the initial stack frame above like an interrupt exit.
+	 */
+	thread->callee_saved.ra = (ulong_t)z_riscv_thread_start;
+#ifdef CONFIG_THREAD_LOCAL_STORAGE
+	thread->callee_saved.tp = (ulong_t)thread->tls;
+#endif
+#endif /* CONFIG_USE_SWITCH */
 }
 
 void *z_arch_get_next_switch_handle(struct k_thread **old_thread)
 {
 	*old_thread =  _current;
 
-	return z_get_next_switch_handle(*old_thread);
+	/*
+	 * The handle of the interrupted thread is only published by
+	 * arch_switch_riscv(), once its context is saved: another CPU must
+	 * not pick the thread up before that. NULL is returned when there is
+	 * nothing to switch to.
+	 */
+	return z_get_next_switch_handle(NULL);
 }
 
 #if defined(CONFIG_FPU) && defined(CONFIG_FPU_SHARING)
@@ -149,8 +179,10 @@ int arch_float_disable(struct k_thread *thread)
 		return -EINVAL;
 	}
 
-	/* Ensure a preemptive context switch does not occur */
-	key = irq_lock();
+	/* Ensure a preemptive context switch does not occur. Only the
+	 * current CPU matters, so the SMP global lock is not needed.
+	 */
+	key = arch_irq_lock();
 
 	/* Disable all floating point capabilities for the thread */
 	thread->base.user_options &= ~K_FP_REGS;
@@ -163,7 +195,7 @@ int arch_float_disable(struct k_thread *thread)
 		: "r" (MSTATUS_FS_MASK)
 		);
 
-	irq_unlock(key);
+	arch_irq_unlock(key);
 
 	return 0;
 }
@@ -181,12 +213,19 @@ int arch_float_enable(struct k_thread *thread, unsigned int options)
 		return -EINVAL;
 	}
 
-	/* Ensure a preemptive context switch does not occur */
-	key = irq_lock();
+	/* Ensure a preemptive context switch does not occur. Only the
+	 * current CPU matters, so the SMP global lock is not needed.
+	 */
+	key = arch_irq_lock();
 
 	/* Enable all floating point capabilities for the thread. */
 	thread->base.user_options |= K_FP_REGS;
 
+	/*
+	 * With lazy FP sharing the FPU is left off, the next floating-point
+	 * instruction of the thread traps and loads its FP context.
+	 */
+#ifndef CONFIG_RISCV_LAZY_FPU_SHARING
 	/* Set the FS bits to Initial to enable the FPU. */
 	__asm__ volatile (
 		"mv t0, %0\n"
@@ -194,8 +233,9 @@ int arch_float_enable(struct k_thread *thread, unsigned int options)
 		:
 		: "r" (MSTATUS_FS_INIT)
 		);
+#endif
 
-	irq_unlock(key);
+	arch_irq_unlock(key);
 
 	return 0;
 }
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2021 Microchip Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief RISC-V timing functions based on the hart counters
+ *
+ * The counter is mcycle or minstret of the current hart, or mtime.
+ * The hart counters run at the clock of their hart and are not
+ * synchronized between harts, so their rate is calibrated against mtime
+ * on each hart, and both ends of a measurement must be taken on the
+ * same hart. The hart is kept in the top bits of each sample, and cycle
+ * counts are scaled to the rate of the boot hart, which is the one
+ * reported as the timing frequency.
+ */
+
+#include <kernel.h>
+#include <kernel_internal.h>
+#include <init.h>
+#include <sys_clock.h>
+#include <timing/timing.h>
+
+#if defined(CONFIG_RISCV_TIMING_MINSTRET)
+#define COUNTER_CSR "minstret"
+#define COUNTER_CSR_H "minstreth"
+#else
+#define COUNTER_CSR "mcycle"
+#define COUNTER_CSR_H "mcycleh"
+#endif
+
+/* Time spent calibrating the counter of a hart */
+#define CALIBRATION_US (10 * USEC_PER_MSEC)
+
+#if !defined(CONFIG_RISCV_TIMING_MTIME)
+/* Counter rate of each CPU, 0 until calibrated */
+static uint64_t counter_freq[CONFIG_MP_NUM_CPUS];
+
+/* Samples carry the CPU they were taken on in their top bits */
+#define SAMPLE_CPU_SHIFT 60
+#define SAMPLE_COUNT_MASK (BIT64(SAMPLE_CPU_SHIFT) - 1)
+
+BUILD_ASSERT(CONFIG_MP_NUM_CPUS <= BIT(64 - SAMPLE_CPU_SHIFT));
+#endif
+
+static inline uint64_t counter_get(void)
+{
+#if defined(CONFIG_RISCV_TIMING_MTIME)
+	return k_cycle_get_64();
+#elif defined(CONFIG_64BIT)
+	uint64_t val;
+
+	__asm__ volatile("csrr %0, " COUNTER_CSR : "=r" (val));
+
+	return val;
+#else
+	uint32_t lo, hi, hi2;
+
+	/* Guard against a carry into the high word between the reads */
+	do {
+		__asm__ volatile("csrr %0, " COUNTER_CSR_H : "=r" (hi));
+		__asm__ volatile("csrr %0, " COUNTER_CSR : "=r" (lo));
+		__asm__ volatile("csrr %0, " COUNTER_CSR_H : "=r" (hi2));
+	} while (hi != hi2);
+
+	return ((uint64_t)hi << 32) | lo;
+#endif
+}
+
+#if !defined(CONFIG_RISCV_TIMING_MTIME)
+static uint64_t calibrate(void)
+{
+	uint64_t mtime_start, mtime_end, cnt_start, cnt_end;
+
+	do {
+		mtime_start = k_cycle_get_64();
+		cnt_start = counter_get();
+
+		k_busy_wait(CALIBRATION_US);
+
+		mtime_end = k_cycle_get_64();
+		cnt_end = counter_get();
+	} while ((mtime_end == mtime_start) || (cnt_end == cnt_start));
+
+	return ((cnt_end - cnt_start) * sys_clock_hw_cycles_per_sec()) /
+	       (mtime_end - mtime_start);
+}
+#endif
+
+/* Split to keep cycles * mul from overflowing */
+static inline uint64_t scale(uint64_t cycles, uint64_t mul, uint64_t div)
+{
+	return (cycles / div) * mul + ((cycles % div) * mul) / div;
+}
+
+/*
+ * Calibrate the counter of the current hart, if not done yet. Called on
+ * every hart before it runs any thread: from arch_timing_init() and at
+ * POST_KERNEL on the boot hart, from z_riscv_secondary_start() on the
+ * others. Interrupts are locked so that both counters are read on the
+ * same hart and the measurement is not preempted.
+ */
+void z_riscv_timing_calibrate(void)
+{
+#if !defined(CONFIG_RISCV_TIMING_MTIME)
+	unsigned int key = arch_irq_lock();
+	int cpu = arch_curr_cpu()->id;
+
+	if (counter_freq[cpu] == 0U) {
+		counter_freq[cpu] = calibrate();
+	}
+	arch_irq_unlock(key);
+#endif
+}
+
+#if !defined(CONFIG_RISCV_TIMING_MTIME)
+static int timing_calibrate_boot_hart(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	z_riscv_timing_calibrate();
+
+	return 0;
+}
+
+SYS_INIT(timing_calibrate_boot_hart, POST_KERNEL,
+	 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif
+
+void arch_timing_init(void)
+{
+	z_riscv_timing_calibrate();
+}
+
+void arch_timing_start(void)
+{
+}
+
+void arch_timing_stop(void)
+{
+}
+
+timing_t arch_timing_counter_get(void)
+{
+#if defined(CONFIG_RISCV_TIMING_MTIME)
+	return (timing_t)counter_get();
+#else
+	unsigned int key = arch_irq_lock();
+	uint64_t cpu = arch_curr_cpu()->id;
+	uint64_t cnt = counter_get();
+
+	arch_irq_unlock(key);
+
+	return (timing_t)((cpu << SAMPLE_CPU_SHIFT) |
+			  (cnt & SAMPLE_COUNT_MASK));
+#endif
+}
+
+uint64_t arch_timing_cycles_get(volatile timing_t *const start,
+				volatile timing_t *const end)
+{
+#if defined(CONFIG_RISCV_TIMING_MTIME)
+	return (*end - *start);
+#else
+	int cpu = *start >> SAMPLE_CPU_SHIFT;
+	uint64_t cycles = (*end - *start) & SAMPLE_COUNT_MASK;
+
+	__ASSERT((*end >> SAMPLE_CPU_SHIFT) == cpu,
+		 "timing samples taken on different harts");
+
+	/* Convert to cycles at the rate of the boot hart */
+	if (counter_freq[cpu] != counter_freq[0]) {
+		cycles = scale(cycles, counter_freq[0], counter_freq[cpu]);
+	}
+
+	return cycles;
+#endif
+}
+
+uint64_t arch_timing_freq_get(void)
+{
+#if defined(CONFIG_RISCV_TIMING_MTIME)
+	return sys_clock_hw_cycles_per_sec();
+#else
+	return counter_freq[0];
+#endif
+}
+
+uint64_t arch_timing_cycles_to_ns(uint64_t cycles)
+{
+	return scale(cycles, NSEC_PER_SEC, arch_timing_freq_get());
+}
+
+uint64_t arch_timing_cycles_to_ns_avg(uint64_t cycles, uint32_t count)
+{
+	return arch_timing_cycles_to_ns(cycles) / count;
+}
+
+uint32_t arch_timing_freq_get_mhz(void)
+{
+	return (uint32_t)(arch_timing_freq_get() / 1000000U);
+}
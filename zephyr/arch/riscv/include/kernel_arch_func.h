@@ -52,6 +52,10 @@ extern FUNC_NORETURN void z_riscv_userspace_enter(k_thread_entry_t user_entry,
 int z_irq_do_offload(void);
 #endif
 
+#ifdef CONFIG_TIMING_FUNCTIONS
+void z_riscv_timing_calibrate(void);
+#endif
+
 #endif /* _ASMLANGUAGE */
 
 #ifdef __cplusplus
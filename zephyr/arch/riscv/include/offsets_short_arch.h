@@ -20,6 +20,14 @@
 #define _thread_offset_to_sp \
 	(___thread_t_callee_saved_OFFSET + ___callee_saved_t_sp_OFFSET)
 
+#define _thread_offset_to_ra \
+	(___thread_t_callee_saved_OFFSET + ___callee_saved_t_ra_OFFSET)
+
+#ifdef CONFIG_THREAD_LOCAL_STORAGE
+#define _thread_offset_to_tp \
+	(___thread_t_callee_saved_OFFSET + ___callee_saved_t_tp_OFFSET)
+#endif
+
 #define _thread_offset_to_s0 \
 	(___thread_t_callee_saved_OFFSET + ___callee_saved_t_s0_OFFSET)
 
@@ -102,6 +110,16 @@
 
 #endif /* defined(CONFIG_FPU) && defined(CONFIG_FPU_SHARING) */
 
+#ifdef CONFIG_RISCV_LAZY_FPU_SHARING
+#define _thread_offset_to_fp_fregs \
+	(___thread_t_arch_OFFSET + ___thread_arch_t_fp_OFFSET + \
+	 __z_riscv_fp_context_t_fregs_OFFSET)
+
+#define _thread_offset_to_fp_fcsr \
+	(___thread_t_arch_OFFSET + ___thread_arch_t_fp_OFFSET + \
+	 __z_riscv_fp_context_t_fcsr_OFFSET)
+#endif /* CONFIG_RISCV_LAZY_FPU_SHARING */
+
 #ifdef CONFIG_USERSPACE
 #define _thread_offset_to_priv_stack_start \
 	(___thread_t_arch_OFFSET + ___thread_arch_t_priv_stack_start_OFFSET)
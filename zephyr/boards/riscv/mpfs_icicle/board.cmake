@@ -1,4 +1,24 @@
 # SPDX-License-Identifier: Apache-2.0
 
-set(EMU_PLATFORM renode)
-set(RENODE_SCRIPT ${CMAKE_CURRENT_LIST_DIR}/support/mpfs250t.resc)
+if(CONFIG_BOARD_MPFS_ICICLE_QEMU)
+  set(EMU_PLATFORM qemu)
+  set(QEMU_binary_suffix riscv64)
+
+  # The machine model requires all five harts, Zephyr runs on hart 1
+  # (the first U54) and is loaded without any firmware.
+  set(QEMU_FLAGS_${ARCH}
+    -nographic
+    -machine microchip-icicle-kit
+    -smp 5
+    -bios none
+    )
+
+  set(QEMU_KERNEL_OPTION
+    "-device;loader,file=\$<TARGET_FILE:\${logical_target_for_zephyr_elf}>,cpu-num=1"
+    )
+
+  board_set_debugger_ifnset(qemu)
+else()
+  set(EMU_PLATFORM renode)
+  set(RENODE_SCRIPT ${CMAKE_CURRENT_LIST_DIR}/support/mpfs250t.resc)
+endif()
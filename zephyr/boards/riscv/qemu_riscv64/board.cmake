@@ -11,4 +11,8 @@ set(QEMU_FLAGS_${ARCH}
   -bios none
   -m 256
   )
+
+if(CONFIG_BOARD_QEMU_RISCV64_SMP)
+  list(APPEND QEMU_FLAGS_${ARCH} -smp ${CONFIG_MP_NUM_CPUS})
+endif()
 board_set_debugger_ifnset(qemu)
@@ -31,6 +31,7 @@
 #include <linker/sections.h>
 #include <sys/atomic.h>
 #include <sys/printk.h>
+#include <sys/ring_buffer.h>
 #ifdef CONFIG_UART_CONSOLE_MCUMGR
 #include "mgmt/mcumgr/serial.h"
 #endif
@@ -61,6 +62,161 @@ void uart_console_out_debug_hook_install(uart_console_out_debug_hook_t *hook)
 #endif /* CONFIG_UART_CONSOLE_DEBUG_SERVER_HOOKS */
 
 
+#ifdef CONFIG_UART_CONSOLE_ASYNC
+
+/*
+ * Console output is queued in a ring buffer and sent with uart_tx(), so
+ * that printk() returns as soon as the characters are queued instead of
+ * after they went out on the line. When the ring buffer is full, just enough
+ * of the oldest queued output is sent synchronously to make room for the new
+ * character, and the caller is back to the speed of the line.
+ */
+static struct k_spinlock console_lock;
+RING_BUF_DECLARE(console_tx_ring, CONFIG_UART_CONSOLE_ASYNC_TX_BUF_SIZE);
+static bool console_async;
+/* Length of the transfer in progress, 0 when idle */
+static uint32_t console_tx_len;
+/* Bytes sent by the last aborted transfer */
+static uint32_t console_tx_aborted;
+/* Completions to ignore, see console_tx_make_room() */
+static uint32_t console_tx_stale;
+
+/* Start sending the queued output, if not already in progress. */
+static void console_tx_start(void)
+{
+	uint8_t *data;
+
+	if (console_tx_len != 0) {
+		return;
+	}
+
+	console_tx_len = ring_buf_get_claim(&console_tx_ring, &data,
+					    ring_buf_capacity_get(&console_tx_ring));
+	if (console_tx_len == 0) {
+		return;
+	}
+
+	if (uart_tx(uart_console_dev, data, console_tx_len,
+		    SYS_FOREVER_US) != 0) {
+		(void)ring_buf_get_finish(&console_tx_ring, 0);
+		console_tx_len = 0;
+	}
+}
+
+/*
+ * Send the oldest queued output synchronously until there is room for
+ * @p needed bytes. Only a character or two are polled out, so the lock
+ * is not held for the time it takes to send the whole ring buffer.
+ */
+static void console_tx_make_room(uint32_t needed)
+{
+	uint32_t len;
+	uint8_t *data;
+
+	if (console_tx_len != 0) {
+		if (uart_tx_abort(uart_console_dev) == 0) {
+			(void)ring_buf_get_finish(&console_tx_ring,
+						  console_tx_aborted);
+		} else {
+			/* The transfer completed and its completion is being
+			 * reported on another CPU, which waits for the lock.
+			 */
+			(void)ring_buf_get_finish(&console_tx_ring,
+						  console_tx_len);
+			console_tx_stale++;
+		}
+		console_tx_len = 0;
+	}
+
+	while (ring_buf_space_get(&console_tx_ring) < needed) {
+		len = ring_buf_get_claim(&console_tx_ring, &data,
+					 needed - ring_buf_space_get(&console_tx_ring));
+		for (uint32_t i = 0; i < len; i++) {
+			uart_poll_out(uart_console_dev, data[i]);
+		}
+		(void)ring_buf_get_finish(&console_tx_ring, len);
+	}
+}
+
+static void console_async_cb(const struct device *dev,
+			     struct uart_event *evt, void *user_data)
+{
+	k_spinlock_key_t key;
+
+	ARG_UNUSED(dev);
+	ARG_UNUSED(user_data);
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+		key = k_spin_lock(&console_lock);
+		if (console_tx_stale > 0) {
+			console_tx_stale--;
+		} else {
+			(void)ring_buf_get_finish(&console_tx_ring,
+						  console_tx_len);
+			console_tx_len = 0;
+			console_tx_start();
+		}
+		k_spin_unlock(&console_lock, key);
+		break;
+	case UART_TX_ABORTED:
+		/* Only aborted by console_tx_make_room(), with the lock held */
+		console_tx_aborted = evt->data.tx.len;
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * @brief Queue one character for asynchronous output
+ *
+ * @param c Character to output
+ *
+ * @return true if the character was handled, false to output it by polling.
+ */
+static bool console_async_out(int c)
+{
+	uint8_t out[2] = { '\r', (uint8_t)c };
+	uint32_t len = ('\n' == c) ? 2 : 1;
+	k_spinlock_key_t key;
+
+	/* Before the kernel runs nothing would drain the ring buffer */
+	if (!console_async || k_is_pre_kernel()) {
+		return false;
+	}
+
+	key = k_spin_lock(&console_lock);
+
+	/* In ISRs and with interrupts locked, as when an assertion fails or
+	 * a fatal error is handled, the system may halt before the queued
+	 * output is sent: send it and the character synchronously.
+	 */
+	if (k_is_in_isr() || !arch_irq_unlocked(key.key)) {
+		console_tx_make_room(ring_buf_capacity_get(&console_tx_ring));
+		for (uint32_t i = 2 - len; i < 2; i++) {
+			uart_poll_out(uart_console_dev, out[i]);
+		}
+		k_spin_unlock(&console_lock, key);
+
+		return true;
+	}
+
+	if (ring_buf_space_get(&console_tx_ring) < len) {
+		console_tx_make_room(len);
+	}
+
+	(void)ring_buf_put(&console_tx_ring, &out[2 - len], len);
+
+	console_tx_start();
+
+	k_spin_unlock(&console_lock, key);
+
+	return true;
+}
+
+#endif /* CONFIG_UART_CONSOLE_ASYNC */
+
 #if defined(CONFIG_PRINTK) || defined(CONFIG_STDOUT_CONSOLE)
 /**
  *
@@ -85,6 +241,12 @@ static int console_out(int c)
 
 #endif  /* CONFIG_UART_CONSOLE_DEBUG_SERVER_HOOKS */
 
+#ifdef CONFIG_UART_CONSOLE_ASYNC
+	if (console_async_out(c)) {
+		return c;
+	}
+#endif
+
 	if ('\n' == c) {
 		uart_poll_out(uart_console_dev, '\r');
 	}
@@ -599,6 +761,11 @@ static int uart_console_init(const struct device *arg)
 		return -ENODEV;
 	}
 
+#ifdef CONFIG_UART_CONSOLE_ASYNC
+	console_async = (uart_callback_set(uart_console_dev, console_async_cb,
+					   NULL) == 0);
+#endif
+
 	uart_console_hook_install();
 
 	return 0;
@@ -5,8 +5,9 @@
  * SPDX-License-Identifier: Apache-2.0
  *
  * Known current limitations / TODOs:
- * - Only supports 32-bit addresses in buffer descriptors, therefore
- *   the ZynqMP APU (Cortex-A53 cores) may not be fully supported.
+ * - 64-bit addresses in buffer descriptors require the controller to be
+ *   configured for 64-bit addressing, which isn't supported by the GEM
+ *   of the Zynq-7000, see CONFIG_ETH_XLNX_GEM_64BIT_DMA.
  * - Hardware timestamps not considered.
  * - VLAN tags not considered.
  * - Wake-on-LAN interrupt not supported.
@@ -17,6 +18,11 @@
  *   is not an issue as long as the controller is used in conjunction
  *   with the Cortex-R5 QEMU target or an actual R5 running without the
  *   MPU enabled.
+ * - No cache maintenance is performed on the BDs and buffers, the DMA
+ *   accesses of the controller are expected to be coherent with the
+ *   CPUs' data caches. This also applies to the packet buffers which
+ *   are handed to / taken from the controller in zero-copy mode, see
+ *   CONFIG_ETH_XLNX_GEM_ZERO_COPY.
  * - No detailed error handling when evaluating the Interrupt Status,
  *   RX Status and TX Status registers.
  */
@@ -57,11 +63,21 @@ static void eth_xlnx_gem_set_mac_address(const struct device *dev);
 static void eth_xlnx_gem_set_initial_dmacr(const struct device *dev);
 static void eth_xlnx_gem_init_phy(const struct device *dev);
 static void eth_xlnx_gem_poll_phy(struct k_work *item);
-static void eth_xlnx_gem_configure_buffers(const struct device *dev);
+static int  eth_xlnx_gem_configure_buffers(const struct device *dev);
 static void eth_xlnx_gem_rx_pending_work(struct k_work *item);
 static void eth_xlnx_gem_handle_rx_pending(const struct device *dev);
 static void eth_xlnx_gem_tx_done_work(struct k_work *item);
 static void eth_xlnx_gem_handle_tx_done(const struct device *dev);
+#ifdef CONFIG_ETH_XLNX_GEM_ZERO_COPY
+static struct net_buf *eth_xlnx_gem_rx_buf_alloc(const struct device *dev);
+static struct net_pkt *eth_xlnx_gem_rx_frame(const struct device *dev,
+					     uint8_t first_bd_idx,
+					     uint8_t last_bd_idx,
+					     uint32_t rx_data_length);
+static uint16_t eth_xlnx_gem_tx_frag_count(struct net_pkt *pkt);
+static struct net_pkt *eth_xlnx_gem_tx_linearize(const struct device *dev,
+						 struct net_pkt *pkt);
+#endif
 
 static const struct ethernet_api eth_xlnx_gem_apis = {
 	.iface_api.init   = eth_xlnx_gem_iface_init,
@@ -80,12 +96,57 @@ static const struct ethernet_api eth_xlnx_gem_apis = {
  */
 DT_INST_FOREACH_STATUS_OKAY(ETH_XLNX_GEM_INITIALIZE)
 
+/**
+ * @brief GEM BD address word write function
+ * Writes the buffer address of a BD. The flags provided by the caller
+ * are OR'ed into the address word: the 'used' and 'wrap' bits of RX BDs
+ * are located in its bits [1..0], as RX buffers are word-aligned. TX
+ * buffers may start at any address, no flags are passed for TX BDs.
+ * If 64-bit DMA addressing is enabled, the upper half of the address
+ * is written first, so that a BD released to the controller by the
+ * write to its address word never contains a stale upper half.
+ *
+ * @param bd    Pointer to the BD to be updated
+ * @param addr  Buffer address
+ * @param flags Flags to be OR'ed into the address word
+ */
+static inline void eth_xlnx_gem_bd_set_addr(struct eth_xlnx_gem_bd *bd,
+					    uintptr_t addr, uint32_t flags)
+{
+#ifdef CONFIG_ETH_XLNX_GEM_64BIT_DMA
+	sys_write32((uint32_t)((uint64_t)addr >> 32), (mem_addr_t)&bd->addr_hi);
+	ETH_XLNX_GEM_DMA_WMB();
+#endif
+	sys_write32((uint32_t)addr | flags, (mem_addr_t)&bd->addr);
+}
+
+/**
+ * @brief GEM BD address word read function
+ * Reads the buffer address of a BD, including its upper half if 64-bit
+ * DMA addressing is enabled. The flag bits [1..0] of the address word
+ * are masked out.
+ *
+ * @param bd Pointer to the BD to be read
+ * @return Buffer address
+ */
+static inline uintptr_t eth_xlnx_gem_bd_get_addr(struct eth_xlnx_gem_bd *bd)
+{
+	uint64_t addr = sys_read32((mem_addr_t)&bd->addr) &
+			ETH_XLNX_GEM_RXBD_BUFFER_ADDR_MASK;
+
+#ifdef CONFIG_ETH_XLNX_GEM_64BIT_DMA
+	addr |= (uint64_t)sys_read32((mem_addr_t)&bd->addr_hi) << 32;
+#endif
+	return (uintptr_t)addr;
+}
+
 /**
  * @brief GEM device initialization function
  * Initializes the GEM itself, the DMA memory area used by the GEM and,
  * if enabled, an associated PHY attached to the GEM's MDIO interface.
  *
  * @param dev Pointer to the device data
+ * @retval -ENOMEM if the RX buffers could not be allocated in zero-copy mode
  * @retval 0 if the device initialization completed successfully
  */
 static int eth_xlnx_gem_dev_init(const struct device *dev)
@@ -115,10 +176,10 @@ static int eth_xlnx_gem_dev_init(const struct device *dev)
 		 dev->name, (uint32_t)dev_conf->max_link_speed);
 
 	/* MDC clock divider validity check */
-	__ASSERT(dev_conf->mdc_divider <= MDC_DIVIDER_48,
+	__ASSERT(dev_conf->mdc_divider <= MDC_DIVIDER_224,
 		 "%s invalid MDC clock divider value %u, must be in "
 		 "range 0 to %u", dev->name, dev_conf->mdc_divider,
-		 (uint32_t)MDC_DIVIDER_48);
+		 (uint32_t)MDC_DIVIDER_224);
 
 	/* AMBA AHB configuration options */
 	__ASSERT((dev_conf->amba_dbus_width == AMBA_AHB_DBUS_WIDTH_32BIT ||
@@ -185,6 +246,24 @@ static int eth_xlnx_gem_dev_init(const struct device *dev)
 	eth_xlnx_gem_set_mac_address(dev);	/* Chapter 16.3.2 */
 	eth_xlnx_gem_set_initial_dmacr(dev);	/* Chapter 16.3.2 */
 
+	/*
+	 * Interrupt moderation: delay the frame received / TX complete
+	 * interrupts so that a single interrupt covers multiple frames.
+	 * The register isn't present in the Zynq-7000's GEM, only write
+	 * it if moderation is enabled for the current device.
+	 */
+	if (dev_conf->rx_intr_moderation != 0 ||
+	    dev_conf->tx_intr_moderation != 0) {
+		reg_val = (((uint32_t)dev_conf->tx_intr_moderation &
+			  ETH_XLNX_GEM_INTMOD_MASK) <<
+			  ETH_XLNX_GEM_INTMOD_TX_SHIFT) |
+			  (((uint32_t)dev_conf->rx_intr_moderation &
+			  ETH_XLNX_GEM_INTMOD_MASK) <<
+			  ETH_XLNX_GEM_INTMOD_RX_SHIFT);
+		sys_write32(reg_val, dev_conf->base_addr +
+			    ETH_XLNX_GEM_INTMOD_OFFSET);
+	}
+
 	/* Enable MDIO -> set gem.net_ctrl[mgmt_port_en] */
 	if (dev_conf->init_phy) {
 		reg_val  = sys_read32(dev_conf->base_addr +
@@ -198,9 +277,8 @@ static int eth_xlnx_gem_dev_init(const struct device *dev)
 	if (dev_conf->init_phy) {
 		eth_xlnx_gem_init_phy(dev);	/* Chapter 16.3.4 */
 	}
-	eth_xlnx_gem_configure_buffers(dev);	/* Chapter 16.3.5 */
 
-	return 0;
+	return eth_xlnx_gem_configure_buffers(dev); /* Chapter 16.3.5 */
 }
 
 /**
@@ -321,8 +399,14 @@ static void eth_xlnx_gem_isr(const struct device *dev)
 
 /**
  * @brief GEM data send function
- * GEM data send function. Blocks until a TX complete notification has been
- * received & processed.
+ * GEM data send function. Unless zero-copy mode is enabled, the packet
+ * data is copied to the DMA memory area and the function blocks until
+ * a TX complete notification has been received & processed. In zero-
+ * copy mode, the TX BDs point straight to the packet's fragments, the
+ * packet is referenced until the TX done handler has released its BDs
+ * and the function returns once the transmission has been started. A
+ * packet with more fragments than there are TX BDs is copied to fewer,
+ * larger buffers first.
  *
  * @param dev Pointer to the device data
  * @param pkt Pointer to the data packet to be sent
@@ -333,6 +417,8 @@ static void eth_xlnx_gem_isr(const struct device *dev)
  *         (2) the attempt to TX data while no free buffers are available
  *             in the DMA memory area,
  *         (3) the transmission completion notification timing out
+ * @retval -ENOMEM in zero-copy mode, if a packet with more fragments
+ *         than there are TX BDs cannot be copied
  * @retval 0 if the packet was transmitted successfully
  */
 static int eth_xlnx_gem_send(const struct device *dev, struct net_pkt *pkt)
@@ -341,14 +427,20 @@ static int eth_xlnx_gem_send(const struct device *dev, struct net_pkt *pkt)
 	struct eth_xlnx_gem_dev_data *dev_data = DEV_DATA(dev);
 
 	uint16_t tx_data_length;
+#ifdef CONFIG_ETH_XLNX_GEM_ZERO_COPY
+	struct net_pkt *tx_pkt;
+	struct net_buf *frag;
+	uint16_t bds_filled;
+#else
 	uint16_t tx_data_remaining;
 	void *tx_buffer_offs;
+#endif
 
-	uint8_t bds_reqd;
+	uint16_t bds_reqd;
 	uint8_t curr_bd_idx;
 	uint8_t first_bd_idx;
 
-	uint32_t reg_ctrl;
+	mem_addr_t reg_ctrl;
 	uint32_t reg_val;
 	int sem_status;
 
@@ -360,7 +452,7 @@ static int eth_xlnx_gem_send(const struct device *dev, struct net_pkt *pkt)
 		return -EIO;
 	}
 
-	tx_data_length = tx_data_remaining = net_pkt_get_len(pkt);
+	tx_data_length = net_pkt_get_len(pkt);
 	if (tx_data_length == 0) {
 		LOG_ERR("%s cannot TX, zero packet length", dev->name);
 #ifdef CONFIG_NET_STATISTICS_ETHERNET
@@ -378,10 +470,37 @@ static int eth_xlnx_gem_send(const struct device *dev, struct net_pkt *pkt)
 	 * queue, protect against interruptions during the update of the BD
 	 * ring's data by taking the ring's semaphore. If TX done handling
 	 * is performed within the ISR, protect against interruptions by
-	 * disabling the TX done interrupt source.
+	 * disabling the TX done interrupt source. The protection is held
+	 * until the BDs have been released to the controller: BDs which
+	 * have been reserved, but which are still marked as 'used', must
+	 * not be mistaken for the BDs of a completed frame.
 	 */
-	bds_reqd = (uint8_t)((tx_data_length + (dev_conf->tx_buffer_size - 1)) /
-		   dev_conf->tx_buffer_size);
+#ifdef CONFIG_ETH_XLNX_GEM_ZERO_COPY
+	/*
+	 * One BD per non-empty fragment of the packet. A packet which
+	 * could never fit into the ring is linearized, the copy is then
+	 * what the BDs point to and what the TX done handler releases.
+	 */
+	bds_reqd = eth_xlnx_gem_tx_frag_count(pkt);
+	if (bds_reqd > dev_conf->txbd_count) {
+		tx_pkt = eth_xlnx_gem_tx_linearize(dev, pkt);
+		if (tx_pkt == NULL) {
+			LOG_ERR("%s cannot TX, packet with %hu fragments "
+				"cannot be linearized", dev->name, bds_reqd);
+#ifdef CONFIG_NET_STATISTICS_ETHERNET
+			dev_data->stats.tx_dropped++;
+#endif
+			return -ENOMEM;
+		}
+		bds_reqd = eth_xlnx_gem_tx_frag_count(tx_pkt);
+	} else {
+		tx_pkt = net_pkt_ref(pkt);
+	}
+#else
+	tx_data_remaining = tx_data_length;
+	bds_reqd = (tx_data_length + (dev_conf->tx_buffer_size - 1)) /
+		   dev_conf->tx_buffer_size;
+#endif
 
 	if (dev_conf->defer_txd_to_queue) {
 		k_sem_take(&(dev_data->txbd_ring.ring_sem), K_FOREVER);
@@ -390,9 +509,39 @@ static int eth_xlnx_gem_send(const struct device *dev, struct net_pkt *pkt)
 			    dev_conf->base_addr + ETH_XLNX_GEM_IDR_OFFSET);
 	}
 
+#ifdef CONFIG_ETH_XLNX_GEM_ZERO_COPY
+	/*
+	 * Zero-copy TX doesn't wait for the completion of each frame, so
+	 * the ring may still be occupied by frames in flight -> wait for
+	 * the TX done handler to release their BDs.
+	 */
+	while (bds_reqd > dev_data->txbd_ring.free_bds &&
+	       bds_reqd <= dev_conf->txbd_count) {
+		if (dev_conf->defer_txd_to_queue) {
+			k_sem_give(&(dev_data->txbd_ring.ring_sem));
+		} else {
+			sys_write32(ETH_XLNX_GEM_IXR_TX_COMPLETE_BIT,
+				    dev_conf->base_addr + ETH_XLNX_GEM_IER_OFFSET);
+		}
+
+		sem_status = k_sem_take(&dev_data->tx_done_sem, K_MSEC(100));
+
+		if (dev_conf->defer_txd_to_queue) {
+			k_sem_take(&(dev_data->txbd_ring.ring_sem), K_FOREVER);
+		} else {
+			sys_write32(ETH_XLNX_GEM_IXR_TX_COMPLETE_BIT,
+				    dev_conf->base_addr + ETH_XLNX_GEM_IDR_OFFSET);
+		}
+
+		if (sem_status < 0) {
+			break;
+		}
+	}
+#endif
+
 	if (bds_reqd > dev_data->txbd_ring.free_bds) {
 		LOG_ERR("%s cannot TX, packet length %hu requires "
-			"%hhu BDs, current free count = %hhu",
+			"%hu BDs, current free count = %hhu",
 			dev->name, tx_data_length, bds_reqd,
 			dev_data->txbd_ring.free_bds);
 
@@ -402,6 +551,9 @@ static int eth_xlnx_gem_send(const struct device *dev, struct net_pkt *pkt)
 			sys_write32(ETH_XLNX_GEM_IXR_TX_COMPLETE_BIT,
 				    dev_conf->base_addr + ETH_XLNX_GEM_IER_OFFSET);
 		}
+#ifdef CONFIG_ETH_XLNX_GEM_ZERO_COPY
+		net_pkt_unref(tx_pkt);
+#endif
 #ifdef CONFIG_NET_STATISTICS_ETHERNET
 		dev_data->stats.tx_dropped++;
 #endif
@@ -409,19 +561,49 @@ static int eth_xlnx_gem_send(const struct device *dev, struct net_pkt *pkt)
 	}
 
 	curr_bd_idx = first_bd_idx = dev_data->txbd_ring.next_to_use;
-	reg_ctrl = (uint32_t)(&dev_data->txbd_ring.first_bd[curr_bd_idx].ctrl);
+	reg_ctrl = (mem_addr_t)(&dev_data->txbd_ring.first_bd[curr_bd_idx].ctrl);
 
 	dev_data->txbd_ring.next_to_use = (first_bd_idx + bds_reqd) %
 					  dev_conf->txbd_count;
 	dev_data->txbd_ring.free_bds -= bds_reqd;
 
-	if (dev_conf->defer_txd_to_queue) {
-		k_sem_give(&(dev_data->txbd_ring.ring_sem));
-	} else {
-		sys_write32(ETH_XLNX_GEM_IXR_TX_COMPLETE_BIT,
-			    dev_conf->base_addr + ETH_XLNX_GEM_IER_OFFSET);
+#ifdef CONFIG_ETH_XLNX_GEM_ZERO_COPY
+	/*
+	 * Point one BD to each of the non-empty fragments of the
+	 * network packet.
+	 */
+	frag = tx_pkt->buffer;
+	bds_filled = 0;
+	while (1) {
+		while (frag->len == 0) {
+			frag = frag->frags;
+		}
+
+		eth_xlnx_gem_bd_set_addr(&dev_data->txbd_ring.first_bd[curr_bd_idx],
+					 (uintptr_t)frag->data, 0);
+
+		/* Update current BD's control word */
+		reg_val = sys_read32(reg_ctrl) & (ETH_XLNX_GEM_TXBD_WRAP_BIT |
+			  ETH_XLNX_GEM_TXBD_USED_BIT);
+		reg_val |= frag->len & ETH_XLNX_GEM_TXBD_LEN_MASK;
+		sys_write32(reg_val, reg_ctrl);
+
+		frag = frag->frags;
+		if (++bds_filled == bds_reqd) {
+			break;
+		}
+
+		/* Switch to next BD */
+		curr_bd_idx = (curr_bd_idx + 1) % dev_conf->txbd_count;
+		reg_ctrl = (mem_addr_t)(&dev_data->txbd_ring.first_bd[curr_bd_idx].ctrl);
 	}
 
+	/*
+	 * Keep the packet, whose fragments are now referenced by the BDs,
+	 * until the TX done handler has processed its last BD.
+	 */
+	dev_data->tx_pkts[curr_bd_idx] = tx_pkt;
+#else
 	/*
 	 * Scatter the contents of the network packet's buffer to
 	 * one or more DMA buffers.
@@ -447,12 +629,13 @@ static int eth_xlnx_gem_send(const struct device *dev, struct net_pkt *pkt)
 		if (tx_data_remaining > dev_conf->tx_buffer_size) {
 			/* Switch to next BD */
 			curr_bd_idx = (curr_bd_idx + 1) % dev_conf->txbd_count;
-			reg_ctrl = (uint32_t)(&dev_data->txbd_ring.first_bd[curr_bd_idx].ctrl);
+			reg_ctrl = (mem_addr_t)(&dev_data->txbd_ring.first_bd[curr_bd_idx].ctrl);
 		}
 
 		tx_data_remaining -= (tx_data_remaining < dev_conf->tx_buffer_size) ?
 				     tx_data_remaining : dev_conf->tx_buffer_size;
 	} while (tx_data_remaining > 0);
+#endif
 
 	/* Set the 'last' bit in the current BD's control word */
 	reg_val |= ETH_XLNX_GEM_TXBD_LAST_BIT;
@@ -464,28 +647,39 @@ static int eth_xlnx_gem_send(const struct device *dev, struct net_pkt *pkt)
 	 * order, so that the 'used' bit of the first BD is cleared
 	 * last just before the transmission is started.
 	 */
+	ETH_XLNX_GEM_DMA_WMB();
 	reg_val &= ~ETH_XLNX_GEM_TXBD_USED_BIT;
 	sys_write32(reg_val, reg_ctrl);
 
 	while (curr_bd_idx != first_bd_idx) {
 		curr_bd_idx = (curr_bd_idx != 0) ? (curr_bd_idx - 1) :
 			      (dev_conf->txbd_count - 1);
-		reg_ctrl = (uint32_t)(&dev_data->txbd_ring.first_bd[curr_bd_idx].ctrl);
+		reg_ctrl = (mem_addr_t)(&dev_data->txbd_ring.first_bd[curr_bd_idx].ctrl);
 		reg_val = sys_read32(reg_ctrl);
 		reg_val &= ~ETH_XLNX_GEM_TXBD_USED_BIT;
+		ETH_XLNX_GEM_DMA_WMB();
 		sys_write32(reg_val, reg_ctrl);
 	}
 
 	/* Set the start TX bit in the gem.net_ctrl register */
+	ETH_XLNX_GEM_DMA_WMB();
 	reg_val  = sys_read32(dev_conf->base_addr + ETH_XLNX_GEM_NWCTRL_OFFSET);
 	reg_val |= ETH_XLNX_GEM_NWCTRL_STARTTX_BIT;
 	sys_write32(reg_val, dev_conf->base_addr + ETH_XLNX_GEM_NWCTRL_OFFSET);
 
+	if (dev_conf->defer_txd_to_queue) {
+		k_sem_give(&(dev_data->txbd_ring.ring_sem));
+	} else {
+		sys_write32(ETH_XLNX_GEM_IXR_TX_COMPLETE_BIT,
+			    dev_conf->base_addr + ETH_XLNX_GEM_IER_OFFSET);
+	}
+
 #ifdef CONFIG_NET_STATISTICS_ETHERNET
 	dev_data->stats.bytes.sent += tx_data_length;
 	dev_data->stats.pkts.tx++;
 #endif
 
+#ifndef CONFIG_ETH_XLNX_GEM_ZERO_COPY
 	/* Block until TX has completed */
 	sem_status = k_sem_take(&dev_data->tx_done_sem, K_MSEC(100));
 	if (sem_status < 0) {
@@ -495,6 +689,7 @@ static int eth_xlnx_gem_send(const struct device *dev, struct net_pkt *pkt)
 #endif
 		return -EIO;
 	}
+#endif
 
 	return 0;
 }
@@ -502,12 +697,14 @@ static int eth_xlnx_gem_send(const struct device *dev, struct net_pkt *pkt)
 /**
  * @brief GEM device start function
  * GEM device start function. Clears all status registers and any
- * pending interrupts, enables RX and TX, enables interrupts. If
- * no PHY is managed by the current driver instance, this function
- * also declares the physical link up at the configured nominal
- * link speed.
+ * pending interrupts, re-initializes the RX/TX BD rings, enables
+ * RX and TX, enables interrupts. If no PHY is managed by the current
+ * driver instance, this function also declares the physical link up
+ * at the configured nominal link speed.
  *
  * @param dev Pointer to the device data
+ * @retval    -ENOMEM if the RX buffers could not be allocated in
+ *            zero-copy mode
  * @retval    0 upon successful completion
  */
 static int eth_xlnx_gem_start_device(const struct device *dev)
@@ -515,11 +712,11 @@ static int eth_xlnx_gem_start_device(const struct device *dev)
 	const struct eth_xlnx_gem_dev_cfg *dev_conf = DEV_CFG(dev);
 	struct eth_xlnx_gem_dev_data *dev_data = DEV_DATA(dev);
 	uint32_t reg_val;
+	int rc;
 
 	if (dev_data->started) {
 		return 0;
 	}
-	dev_data->started = true;
 
 	/* Disable & clear all the MAC interrupts */
 	sys_write32(ETH_XLNX_GEM_IXR_ALL_MASK,
@@ -531,6 +728,25 @@ static int eth_xlnx_gem_start_device(const struct device *dev)
 	sys_write32(0xFFFFFFFF, dev_conf->base_addr + ETH_XLNX_GEM_TXSR_OFFSET);
 	sys_write32(0xFFFFFFFF, dev_conf->base_addr + ETH_XLNX_GEM_RXSR_OFFSET);
 
+	/*
+	 * Re-initialize the RX/TX BD rings: the controller's TX queue
+	 * pointer is reset to the start of the ring while TX is disabled,
+	 * so the driver's ring indices must be reset accordingly. BDs still
+	 * pending from before the device was stopped are discarded, the
+	 * queue base addresses are re-written for both rings.
+	 */
+	if (dev_conf->defer_txd_to_queue) {
+		k_sem_take(&(dev_data->txbd_ring.ring_sem), K_FOREVER);
+	}
+	rc = eth_xlnx_gem_configure_buffers(dev);
+	if (dev_conf->defer_txd_to_queue) {
+		k_sem_give(&(dev_data->txbd_ring.ring_sem));
+	}
+	if (rc < 0) {
+		return rc;
+	}
+	dev_data->started = true;
+
 	/* RX and TX enable */
 	reg_val  = sys_read32(dev_conf->base_addr + ETH_XLNX_GEM_NWCTRL_OFFSET);
 	reg_val |= (ETH_XLNX_GEM_NWCTRL_RXEN_BIT | ETH_XLNX_GEM_NWCTRL_TXEN_BIT);
@@ -628,9 +844,12 @@ static enum ethernet_hw_caps eth_xlnx_gem_get_capabilities(
 		caps |= ETHERNET_LINK_10BASE_T;
 	}
 
-	if (dev_conf->enable_rx_chksum_offload) {
-		caps |= ETHERNET_HW_RX_CHKSUM_OFFLOAD;
-	}
+	/*
+	 * RX checksum offloading is not reported as a capability: the
+	 * controller only verifies the checksums of unfragmented IPv4/
+	 * IPv6 TCP and UDP packets, therefore the packets it has verified
+	 * are flagged individually in eth_xlnx_gem_handle_rx_pending.
+	 */
 
 	if (dev_conf->enable_tx_chksum_offload) {
 		caps |= ETHERNET_HW_TX_CHKSUM_OFFLOAD;
@@ -728,6 +947,15 @@ static void eth_xlnx_gem_configure_clocks(const struct device *dev)
 	uint32_t tmp;
 	uint32_t clk_ctrl_reg;
 
+	if (dev_conf->clk_ctrl_reg_address == 0) {
+		/*
+		 * No clock control register is specified for the current
+		 * GEM -> its TX clock is provided by the platform, e.g. as
+		 * configured by the PolarFire SoC's MSS configuration.
+		 */
+		return;
+	}
+
 	if ((!dev_conf->init_phy) || dev_data->eff_link_speed == LINK_DOWN) {
 		/*
 		 * Run-time data indicates 'link down' or PHY management
@@ -1022,6 +1250,10 @@ static void eth_xlnx_gem_set_initial_dmacr(const struct device *dev)
 	 * comp. Zynq-7000 TRM, p. 1278 ff.
 	 */
 
+#ifdef CONFIG_ETH_XLNX_GEM_64BIT_DMA
+	/* [30] 64-bit addressing, 64-bit BD layout */
+	reg_val |= ETH_XLNX_GEM_DMACR_ADDR_64BIT_BIT;
+#endif
 	if (dev_conf->disc_rx_ahb_unavail) {
 		/* [24] Discard RX packet when AHB unavailable */
 		reg_val |= ETH_XLNX_GEM_DMACR_DISCNOAHB_BIT;
@@ -1221,16 +1453,21 @@ static void eth_xlnx_gem_poll_phy(struct k_work *work)
 /**
  * @brief GEM DMA memory area setup function
  * Sets up the DMA memory area to be used by the current GEM device.
- * Called from within the device initialization function or from within
- * the context of the PHY status polling delayed work handler.
+ * Called from within the device initialization function and from
+ * within the device start function. In zero-copy mode, RX BDs which
+ * don't have a buffer from the RX buffer pool posted to them yet are
+ * provided with one, packets still referenced by TX BDs are released.
  *
  * @param dev Pointer to the device data
+ * @retval -ENOMEM if the RX buffers could not be allocated in zero-copy mode
+ * @retval 0 upon successful completion
  */
-static void eth_xlnx_gem_configure_buffers(const struct device *dev)
+static int eth_xlnx_gem_configure_buffers(const struct device *dev)
 {
 	const struct eth_xlnx_gem_dev_cfg *dev_conf = DEV_CFG(dev);
 	struct eth_xlnx_gem_dev_data *dev_data = DEV_DATA(dev);
 	struct eth_xlnx_gem_bd *bdptr;
+	uintptr_t buf_addr;
 	uint32_t buf_iter;
 
 	/* Initial configuration of the RX/TX BD rings */
@@ -1244,27 +1481,38 @@ static void eth_xlnx_gem_configure_buffers(const struct device *dev)
 	 */
 	bdptr = dev_data->rxbd_ring.first_bd;
 
-	for (buf_iter = 0; buf_iter < (dev_conf->rxbd_count - 1); buf_iter++) {
-		/* Clear 'used' bit -> BD is owned by the controller */
+	for (buf_iter = 0; buf_iter < dev_conf->rxbd_count; buf_iter++) {
+#ifdef CONFIG_ETH_XLNX_GEM_ZERO_COPY
+		if (dev_data->rx_bufs[buf_iter] == NULL) {
+			dev_data->rx_bufs[buf_iter] = eth_xlnx_gem_rx_buf_alloc(dev);
+			if (dev_data->rx_bufs[buf_iter] == NULL) {
+				LOG_ERR("%s cannot allocate buffer for RX BD [%u]",
+					dev->name, buf_iter);
+				return -ENOMEM;
+			}
+		}
+		buf_addr = (uintptr_t)dev_data->rx_bufs[buf_iter]->data;
+#else
+		buf_addr = (uintptr_t)dev_data->first_rx_buffer +
+			   (buf_iter * (uintptr_t)dev_conf->rx_buffer_size);
+#endif
+
+		/*
+		 * Clear 'used' bit -> BD is owned by the controller. For
+		 * the last BD, bit [1] must be OR'ed in the buffer memory
+		 * address -> this is the 'wrap' bit indicating that this is
+		 * the last BD in the ring. This location is used as bits
+		 * [1..0] can't be part of the buffer address due to alignment
+		 * requirements anyways. Watch out: TX BDs handle this diffe-
+		 * rently, their wrap bit is located in the BD's control word!
+		 */
 		bdptr->ctrl = 0;
-		bdptr->addr = (uint32_t)dev_data->first_rx_buffer +
-			      (buf_iter * (uint32_t)dev_conf->rx_buffer_size);
+		eth_xlnx_gem_bd_set_addr(bdptr, buf_addr,
+					 (buf_iter == (dev_conf->rxbd_count - 1)) ?
+					 ETH_XLNX_GEM_RXBD_WRAP_BIT : 0);
 		++bdptr;
 	}
 
-	/*
-	 * For the last BD, bit [1] must be OR'ed in the buffer memory
-	 * address -> this is the 'wrap' bit indicating that this is the
-	 * last BD in the ring. This location is used as bits [1..0] can't
-	 * be part of the buffer address due to alignment requirements
-	 * anyways. Watch out: TX BDs handle this differently, their wrap
-	 * bit is located in the BD's control word!
-	 */
-	bdptr->ctrl = 0; /* BD is owned by the controller */
-	bdptr->addr = ((uint32_t)dev_data->first_rx_buffer +
-		      (buf_iter * (uint32_t)dev_conf->rx_buffer_size)) |
-		      ETH_XLNX_GEM_RXBD_WRAP_BIT;
-
 	/*
 	 * Set initial TX BD data -> comp. Zynq-7000 TRM, Chapter 16.3.5,
 	 * "Transmit Buffer Descriptor List". TX BD ring data has already
@@ -1272,24 +1520,32 @@ static void eth_xlnx_gem_configure_buffers(const struct device *dev)
 	 */
 	bdptr = dev_data->txbd_ring.first_bd;
 
-	for (buf_iter = 0; buf_iter < (dev_conf->txbd_count - 1); buf_iter++) {
-		/* Set up the control word -> 'used' flag must be set. */
+	for (buf_iter = 0; buf_iter < dev_conf->txbd_count; buf_iter++) {
+#ifdef CONFIG_ETH_XLNX_GEM_ZERO_COPY
+		/* The buffer address is set per fragment at TX time */
+		if (dev_data->tx_pkts[buf_iter] != NULL) {
+			net_pkt_unref(dev_data->tx_pkts[buf_iter]);
+			dev_data->tx_pkts[buf_iter] = NULL;
+		}
+		buf_addr = 0;
+#else
+		buf_addr = (uintptr_t)dev_data->first_tx_buffer +
+			   (buf_iter * (uintptr_t)dev_conf->tx_buffer_size);
+#endif
+
+		/*
+		 * Set up the control word -> 'used' flag must be set. For
+		 * the last BD, set the 'wrap' bit indicating to the controller
+		 * that this BD is the last one in the ring.
+		 */
 		bdptr->ctrl = ETH_XLNX_GEM_TXBD_USED_BIT;
-		bdptr->addr = (uint32_t)dev_data->first_tx_buffer +
-			      (buf_iter * (uint32_t)dev_conf->tx_buffer_size);
+		if (buf_iter == (dev_conf->txbd_count - 1)) {
+			bdptr->ctrl |= ETH_XLNX_GEM_TXBD_WRAP_BIT;
+		}
+		eth_xlnx_gem_bd_set_addr(bdptr, buf_addr, 0);
 		++bdptr;
 	}
 
-	/*
-	 * For the last BD, set the 'wrap' bit indicating to the controller
-	 * that this BD is the last one in the ring. -> For TX BDs, the 'wrap'
-	 * bit isn't located in the address word, but in the control word
-	 * instead
-	 */
-	bdptr->ctrl = (ETH_XLNX_GEM_TXBD_WRAP_BIT | ETH_XLNX_GEM_TXBD_USED_BIT);
-	bdptr->addr = (uint32_t)dev_data->first_tx_buffer +
-		      (buf_iter * (uint32_t)dev_conf->tx_buffer_size);
-
 	/* Set free count/current index in the RX/TX BD ring data */
 	dev_data->rxbd_ring.next_to_process = 0;
 	dev_data->rxbd_ring.next_to_use     = 0;
@@ -1299,10 +1555,19 @@ static void eth_xlnx_gem_configure_buffers(const struct device *dev)
 	dev_data->txbd_ring.free_bds        = dev_conf->txbd_count;
 
 	/* Write pointers to the first RX/TX BD to the controller */
-	sys_write32((uint32_t)dev_data->rxbd_ring.first_bd,
+	ETH_XLNX_GEM_DMA_WMB();
+#ifdef CONFIG_ETH_XLNX_GEM_64BIT_DMA
+	sys_write32((uint32_t)((uint64_t)(uintptr_t)dev_data->rxbd_ring.first_bd >> 32),
+		    dev_conf->base_addr + ETH_XLNX_GEM_RXQBASEH_OFFSET);
+	sys_write32((uint32_t)((uint64_t)(uintptr_t)dev_data->txbd_ring.first_bd >> 32),
+		    dev_conf->base_addr + ETH_XLNX_GEM_TXQBASEH_OFFSET);
+#endif
+	sys_write32((uint32_t)(uintptr_t)dev_data->rxbd_ring.first_bd,
 		    dev_conf->base_addr + ETH_XLNX_GEM_RXQBASE_OFFSET);
-	sys_write32((uint32_t)dev_data->txbd_ring.first_bd,
+	sys_write32((uint32_t)(uintptr_t)dev_data->txbd_ring.first_bd,
 		    dev_conf->base_addr + ETH_XLNX_GEM_TXQBASE_OFFSET);
+
+	return 0;
 }
 
 /**
@@ -1337,7 +1602,8 @@ static void eth_xlnx_gem_rx_pending_work(struct k_work *item)
  * interrupt status bit. This function acquires the incoming packet
  * data from the DMA memory area via the RX buffer descriptors and copies
  * the data to a packet which will then be handed over to the network
- * stack.
+ * stack. In zero-copy mode, the buffers containing the packet data are
+ * handed over to the network stack instead, see eth_xlnx_gem_rx_frame.
  *
  * @param dev Pointer to the device data
  */
@@ -1345,15 +1611,18 @@ static void eth_xlnx_gem_handle_rx_pending(const struct device *dev)
 {
 	const struct eth_xlnx_gem_dev_cfg *dev_conf = DEV_CFG(dev);
 	struct eth_xlnx_gem_dev_data *dev_data = DEV_DATA(dev);
-	uint32_t reg_addr;
-	uint32_t reg_ctrl;
+	mem_addr_t reg_addr;
+	mem_addr_t reg_ctrl;
 	uint32_t reg_val;
 	uint32_t reg_val_rxsr;
 	uint8_t first_bd_idx;
 	uint8_t last_bd_idx;
-	uint8_t	curr_bd_idx;
 	uint32_t rx_data_length;
+	uint32_t rx_cksum_status;
+#ifndef CONFIG_ETH_XLNX_GEM_ZERO_COPY
+	uint8_t	curr_bd_idx;
 	uint32_t rx_data_remaining;
+#endif
 	struct net_pkt *pkt;
 
 	/* Read the RX status register */
@@ -1365,10 +1634,9 @@ static void eth_xlnx_gem_handle_rx_pending(const struct device *dev)
 	 */
 
 	while (1) {
-		curr_bd_idx = dev_data->rxbd_ring.next_to_process;
-		first_bd_idx = last_bd_idx = curr_bd_idx;
-		reg_addr = (uint32_t)(&dev_data->rxbd_ring.first_bd[first_bd_idx].addr);
-		reg_ctrl = (uint32_t)(&dev_data->rxbd_ring.first_bd[first_bd_idx].ctrl);
+		first_bd_idx = last_bd_idx = dev_data->rxbd_ring.next_to_process;
+		reg_addr = (mem_addr_t)(&dev_data->rxbd_ring.first_bd[first_bd_idx].addr);
+		reg_ctrl = (mem_addr_t)(&dev_data->rxbd_ring.first_bd[first_bd_idx].ctrl);
 
 		/*
 		 * Basic precondition checks for the current BD's
@@ -1400,15 +1668,17 @@ static void eth_xlnx_gem_handle_rx_pending(const struct device *dev)
 		 * of the received packet which spans multiple buffers.
 		 */
 		do {
-			reg_ctrl = (uint32_t)(&dev_data->rxbd_ring.first_bd[last_bd_idx].ctrl);
+			reg_ctrl = (mem_addr_t)(&dev_data->rxbd_ring.first_bd[last_bd_idx].ctrl);
 			reg_val  = sys_read32(reg_ctrl);
-			rx_data_length = rx_data_remaining =
-					 (reg_val & ETH_XLNX_GEM_RXBD_FRAME_LENGTH_MASK);
+			rx_data_length = (reg_val & ETH_XLNX_GEM_RXBD_FRAME_LENGTH_MASK);
 			if ((reg_val & ETH_XLNX_GEM_RXBD_END_OF_FRAME_BIT) == 0) {
 				last_bd_idx = (last_bd_idx + 1) % dev_conf->rxbd_count;
 			}
 		} while ((reg_val & ETH_XLNX_GEM_RXBD_END_OF_FRAME_BIT) == 0);
 
+		rx_cksum_status = (reg_val >> ETH_XLNX_GEM_RXBD_BITS23_22_SHIFT) &
+				  ETH_XLNX_GEM_RXBD_BITS23_22_MASK;
+
 		/*
 		 * Store the position of the first BD behind the end of the
 		 * frame currently being processed as 'next to process'
@@ -1416,6 +1686,10 @@ static void eth_xlnx_gem_handle_rx_pending(const struct device *dev)
 		dev_data->rxbd_ring.next_to_process = (last_bd_idx + 1) %
 						      dev_conf->rxbd_count;
 
+#ifdef CONFIG_ETH_XLNX_GEM_ZERO_COPY
+		pkt = eth_xlnx_gem_rx_frame(dev, first_bd_idx, last_bd_idx,
+					    rx_data_length);
+#else
 		/*
 		 * Allocate a destination packet from the network stack
 		 * now that the total frame length is known.
@@ -1438,11 +1712,12 @@ static void eth_xlnx_gem_handle_rx_pending(const struct device *dev)
 		 * involved BDs in order to properly release them for re-use
 		 * by the controller.
 		 */
+		curr_bd_idx = first_bd_idx;
+		rx_data_remaining = rx_data_length;
 		do {
 			if (pkt != NULL) {
-				net_pkt_write(pkt, (const void *)
-					      (dev_data->rxbd_ring.first_bd[curr_bd_idx].addr &
-					      ETH_XLNX_GEM_RXBD_BUFFER_ADDR_MASK),
+				net_pkt_write(pkt, (const void *)eth_xlnx_gem_bd_get_addr(
+					      &dev_data->rxbd_ring.first_bd[curr_bd_idx]),
 					      (rx_data_remaining < dev_conf->rx_buffer_size) ?
 					      rx_data_remaining : dev_conf->rx_buffer_size);
 			}
@@ -1454,16 +1729,30 @@ static void eth_xlnx_gem_handle_rx_pending(const struct device *dev)
 			 * processed, on to the next BD -> preserve the RX BD's
 			 * 'wrap' bit & address, but clear the 'used' bit.
 			 */
-			reg_addr = (uint32_t)(&dev_data->rxbd_ring.first_bd[curr_bd_idx].addr);
+			reg_addr = (mem_addr_t)(&dev_data->rxbd_ring.first_bd[curr_bd_idx].addr);
 			reg_val	 = sys_read32(reg_addr);
 			reg_val &= ~ETH_XLNX_GEM_RXBD_USED_BIT;
 			sys_write32(reg_val, reg_addr);
 
 			curr_bd_idx = (curr_bd_idx + 1) % dev_conf->rxbd_count;
 		} while (curr_bd_idx != ((last_bd_idx + 1) % dev_conf->rxbd_count));
+#endif
 
 		/* Propagate the received packet to the network stack */
 		if (pkt != NULL) {
+			/*
+			 * With RX checksum offloading enabled, frames with
+			 * invalid checksums are discarded by the controller.
+			 * If the controller has verified the TCP or UDP check-
+			 * sum (and therefore the IP header checksum as well),
+			 * the IP stack doesn't have to do so again.
+			 */
+			if (dev_conf->enable_rx_chksum_offload &&
+			    (rx_cksum_status == ETH_XLNX_GEM_RXBD_CKSUM_TCP_CHECKED ||
+			     rx_cksum_status == ETH_XLNX_GEM_RXBD_CKSUM_UDP_CHECKED)) {
+				net_pkt_set_chksum_done(pkt, true);
+			}
+
 			if (net_recv_data(dev_data->iface, pkt) < 0) {
 				LOG_ERR("%s RX packet hand-over to IP stack failed",
 					dev->name);
@@ -1485,6 +1774,204 @@ static void eth_xlnx_gem_handle_rx_pending(const struct device *dev)
 		    dev_conf->base_addr + ETH_XLNX_GEM_IER_OFFSET);
 }
 
+#ifdef CONFIG_ETH_XLNX_GEM_ZERO_COPY
+/**
+ * @brief GEM zero-copy RX buffer allocation function
+ * Allocates a buffer from the current GEM's RX buffer pool and aligns
+ * its data pointer as required for the address word of an RX BD.
+ *
+ * @param dev Pointer to the device data
+ * @return Pointer to the allocated buffer, NULL if the pool is exhausted
+ */
+static struct net_buf *eth_xlnx_gem_rx_buf_alloc(const struct device *dev)
+{
+	struct eth_xlnx_gem_dev_data *dev_data = DEV_DATA(dev);
+	struct net_buf *buf;
+
+	buf = net_buf_alloc(dev_data->rx_pool, K_NO_WAIT);
+	if (buf != NULL) {
+		net_buf_reserve(buf, ROUND_UP((uintptr_t)buf->data,
+			ETH_XLNX_RX_POOL_BUFFER_ALIGNMENT) - (uintptr_t)buf->data);
+	}
+
+	return buf;
+}
+
+/**
+ * @brief GEM zero-copy RX frame hand-over function
+ * Hands the buffers posted to the RX BDs first_bd_idx to last_bd_idx,
+ * which contain a received frame, over to a newly allocated packet
+ * and posts replacement buffers from the RX buffer pool to these BDs.
+ * If either the packet or any of the replacement buffers cannot be
+ * allocated, the frame is dropped and the BDs are released to the
+ * controller with the buffers which are already posted to them.
+ *
+ * @param dev            Pointer to the device data
+ * @param first_bd_idx   Index of the BD containing the start of the frame
+ * @param last_bd_idx    Index of the BD containing the end of the frame
+ * @param rx_data_length Length of the received frame
+ * @return Pointer to the packet containing the frame, NULL if the frame
+ *         was dropped
+ */
+static struct net_pkt *eth_xlnx_gem_rx_frame(const struct device *dev,
+					     uint8_t first_bd_idx,
+					     uint8_t last_bd_idx,
+					     uint32_t rx_data_length)
+{
+	const struct eth_xlnx_gem_dev_cfg *dev_conf = DEV_CFG(dev);
+	struct eth_xlnx_gem_dev_data *dev_data = DEV_DATA(dev);
+	uint32_t rx_data_remaining = rx_data_length;
+	uint32_t offset = dev_conf->hw_rx_buffer_offset;
+	uint32_t chunk;
+	uint8_t bd_count;
+	uint8_t bd_iter;
+	uint8_t curr_bd_idx;
+	struct net_buf *spare_bufs = NULL;
+	struct net_buf *buf;
+	struct net_pkt *pkt;
+
+	bd_count = ((last_bd_idx + dev_conf->rxbd_count - first_bd_idx) %
+		   dev_conf->rxbd_count) + 1;
+
+	/*
+	 * Allocate the packet and one replacement buffer for each BD of
+	 * the frame up-front, chained via their fragment pointers, so that
+	 * the frame is either handed over entirely or not at all.
+	 */
+	pkt = net_pkt_rx_alloc_on_iface(dev_data->iface, K_NO_WAIT);
+	for (bd_iter = 0; pkt != NULL && bd_iter < bd_count; bd_iter++) {
+		buf = eth_xlnx_gem_rx_buf_alloc(dev);
+		if (buf == NULL) {
+			break;
+		}
+		buf->frags = spare_bufs;
+		spare_bufs = buf;
+	}
+
+	if (pkt == NULL || bd_iter < bd_count) {
+		LOG_ERR("%s RX packet buffer alloc failed: %u bytes",
+			dev->name, rx_data_length);
+#ifdef CONFIG_NET_STATISTICS_ETHERNET
+		dev_data->stats.errors.rx++;
+		dev_data->stats.error_details.rx_no_buffer_count++;
+#endif
+		if (pkt != NULL) {
+			net_pkt_unref(pkt);
+			pkt = NULL;
+		}
+		if (spare_bufs != NULL) {
+			net_buf_unref(spare_bufs);
+		}
+	}
+
+	curr_bd_idx = first_bd_idx;
+	do {
+		if (pkt != NULL) {
+			/*
+			 * The controller stores the start of the frame at the
+			 * configured offset within the first buffer.
+			 */
+			buf = dev_data->rx_bufs[curr_bd_idx];
+			chunk = MIN(rx_data_remaining,
+				    dev_conf->rx_buffer_size - offset);
+			net_buf_add(buf, offset + chunk);
+			net_buf_pull(buf, offset);
+			net_pkt_frag_add(pkt, buf);
+			rx_data_remaining -= chunk;
+			offset = 0;
+
+			buf = spare_bufs;
+			spare_bufs = buf->frags;
+			buf->frags = NULL;
+			dev_data->rx_bufs[curr_bd_idx] = buf;
+		}
+
+		/*
+		 * Post the current BD's buffer, release the BD to the
+		 * controller by clearing its 'used' bit, preserve the
+		 * 'wrap' bit.
+		 */
+		ETH_XLNX_GEM_DMA_WMB();
+		eth_xlnx_gem_bd_set_addr(&dev_data->rxbd_ring.first_bd[curr_bd_idx],
+					 (uintptr_t)dev_data->rx_bufs[curr_bd_idx]->data,
+					 (curr_bd_idx == (dev_conf->rxbd_count - 1)) ?
+					 ETH_XLNX_GEM_RXBD_WRAP_BIT : 0);
+
+		curr_bd_idx = (curr_bd_idx + 1) % dev_conf->rxbd_count;
+	} while (curr_bd_idx != ((last_bd_idx + 1) % dev_conf->rxbd_count));
+
+	return pkt;
+}
+
+/**
+ * @brief GEM zero-copy TX fragment count function
+ * Counts the non-empty fragments of a packet to be transmitted, each
+ * of which requires one TX BD.
+ *
+ * @param pkt Pointer to the packet to be transmitted
+ * @return Number of non-empty fragments of the packet
+ */
+static uint16_t eth_xlnx_gem_tx_frag_count(struct net_pkt *pkt)
+{
+	struct net_buf *frag;
+	uint16_t count = 0;
+
+	for (frag = pkt->buffer; frag != NULL; frag = frag->frags) {
+		if (frag->len != 0) {
+			count++;
+		}
+	}
+
+	return count;
+}
+
+/**
+ * @brief GEM zero-copy TX linearization function
+ * Copies a packet which is spread over more fragments than there are
+ * TX BDs to a new packet whose fragments are taken from the current
+ * GEM's RX buffer pool, which holds buffers of the size of a full
+ * frame. The TX checksum offload and TSO attributes of the packet
+ * are copied along with its data.
+ *
+ * @param dev Pointer to the device data
+ * @param pkt Pointer to the packet to be transmitted
+ * @return Pointer to the copy of the packet, NULL if either the packet
+ *         or the buffers cannot be allocated
+ */
+static struct net_pkt *eth_xlnx_gem_tx_linearize(const struct device *dev,
+						 struct net_pkt *pkt)
+{
+	size_t tx_data_remaining = net_pkt_get_len(pkt);
+	struct net_pkt *tx_pkt;
+	struct net_buf *buf;
+	size_t chunk;
+
+	tx_pkt = net_pkt_alloc_on_iface(net_pkt_iface(pkt), K_NO_WAIT);
+	if (tx_pkt == NULL) {
+		return NULL;
+	}
+
+	net_pkt_cursor_init(pkt);
+	while (tx_data_remaining > 0) {
+		buf = eth_xlnx_gem_rx_buf_alloc(dev);
+		if (buf == NULL) {
+			net_pkt_unref(tx_pkt);
+			return NULL;
+		}
+
+		chunk = MIN(tx_data_remaining, net_buf_tailroom(buf));
+		net_pkt_read(pkt, net_buf_add(buf, chunk), chunk);
+		net_pkt_frag_add(tx_pkt, buf);
+		tx_data_remaining -= chunk;
+	}
+
+	net_pkt_set_tx_chksum_offset(tx_pkt, net_pkt_tx_chksum_offset(pkt));
+	net_pkt_set_tso_mss(tx_pkt, net_pkt_tso_mss(pkt));
+
+	return tx_pkt;
+}
+#endif /* CONFIG_ETH_XLNX_GEM_ZERO_COPY */
+
 /**
  * @brief GEM TX done handler wrapper for the work queue
  * Wraps the TX done handler, eth_xlnx_gem_handle_tx_done,
@@ -1514,10 +2001,12 @@ static void eth_xlnx_gem_tx_done_work(struct k_work *item)
  * in the controller's interrupt status register (gem.intr_status).
  * No further TX done interrupts will be triggered until this handler
  * has been executed, which eventually clears the corresponding
- * interrupt status bit. Once this handler reaches the end of its
- * execution, the eth_xlnx_gem_send call which effectively triggered
- * it is unblocked by posting to the current GEM's TX done semaphore
- * on which the send function is blocking.
+ * interrupt status bit. The BDs of all frames completed by the
+ * controller are released, which may be more than one frame if TX
+ * complete interrupts are moderated or in zero-copy mode. Once this
+ * handler reaches the end of its execution, a blocking eth_xlnx_gem_-
+ * send call is unblocked by posting to the current GEM's TX done
+ * semaphore.
  *
  * @param dev Pointer to the device data
  */
@@ -1525,13 +2014,16 @@ static void eth_xlnx_gem_handle_tx_done(const struct device *dev)
 {
 	const struct eth_xlnx_gem_dev_cfg *dev_conf = DEV_CFG(dev);
 	struct eth_xlnx_gem_dev_data *dev_data = DEV_DATA(dev);
-	uint32_t reg_ctrl;
+	mem_addr_t reg_ctrl;
 	uint32_t reg_val;
 	uint32_t reg_val_txsr;
 	uint8_t curr_bd_idx;
 	uint8_t first_bd_idx;
-	uint8_t bds_processed = 0;
+	uint8_t bds_processed;
 	uint8_t bd_is_last;
+#ifdef CONFIG_ETH_XLNX_GEM_ZERO_COPY
+	uint32_t tx_cksum_error;
+#endif
 
 	/* Read the TX status register */
 	reg_val_txsr = sys_read32(dev_conf->base_addr + ETH_XLNX_GEM_TXSR_OFFSET);
@@ -1545,49 +2037,87 @@ static void eth_xlnx_gem_handle_tx_done(const struct device *dev)
 		k_sem_take(&(dev_data->txbd_ring.ring_sem), K_FOREVER);
 	}
 
-	curr_bd_idx = first_bd_idx = dev_data->txbd_ring.next_to_process;
-	reg_ctrl = (uint32_t)(&dev_data->txbd_ring.first_bd[curr_bd_idx].ctrl);
-	reg_val  = sys_read32(reg_ctrl);
-
-	do {
-		++bds_processed;
+	/*
+	 * Once a frame has been transmitted, the controller sets the 'used'
+	 * bit of the frame's first BD -> process frames until a BD is
+	 * encountered whose 'used' bit is still cleared.
+	 */
+	while (dev_data->txbd_ring.free_bds < dev_conf->txbd_count) {
+		curr_bd_idx = first_bd_idx = dev_data->txbd_ring.next_to_process;
+		reg_ctrl = (mem_addr_t)(&dev_data->txbd_ring.first_bd[curr_bd_idx].ctrl);
+		reg_val  = sys_read32(reg_ctrl);
+		if ((reg_val & ETH_XLNX_GEM_TXBD_USED_BIT) == 0) {
+			break;
+		}
+		bds_processed = 0;
 
+#ifdef CONFIG_ETH_XLNX_GEM_ZERO_COPY
 		/*
-		 * TODO Evaluate error flags from current BD control word
-		 * here for proper error handling
+		 * Checksum generation errors are reported in the frame's
+		 * first BD. The controller transmits such a frame without
+		 * inserting the checksums.
 		 */
+		tx_cksum_error = (reg_val >> ETH_XLNX_GEM_TXBD_CKSUM_OFFLOAD_ERROR_SHIFT) &
+				 ETH_XLNX_GEM_TXBD_CKSUM_OFFLOAD_ERROR_MASK;
+#endif
 
-		/*
-		 * Check if the BD we're currently looking at is the last BD
-		 * of the current transmission
-		 */
-		bd_is_last = ((reg_val & ETH_XLNX_GEM_TXBD_LAST_BIT) != 0) ? 1 : 0;
+		do {
+			++bds_processed;
 
-		/*
-		 * Reset control word of the current BD, clear everything but
-		 * the 'wrap' bit, then set the 'used' bit
-		 */
-		reg_val &= ETH_XLNX_GEM_TXBD_WRAP_BIT;
-		reg_val |= ETH_XLNX_GEM_TXBD_USED_BIT;
-		sys_write32(reg_val, reg_ctrl);
+			/*
+			 * TODO Evaluate error flags from current BD control word
+			 * here for proper error handling
+			 */
 
-		/* Move on to the next BD or break out of the loop */
-		if (bd_is_last == 1) {
-			break;
+			/*
+			 * Check if the BD we're currently looking at is the last BD
+			 * of the current transmission
+			 */
+			bd_is_last = ((reg_val & ETH_XLNX_GEM_TXBD_LAST_BIT) != 0) ? 1 : 0;
+
+			/*
+			 * Reset control word of the current BD, clear everything but
+			 * the 'wrap' bit, then set the 'used' bit
+			 */
+			reg_val &= ETH_XLNX_GEM_TXBD_WRAP_BIT;
+			reg_val |= ETH_XLNX_GEM_TXBD_USED_BIT;
+			sys_write32(reg_val, reg_ctrl);
+
+			/* Move on to the next BD or break out of the loop */
+			if (bd_is_last == 1) {
+				break;
+			}
+			curr_bd_idx = (curr_bd_idx + 1) % dev_conf->txbd_count;
+			reg_ctrl = (mem_addr_t)(&dev_data->txbd_ring.first_bd[curr_bd_idx].ctrl);
+			reg_val  = sys_read32(reg_ctrl);
+		} while (bd_is_last == 0 && curr_bd_idx != first_bd_idx);
+
+		if (curr_bd_idx == first_bd_idx && bd_is_last == 0) {
+			LOG_WRN("%s TX done handling wrapped around", dev->name);
 		}
-		curr_bd_idx = (curr_bd_idx + 1) % dev_conf->txbd_count;
-		reg_ctrl = (uint32_t)(&dev_data->txbd_ring.first_bd[curr_bd_idx].ctrl);
-		reg_val  = sys_read32(reg_ctrl);
-	} while (bd_is_last == 0 && curr_bd_idx != first_bd_idx);
 
-	if (curr_bd_idx == first_bd_idx && bd_is_last == 0) {
-		LOG_WRN("%s TX done handling wrapped around", dev->name);
-	}
+#ifdef CONFIG_ETH_XLNX_GEM_ZERO_COPY
+		/* Release the packet referenced by the frame's last BD */
+		if (dev_data->tx_pkts[curr_bd_idx] != NULL) {
+			if (tx_cksum_error != ETH_XLNX_GEM_CKSUM_NO_ERROR &&
+			    net_pkt_is_tx_chksum_offload(dev_data->tx_pkts[curr_bd_idx])) {
+				LOG_ERR("%s TX checksum offload error %u",
+					dev->name, tx_cksum_error);
+#ifdef CONFIG_NET_STATISTICS_ETHERNET
+				dev_data->stats.errors.tx++;
+#endif
+			}
 
-	dev_data->txbd_ring.next_to_process =
-		(dev_data->txbd_ring.next_to_process + bds_processed) %
-		dev_conf->txbd_count;
-	dev_data->txbd_ring.free_bds += bds_processed;
+			net_pkt_unref(dev_data->tx_pkts[curr_bd_idx]);
+			dev_data->tx_pkts[curr_bd_idx] = NULL;
+		}
+#endif
+
+		dev_data->txbd_ring.next_to_process =
+			(dev_data->txbd_ring.next_to_process + bds_processed) %
+			dev_conf->txbd_count;
+		dev_data->txbd_ring.free_bds += bds_processed;
+	}
 
 	if (dev_conf->defer_txd_to_queue) {
 		k_sem_give(&(dev_data->txbd_ring.ring_sem));
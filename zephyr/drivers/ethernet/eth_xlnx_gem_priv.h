@@ -19,6 +19,19 @@
 #include "phy_xlnx_gem.h"
 
 #define ETH_XLNX_BUFFER_ALIGNMENT			4 /* RX/TX buffer alignment (in bytes) */
+#define ETH_XLNX_RX_POOL_BUFFER_ALIGNMENT		8 /* Zero-copy RX buffer alignment */
+
+/*
+ * Write barrier ordering the CPU's writes to the BDs / DMA buffers before
+ * subsequent writes which hand them over to the controller. Required on
+ * RISC-V, whose memory model allows other bus masters to observe stores
+ * out of program order.
+ */
+#ifdef CONFIG_RISCV
+#define ETH_XLNX_GEM_DMA_WMB() __asm__ volatile ("fence ow, ow" ::: "memory")
+#else
+#define ETH_XLNX_GEM_DMA_WMB() compiler_barrier()
+#endif
 
 /* Buffer descriptor (BD) related defines */
 
@@ -74,6 +87,12 @@
 #define ETH_XLNX_GEM_RXBD_FCS_STATUS_BIT		0x00002000
 #define ETH_XLNX_GEM_RXBD_FRAME_LENGTH_MASK		0x00001FFF
 
+/* RX BD control word bits [23 .. 22] if RX checksum offloading is enabled */
+#define ETH_XLNX_GEM_RXBD_CKSUM_NOT_CHECKED		0x00000000
+#define ETH_XLNX_GEM_RXBD_CKSUM_IP_CHECKED		0x00000001
+#define ETH_XLNX_GEM_RXBD_CKSUM_TCP_CHECKED		0x00000002
+#define ETH_XLNX_GEM_RXBD_CKSUM_UDP_CHECKED		0x00000003
+
 /* Transmit Buffer Descriptor bits & masks: comp. Zynq-7000 TRM, Table 16-3. */
 
 /*
@@ -154,6 +173,9 @@
  * LADDR3H  = gem.spec_addr3_top Specific address 3 top    register
  * LADDR4L  = gem.spec_addr4_bot Specific address 4 bottom register
  * LADDR4H  = gem.spec_addr4_top Specific address 4 top    register
+ * INTMOD   = gem.intr_moderation Interrupt moderation     register
+ * TXQBASEH = gem.upper_tx_q_base_addr TXQ base address [63..32] register
+ * RXQBASEH = gem.upper_rx_q_base_addr RXQ base address [63..32] register
  */
 #define ETH_XLNX_GEM_NWCTRL_OFFSET			0x00000000
 #define ETH_XLNX_GEM_NWCFG_OFFSET			0x00000004
@@ -168,6 +190,7 @@
 #define ETH_XLNX_GEM_IDR_OFFSET				0x0000002C
 #define ETH_XLNX_GEM_IMR_OFFSET				0x00000030
 #define ETH_XLNX_GEM_PHY_MAINTENANCE_OFFSET		0x00000034
+#define ETH_XLNX_GEM_INTMOD_OFFSET			0x0000005C
 #define ETH_XLNX_GEM_LADDR1L_OFFSET			0x00000088
 #define ETH_XLNX_GEM_LADDR1H_OFFSET			0x0000008C
 #define ETH_XLNX_GEM_LADDR2L_OFFSET			0x00000090
@@ -176,6 +199,8 @@
 #define ETH_XLNX_GEM_LADDR3H_OFFSET			0x0000009C
 #define ETH_XLNX_GEM_LADDR4L_OFFSET			0x000000A0
 #define ETH_XLNX_GEM_LADDR4H_OFFSET			0x000000A4
+#define ETH_XLNX_GEM_TXQBASEH_OFFSET			0x000004C8
+#define ETH_XLNX_GEM_RXQBASEH_OFFSET			0x000004D4
 
 /*
  * Masks for clearing registers during initialization:
@@ -282,6 +307,7 @@
 
 /*
  * gem.dma_cfg:
+ * [30]       64-bit DMA addressing (not available on the Zynq-7000)
  * [24]       Discard packets when AHB resource is unavailable
  * [23 .. 16] RX buffer size, n * 64 bytes
  * [11]       Enable/disable TCP|UDP/IP TX checksum offload
@@ -291,6 +317,7 @@
  * [06]       Descriptor access endianness configuration
  * [04 .. 00] AHB fixed burst length for DMA data operations
  */
+#define ETH_XLNX_GEM_DMACR_ADDR_64BIT_BIT		0x40000000
 #define ETH_XLNX_GEM_DMACR_DISCNOAHB_BIT		0x01000000
 #define ETH_XLNX_GEM_DMACR_RX_BUF_MASK			0x000000FF
 #define ETH_XLNX_GEM_DMACR_RX_BUF_SHIFT			16
@@ -358,6 +385,15 @@
 #define ETH_XLNX_GEM_IXR_ALL_MASK			0x03FC7FFE
 #define ETH_XLNX_GEM_IXR_ERRORS_MASK			0x00000C60
 
+/*
+ * gem.intr_moderation (not available on the Zynq-7000):
+ * [23 .. 16] TX complete interrupt moderation, n * 800 ns
+ * [07 .. 00] Frame received interrupt moderation, n * 800 ns
+ */
+#define ETH_XLNX_GEM_INTMOD_MASK			0x000000FF
+#define ETH_XLNX_GEM_INTMOD_TX_SHIFT			16
+#define ETH_XLNX_GEM_INTMOD_RX_SHIFT			0
+
 /* Bits / bit masks relating to the GEM's MDIO interface */
 
 /*
@@ -409,8 +445,9 @@ ETH_NET_DEVICE_DT_INST_DEFINE(port,\
 static const struct eth_xlnx_gem_dev_cfg eth_xlnx_gem##port##_dev_cfg = {\
 	.base_addr			= DT_REG_ADDR_BY_IDX(DT_INST(port, xlnx_gem), 0),\
 	.config_func			= eth_xlnx_gem##port##_irq_config,\
-	.pll_clock_frequency		= DT_INST_PROP(port, clock_frequency),\
-	.clk_ctrl_reg_address		= DT_REG_ADDR_BY_IDX(DT_INST(port, xlnx_gem), 1),\
+	.pll_clock_frequency		= DT_INST_PROP_OR(port, clock_frequency, 0),\
+	.clk_ctrl_reg_address		= COND_CODE_1(DT_INST_REG_HAS_IDX(port, 1),\
+		(DT_INST_REG_ADDR_BY_IDX(port, 1)), (0)),\
 	.mdc_divider			= (enum eth_xlnx_mdc_clock_divider)\
 		(DT_INST_PROP(port, mdc_divider)),\
 	.max_link_speed			= (enum eth_xlnx_link_speed)\
@@ -437,6 +474,10 @@ static const struct eth_xlnx_gem_dev_cfg eth_xlnx_gem##port##_dev_cfg = {\
 		(ETH_XLNX_BUFFER_ALIGNMENT-1)) & ~(ETH_XLNX_BUFFER_ALIGNMENT-1)),\
 	.tx_buffer_size			= (((uint16_t)(DT_INST_PROP(port, tx_buffer_size)) +\
 		(ETH_XLNX_BUFFER_ALIGNMENT-1)) & ~(ETH_XLNX_BUFFER_ALIGNMENT-1)),\
+	.rx_intr_moderation		= (uint8_t)\
+		(DT_INST_PROP(port, rx_interrupt_moderation)),\
+	.tx_intr_moderation		= (uint8_t)\
+		(DT_INST_PROP(port, tx_interrupt_moderation)),\
 	.ignore_ipg_rxer		= DT_INST_PROP(port, ignore_ipg_rxer),\
 	.disable_reject_nsp		= DT_INST_PROP(port, disable_reject_nsp),\
 	.enable_ipg_stretch		= DT_INST_PROP(port, ipg_stretch),\
@@ -472,11 +513,41 @@ static struct eth_xlnx_gem_dev_data eth_xlnx_gem##port##_dev_data = {\
 	.eff_link_speed  = LINK_DOWN,\
 	.phy_addr        = 0,\
 	.phy_id          = 0,\
-	.phy_access_api  = NULL,\
-	.first_rx_buffer = NULL,\
-	.first_tx_buffer = NULL\
+	.phy_access_api  = NULL\
+};
+
+#ifdef CONFIG_ETH_XLNX_GEM_ZERO_COPY
+/*
+ * DMA memory area declaration macro: in zero-copy mode, the RX BDs
+ * point to buffers taken from the controller's RX buffer pool and the
+ * TX BDs point straight to the fragments of the packets being sent,
+ * so that only the BDs themselves live in the DMA memory area.
+ */
+#define ETH_XLNX_GEM_DMA_AREA_DECL(port) \
+struct eth_xlnx_dma_area_gem##port {\
+	struct eth_xlnx_gem_bd rx_bd[DT_INST_PROP(port, rx_buffer_descriptors)];\
+	struct eth_xlnx_gem_bd tx_bd[DT_INST_PROP(port, tx_buffer_descriptors)];\
 };
 
+/*
+ * RX buffer pool & BD bookkeeping declaration macro: one pool buffer is
+ * posted to each RX BD, the spare ones replace the buffers handed over
+ * to the network stack. The pool's buffers are over-allocated so that
+ * their data can be aligned as required for the RX BDs' address words.
+ */
+#define ETH_XLNX_GEM_RX_POOL_DECL(port) \
+NET_BUF_POOL_FIXED_DEFINE(eth_xlnx_gem##port##_rx_pool,\
+	(DT_INST_PROP(port, rx_buffer_descriptors) +\
+	CONFIG_ETH_XLNX_GEM_RX_POOL_SPARE_BUFFERS),\
+	(((DT_INST_PROP(port, rx_buffer_size)\
+	+ (ETH_XLNX_BUFFER_ALIGNMENT - 1))\
+	& ~(ETH_XLNX_BUFFER_ALIGNMENT - 1))\
+	+ ETH_XLNX_RX_POOL_BUFFER_ALIGNMENT), NULL);\
+static struct net_buf *eth_xlnx_gem##port##_rx_bufs\
+	[DT_INST_PROP(port, rx_buffer_descriptors)];\
+static struct net_pkt *eth_xlnx_gem##port##_tx_pkts\
+	[DT_INST_PROP(port, tx_buffer_descriptors)];
+#else
 /* DMA memory area declaration macro */
 #define ETH_XLNX_GEM_DMA_AREA_DECL(port) \
 struct eth_xlnx_dma_area_gem##port {\
@@ -494,6 +565,9 @@ struct eth_xlnx_dma_area_gem##port {\
 		& ~(ETH_XLNX_BUFFER_ALIGNMENT - 1))];\
 };
 
+#define ETH_XLNX_GEM_RX_POOL_DECL(port)
+#endif /* CONFIG_ETH_XLNX_GEM_ZERO_COPY */
+
 /* DMA memory area instantiation macro */
 #define ETH_XLNX_GEM_DMA_AREA_INST(port) \
 static struct eth_xlnx_dma_area_gem##port eth_xlnx_gem##port##_dma_area \
@@ -510,6 +584,16 @@ static void eth_xlnx_gem##port##_irq_config(const struct device *dev)\
 }
 
 /* RX/TX BD Ring initialization macro */
+#ifdef CONFIG_ETH_XLNX_GEM_ZERO_COPY
+#define ETH_XLNX_GEM_INIT_BD_RING(port) \
+if (dev_conf->base_addr == DT_REG_ADDR_BY_IDX(DT_INST(port, xlnx_gem), 0)) {\
+	dev_data->rxbd_ring.first_bd = &(eth_xlnx_gem##port##_dma_area.rx_bd[0]);\
+	dev_data->txbd_ring.first_bd = &(eth_xlnx_gem##port##_dma_area.tx_bd[0]);\
+	dev_data->rx_pool = &eth_xlnx_gem##port##_rx_pool;\
+	dev_data->rx_bufs = eth_xlnx_gem##port##_rx_bufs;\
+	dev_data->tx_pkts = eth_xlnx_gem##port##_tx_pkts;\
+}
+#else
 #define ETH_XLNX_GEM_INIT_BD_RING(port) \
 if (dev_conf->base_addr == DT_REG_ADDR_BY_IDX(DT_INST(port, xlnx_gem), 0)) {\
 	dev_data->rxbd_ring.first_bd = &(eth_xlnx_gem##port##_dma_area.rx_bd[0]);\
@@ -517,6 +601,7 @@ if (dev_conf->base_addr == DT_REG_ADDR_BY_IDX(DT_INST(port, xlnx_gem), 0)) {\
 	dev_data->first_rx_buffer = (uint8_t *)eth_xlnx_gem##port##_dma_area.rx_buffer;\
 	dev_data->first_tx_buffer = (uint8_t *)eth_xlnx_gem##port##_dma_area.tx_buffer;\
 }
+#endif /* CONFIG_ETH_XLNX_GEM_ZERO_COPY */
 
 /* Top-level device initialization macro - bundles all of the above */
 #define ETH_XLNX_GEM_INITIALIZE(port) \
@@ -525,6 +610,7 @@ ETH_XLNX_GEM_DEV_CONFIG(port);\
 ETH_XLNX_GEM_DEV_DATA(port);\
 ETH_XLNX_GEM_DMA_AREA_DECL(port);\
 ETH_XLNX_GEM_DMA_AREA_INST(port);\
+ETH_XLNX_GEM_RX_POOL_DECL(port);\
 ETH_XLNX_GEM_NET_DEV_INIT(port);\
 
 /* IRQ handler function type */
@@ -565,15 +651,19 @@ enum eth_xlnx_amba_dbus_width {
  *
  * Enumeration type containing the supported clock divider values
  * used to generate the MDIO interface clock (MDC) from the ZynqMP's
- * LPD LSBUS clock. This is a configuration item in the controller's
- * net_cfg register.
+ * LPD LSBUS clock or the PolarFire SoC's MSS APB/AHB clock. This is a
+ * configuration item in the controller's net_cfg register.
  */
 enum eth_xlnx_mdc_clock_divider {
 	/* The values of this enum are consecutively numbered */
 	MDC_DIVIDER_8 = 0,
 	MDC_DIVIDER_16,
 	MDC_DIVIDER_32,
-	MDC_DIVIDER_48
+	MDC_DIVIDER_48,
+	MDC_DIVIDER_64,
+	MDC_DIVIDER_96,
+	MDC_DIVIDER_128,
+	MDC_DIVIDER_224
 };
 
 /**
@@ -617,12 +707,17 @@ enum eth_xlnx_ahb_burst_length {
  * with the controller.
  */
 struct eth_xlnx_gem_bd {
-	/* TODO for Cortex-A53: 64-bit addressing */
 	/* TODO: timestamping support */
 	/* Buffer physical address (absolute address) */
 	uint32_t		addr;
 	/* Buffer control word (different contents for RX and TX) */
 	uint32_t		ctrl;
+#ifdef CONFIG_ETH_XLNX_GEM_64BIT_DMA
+	/* Buffer physical address bits [63..32] */
+	uint32_t		addr_hi;
+	/* Unused unless timestamps are stored in the BDs */
+	uint32_t		reserved;
+#endif
 };
 
 /**
@@ -660,14 +755,16 @@ struct eth_xlnx_gem_bdring {
  * data from Kconfig, or from header file based on the device tree
  * data. Some of the data contained, in particular data relating
  * to clock sources, is specific to either the Zynq-7000 or the
- * UltraScale SoCs, which both contain the GEM.
+ * UltraScale SoCs, which both contain the GEM. On the PolarFire SoC,
+ * which contains the GEM as well, the MAC clocks are set up by the
+ * platform and no clock control register is specified.
  */
 struct eth_xlnx_gem_dev_cfg {
-	uint32_t			base_addr;
+	mem_addr_t			base_addr;
 	eth_xlnx_gem_config_irq_t	config_func;
 
 	uint32_t			pll_clock_frequency;
-	uint32_t			clk_ctrl_reg_address;
+	mem_addr_t			clk_ctrl_reg_address;
 	enum eth_xlnx_mdc_clock_divider	mdc_divider;
 
 	enum eth_xlnx_link_speed	max_link_speed;
@@ -688,6 +785,9 @@ struct eth_xlnx_gem_dev_cfg {
 	uint16_t			rx_buffer_size;
 	uint16_t			tx_buffer_size;
 
+	uint8_t				rx_intr_moderation;
+	uint8_t				tx_intr_moderation;
+
 	bool				ignore_ipg_rxer : 1;
 	bool				disable_reject_nsp : 1;
 	bool				enable_ipg_stretch : 1;
@@ -736,8 +836,14 @@ struct eth_xlnx_gem_dev_data {
 	struct k_work_delayable		phy_poll_delayed_work;
 	struct phy_xlnx_gem_api		*phy_access_api;
 
+#ifdef CONFIG_ETH_XLNX_GEM_ZERO_COPY
+	struct net_buf_pool		*rx_pool;
+	struct net_buf			**rx_bufs;
+	struct net_pkt			**tx_pkts;
+#else
 	uint8_t				*first_rx_buffer;
 	uint8_t				*first_tx_buffer;
+#endif
 
 	struct eth_xlnx_gem_bdring	rxbd_ring;
 	struct eth_xlnx_gem_bdring	txbd_ring;
@@ -34,7 +34,7 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME);
  * @return          16-bit data word received from the PHY
  */
 static uint16_t phy_xlnx_gem_mdio_read(
-	uint32_t base_addr, uint8_t phy_addr,
+	mem_addr_t base_addr, uint8_t phy_addr,
 	uint8_t reg_addr)
 {
 	uint32_t reg_val;
@@ -55,9 +55,9 @@ static uint16_t phy_xlnx_gem_mdio_read(
 		reg_val = sys_read32(base_addr + ETH_XLNX_GEM_NWSR_OFFSET);
 	} while ((reg_val & ETH_XLNX_GEM_MDIO_IDLE_BIT) == 0 && poll_cnt < 10);
 	if (poll_cnt == 10) {
-		LOG_ERR("GEM@0x%08X read from PHY address %hhu, "
+		LOG_ERR("GEM@0x%08lX read from PHY address %hhu, "
 			"register address %hhu timed out",
-			base_addr, phy_addr, reg_addr);
+			(unsigned long)base_addr, phy_addr, reg_addr);
 		return 0;
 	}
 
@@ -87,9 +87,9 @@ static uint16_t phy_xlnx_gem_mdio_read(
 		reg_val = sys_read32(base_addr + ETH_XLNX_GEM_NWSR_OFFSET);
 	} while ((reg_val & ETH_XLNX_GEM_MDIO_IDLE_BIT) == 0 && poll_cnt < 10);
 	if (poll_cnt == 10) {
-		LOG_ERR("GEM@0x%08X read from PHY address %hhu, "
+		LOG_ERR("GEM@0x%08lX read from PHY address %hhu, "
 			"register address %hhu timed out",
-			base_addr, phy_addr, reg_addr);
+			(unsigned long)base_addr, phy_addr, reg_addr);
 		return 0;
 	}
 
@@ -111,7 +111,7 @@ static uint16_t phy_xlnx_gem_mdio_read(
  * @param value     16-bit data word to be written to the target register
  */
 static void phy_xlnx_gem_mdio_write(
-	uint32_t base_addr, uint8_t phy_addr,
+	mem_addr_t base_addr, uint8_t phy_addr,
 	uint8_t reg_addr, uint16_t value)
 {
 	uint32_t reg_val;
@@ -132,9 +132,9 @@ static void phy_xlnx_gem_mdio_write(
 		reg_val = sys_read32(base_addr + ETH_XLNX_GEM_NWSR_OFFSET);
 	} while ((reg_val & ETH_XLNX_GEM_MDIO_IDLE_BIT) == 0 && poll_cnt < 10);
 	if (poll_cnt == 10) {
-		LOG_ERR("GEM@0x%08X write to PHY address %hhu, "
+		LOG_ERR("GEM@0x%08lX write to PHY address %hhu, "
 			"register address %hhu timed out",
-			base_addr, phy_addr, reg_addr);
+			(unsigned long)base_addr, phy_addr, reg_addr);
 		return;
 	}
 
@@ -166,9 +166,9 @@ static void phy_xlnx_gem_mdio_write(
 		reg_val = sys_read32(base_addr + ETH_XLNX_GEM_NWSR_OFFSET);
 	} while ((reg_val & ETH_XLNX_GEM_MDIO_IDLE_BIT) == 0 && poll_cnt < 10);
 	if (poll_cnt == 10) {
-		LOG_ERR("GEM@0x%08X write to PHY address %hhu, "
+		LOG_ERR("GEM@0x%08lX write to PHY address %hhu, "
 			"register address %hhu timed out",
-			base_addr, phy_addr, reg_addr);
+			(unsigned long)base_addr, phy_addr, reg_addr);
 	}
 }
 
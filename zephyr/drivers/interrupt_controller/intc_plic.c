@@ -16,6 +16,7 @@
 #include <arch/cpu.h>
 #include <init.h>
 #include <soc.h>
+#include <spinlock.h>
 
 #include <sw_isr_table.h>
 
@@ -27,12 +28,114 @@
 #define PLIC_IRQS        (CONFIG_NUM_IRQS - CONFIG_2ND_LVL_ISR_TBL_OFFSET)
 #define PLIC_EN_SIZE     ((PLIC_IRQS >> 5) + 1)
 
+/* Distance between consecutive contexts in the enable and claim blocks */
+#define PLIC_EN_CTX_STRIDE	0x80
+#define PLIC_REG_CTX_STRIDE	0x1000
+
 struct plic_regs_t {
 	uint32_t threshold_prio;
 	uint32_t claim_complete;
 };
 
-static int save_irq;
+#ifdef CONFIG_PLIC_PER_HART_CONTEXT
+BUILD_ASSERT(DT_INST_NODE_HAS_PROP(0, riscv_m_mode_contexts),
+	     "PLIC_PER_HART_CONTEXT requires riscv,m-mode-contexts");
+BUILD_ASSERT(CONFIG_MP_NUM_CPUS <= 8,
+	     "PLIC affinity masks are 8 bits wide");
+
+static const uint32_t plic_m_contexts[] =
+	DT_INST_PROP(0, riscv_m_mode_contexts);
+
+BUILD_ASSERT(ARRAY_SIZE(plic_m_contexts) >=
+	     (CONFIG_SMP_BASE_CPU + CONFIG_MP_NUM_CPUS),
+	     "riscv,m-mode-contexts does not cover every Zephyr hart");
+
+#if DT_INST_NODE_HAS_PROP(0, riscv_s_mode_contexts)
+static const uint32_t plic_s_contexts[] =
+	DT_INST_PROP(0, riscv_s_mode_contexts);
+#endif
+
+#if DT_INST_NODE_HAS_PROP(0, zephyr_irq_affinity)
+static const uint32_t plic_static_affinity[] =
+	DT_INST_PROP(0, zephyr_irq_affinity);
+
+BUILD_ASSERT((ARRAY_SIZE(plic_static_affinity) % 2) == 0,
+	     "zephyr,irq-affinity must hold <irq cpu-mask> pairs");
+#endif
+
+#define PLIC_DEFAULT_AFFINITY \
+	(CONFIG_PLIC_IRQ_DEFAULT_AFFINITY & BIT_MASK(CONFIG_MP_NUM_CPUS))
+
+/*
+ * CPUs each interrupt source is routed to, bit N is Zephyr CPU N.
+ * Zero means the source has not been routed and uses the default mask.
+ */
+static uint8_t plic_affinity[PLIC_IRQS];
+
+#define PLIC_CPU_CONTEXT(cpu) \
+	plic_m_contexts[(cpu) + CONFIG_SMP_BASE_CPU]
+#define PLIC_IRQ_AFFINITY(irq) \
+	((plic_affinity[(irq)] != 0U) ? plic_affinity[(irq)] : \
+	 PLIC_DEFAULT_AFFINITY)
+
+BUILD_ASSERT(PLIC_DEFAULT_AFFINITY != 0,
+	     "PLIC_IRQ_DEFAULT_AFFINITY selects no Zephyr CPU");
+#else
+#define PLIC_CPU_CONTEXT(cpu)	0
+#define PLIC_IRQ_AFFINITY(irq)	BIT(0)
+#endif /* CONFIG_PLIC_PER_HART_CONTEXT */
+
+static struct k_spinlock plic_lock;
+
+/*
+ * The claimed IRQ is saved per CPU, as harts may be servicing
+ * different PLIC interrupts at the same time.
+ */
+static int save_irq[CONFIG_MP_NUM_CPUS];
+
+static inline volatile uint32_t *plic_context_en(uint32_t ctx)
+{
+	return (volatile uint32_t *)(PLIC_IRQ_EN + ctx * PLIC_EN_CTX_STRIDE);
+}
+
+static inline volatile struct plic_regs_t *plic_context_regs(uint32_t ctx)
+{
+	return (volatile struct plic_regs_t *)
+		(PLIC_REG + ctx * PLIC_REG_CTX_STRIDE);
+}
+
+static void plic_irq_en_set(uint32_t ctx, uint32_t irq, bool enable)
+{
+	volatile uint32_t *en = plic_context_en(ctx);
+
+	en += (irq >> 5);
+	if (enable) {
+		*en |= (1 << (irq & 31));
+	} else {
+		*en &= ~(1 << (irq & 31));
+	}
+}
+
+static void plic_irq_route(uint32_t irq, uint32_t cpu_mask, bool enable)
+{
+	unsigned int cpu;
+
+	for (cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+		if ((cpu_mask & BIT(cpu)) != 0U) {
+			plic_irq_en_set(PLIC_CPU_CONTEXT(cpu), irq, enable);
+		}
+	}
+}
+
+static bool plic_irq_en_get(uint32_t irq)
+{
+	/* All CPUs of the affinity mask share the enable state */
+	unsigned int cpu = find_lsb_set(PLIC_IRQ_AFFINITY(irq)) - 1;
+	volatile uint32_t *en = plic_context_en(PLIC_CPU_CONTEXT(cpu));
+
+	en += (irq >> 5);
+	return (*en & (1 << (irq & 31))) != 0U;
+}
 
 /**
  *
@@ -48,13 +151,10 @@ static int save_irq;
  */
 void riscv_plic_irq_enable(uint32_t irq)
 {
-	uint32_t key;
-	volatile uint32_t *en = (volatile uint32_t *)PLIC_IRQ_EN;
+	k_spinlock_key_t key = k_spin_lock(&plic_lock);
 
-	key = irq_lock();
-	en += (irq >> 5);
-	*en |= (1 << (irq & 31));
-	irq_unlock(key);
+	plic_irq_route(irq, PLIC_IRQ_AFFINITY(irq), true);
+	k_spin_unlock(&plic_lock, key);
 }
 
 /**
@@ -71,13 +171,10 @@ void riscv_plic_irq_enable(uint32_t irq)
  */
 void riscv_plic_irq_disable(uint32_t irq)
 {
-	uint32_t key;
-	volatile uint32_t *en = (volatile uint32_t *)PLIC_IRQ_EN;
+	k_spinlock_key_t key = k_spin_lock(&plic_lock);
 
-	key = irq_lock();
-	en += (irq >> 5);
-	*en &= ~(1 << (irq & 31));
-	irq_unlock(key);
+	plic_irq_route(irq, PLIC_IRQ_AFFINITY(irq), false);
+	k_spin_unlock(&plic_lock, key);
 }
 
 /**
@@ -91,11 +188,51 @@ void riscv_plic_irq_disable(uint32_t irq)
  */
 int riscv_plic_irq_is_enabled(uint32_t irq)
 {
-	volatile uint32_t *en = (volatile uint32_t *)PLIC_IRQ_EN;
+	return plic_irq_en_get(irq) ? 1 : 0;
+}
 
-	en += (irq >> 5);
-	return !!(*en & (1 << (irq & 31)));
+#ifdef CONFIG_PLIC_PER_HART_CONTEXT
+/**
+ *
+ * @brief Route a riscv PLIC-specific interrupt line to a set of CPUs
+ *
+ * This routine selects the CPUs whose PLIC context may claim the given
+ * interrupt line. If the line is enabled, it is moved to the new set of
+ * contexts at once; otherwise the mask is applied by the next
+ * riscv_plic_irq_enable().
+ * @param irq IRQ number to route
+ * @param cpu_mask Bit N set routes the IRQ to Zephyr CPU N
+ *
+ * @return 0 on success, -EINVAL on an invalid IRQ or empty CPU mask
+ */
+int riscv_plic_irq_set_affinity(uint32_t irq, uint32_t cpu_mask)
+{
+	k_spinlock_key_t key;
+	bool enabled;
+
+	cpu_mask &= BIT_MASK(CONFIG_MP_NUM_CPUS);
+	if (irq == 0U || irq >= PLIC_IRQS || cpu_mask == 0U) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&plic_lock);
+
+	enabled = plic_irq_en_get(irq);
+	if (enabled) {
+		plic_irq_route(irq, PLIC_IRQ_AFFINITY(irq), false);
+	}
+
+	plic_affinity[irq] = (uint8_t)cpu_mask;
+
+	if (enabled) {
+		plic_irq_route(irq, cpu_mask, true);
+	}
+
+	k_spin_unlock(&plic_lock, key);
+
+	return 0;
 }
+#endif /* CONFIG_PLIC_PER_HART_CONTEXT */
 
 /**
  *
@@ -131,18 +268,22 @@ void riscv_plic_set_priority(uint32_t irq, uint32_t priority)
  */
 int riscv_plic_get_irq(void)
 {
-	return save_irq;
+	return save_irq[arch_curr_cpu()->id];
 }
 
 static void plic_irq_handler(const void *arg)
 {
+	unsigned int cpu = arch_curr_cpu()->id;
 	volatile struct plic_regs_t *regs =
-	    (volatile struct plic_regs_t *) PLIC_REG;
+	    plic_context_regs(PLIC_CPU_CONTEXT(cpu));
 
 	uint32_t irq;
 	struct _isr_table_entry *ite;
 
-	/* Get the IRQ number generating the interrupt */
+	/*
+	 * Get the IRQ number generating the interrupt. With per-hart
+	 * contexts this claims from the local hart's context only.
+	 */
 	irq = regs->claim_complete;
 
 	/*
@@ -151,7 +292,7 @@ static void plic_irq_handler(const void *arg)
 	 * as IRQ number held by the claim_complete register is
 	 * cleared upon read.
 	 */
-	save_irq = irq;
+	save_irq[cpu] = irq;
 
 	/*
 	 * If the IRQ is out of range, call z_irq_spurious.
@@ -170,7 +311,21 @@ static void plic_irq_handler(const void *arg)
 	 * Write to claim_complete register to indicate to
 	 * PLIC controller that the IRQ has been handled.
 	 */
-	regs->claim_complete = save_irq;
+	regs->claim_complete = save_irq[cpu];
+}
+
+static void plic_context_init(uint32_t ctx, uint32_t threshold)
+{
+	volatile uint32_t *en = plic_context_en(ctx);
+	int i;
+
+	/* Ensure that all interrupts are disabled initially */
+	for (i = 0; i < PLIC_EN_SIZE; i++) {
+		*en = 0U;
+		en++;
+	}
+
+	plic_context_regs(ctx)->threshold_prio = threshold;
 }
 
 /**
@@ -182,26 +337,42 @@ static int plic_init(const struct device *dev)
 {
 	ARG_UNUSED(dev);
 
-	volatile uint32_t *en = (volatile uint32_t *)PLIC_IRQ_EN;
 	volatile uint32_t *prio = (volatile uint32_t *)PLIC_PRIO;
-	volatile struct plic_regs_t *regs =
-	    (volatile struct plic_regs_t *)PLIC_REG;
 	int i;
 
-	/* Ensure that all interrupts are disabled initially */
-	for (i = 0; i < PLIC_EN_SIZE; i++) {
-		*en = 0U;
-		en++;
-	}
-
 	/* Set priority of each interrupt line to 0 initially */
 	for (i = 0; i < PLIC_IRQS; i++) {
 		*prio = 0U;
 		prio++;
 	}
 
+#ifdef CONFIG_PLIC_PER_HART_CONTEXT
+	/*
+	 * Contexts of all Zephyr harts are set up from the boot hart,
+	 * secondary harts only have to enable the external interrupt
+	 * in their own mie register.
+	 */
+	for (i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		plic_context_init(PLIC_CPU_CONTEXT(i), 0U);
+	}
+
+#if DT_INST_NODE_HAS_PROP(0, riscv_s_mode_contexts)
+	/* Zephyr runs in machine mode, keep supervisor contexts masked */
+	for (i = 0; i < ARRAY_SIZE(plic_s_contexts); i++) {
+		plic_context_init(plic_s_contexts[i], PLIC_MAX_PRIO);
+	}
+#endif
+
+#if DT_INST_NODE_HAS_PROP(0, zephyr_irq_affinity)
+	for (i = 0; i < ARRAY_SIZE(plic_static_affinity); i += 2) {
+		(void)riscv_plic_irq_set_affinity(plic_static_affinity[i],
+						  plic_static_affinity[i + 1]);
+	}
+#endif
+#else
 	/* Set threshold priority to 0 */
-	regs->threshold_prio = 0U;
+	plic_context_init(0, 0U);
+#endif /* CONFIG_PLIC_PER_HART_CONTEXT */
 
 	/* Setup IRQ handler for PLIC driver */
 	IRQ_CONNECT(RISCV_MACHINE_EXT_IRQ,
@@ -256,6 +256,36 @@ struct uart_ns16550_device_config {
 #endif
 };
 
+#ifdef CONFIG_UART_ASYNC_API
+/** Asynchronous transmission state */
+struct uart_ns16550_async_tx {
+	const uint8_t *buf;	/**< Buffer being sent, NULL if idle */
+	size_t len;		/**< Buffer length */
+	size_t pos;		/**< Bytes written to the FIFO */
+	struct k_timer timer;	/**< Transmission timeout */
+};
+
+/** Asynchronous reception state */
+struct uart_ns16550_async_rx {
+	uint8_t *buf;		/**< Current buffer, NULL if disabled */
+	size_t len;		/**< Current buffer length */
+	size_t pos;		/**< Bytes received in the current buffer */
+	size_t offset;		/**< Bytes reported with UART_RX_RDY */
+	uint8_t *next_buf;	/**< Buffer provided with uart_rx_buf_rsp() */
+	size_t next_len;	/**< Next buffer length */
+	int32_t timeout;	/**< Inactivity timeout in microseconds */
+	struct k_timer timer;	/**< Inactivity timer */
+};
+
+/** Asynchronous API state */
+struct uart_ns16550_async {
+	uart_callback_t cb;	/**< Event handler */
+	void *user_data;	/**< Event handler argument */
+	struct uart_ns16550_async_tx tx;
+	struct uart_ns16550_async_rx rx;
+};
+#endif /* CONFIG_UART_ASYNC_API */
+
 /** Device data structure */
 struct uart_ns16550_dev_data {
 #ifndef UART_NS16550_ACCESS_IOPORT
@@ -271,6 +301,10 @@ struct uart_ns16550_dev_data {
 	void *cb_data;	/**< Callback function arg */
 #endif
 
+#ifdef CONFIG_UART_ASYNC_API
+	struct uart_ns16550_async async;
+#endif
+
 #if UART_NS16550_DLF_ENABLED
 	uint8_t dlf;		/**< DLF value */
 #endif
@@ -299,6 +333,10 @@ static inline uint8_t reg_interval(const struct device *dev)
 
 static const struct uart_driver_api uart_ns16550_driver_api;
 
+#ifdef CONFIG_UART_ASYNC_API
+static void uart_ns16550_async_init(const struct device *dev);
+#endif
+
 static inline uintptr_t get_port(const struct device *dev)
 {
 #ifndef UART_NS16550_ACCESS_IOPORT
@@ -521,7 +559,11 @@ static int uart_ns16550_init(const struct device *dev)
 		return ret;
 	}
 
-#ifdef CONFIG_UART_INTERRUPT_DRIVEN
+#ifdef CONFIG_UART_ASYNC_API
+	uart_ns16550_async_init(dev);
+#endif
+
+#if defined(CONFIG_UART_INTERRUPT_DRIVEN) || defined(CONFIG_UART_ASYNC_API)
 	DEV_CFG(dev)->irq_config_func(dev);
 #endif
 
@@ -850,14 +892,388 @@ static void uart_ns16550_irq_callback_set(const struct device *dev,
 
 	dev_data->cb = cb;
 	dev_data->cb_data = cb_data;
+#ifdef CONFIG_UART_ASYNC_API
+	dev_data->async.cb = NULL;
+#endif
+
+	k_spin_unlock(&dev_data->lock, key);
+}
+
+#endif /* CONFIG_UART_INTERRUPT_DRIVEN */
+
+#ifdef CONFIG_UART_ASYNC_API
+
+/*
+ * The asynchronous API is implemented on the FIFO interrupts rather than
+ * DMA: each THRE interrupt refills up to fifo_size bytes of the buffer being
+ * sent, and each RX data interrupt drains the RX FIFO into the current
+ * buffer. Events are raised with the device lock released, so that the
+ * event handler can call back into the API.
+ */
+
+static void async_evt(const struct device *dev, struct uart_event *evt)
+{
+	struct uart_ns16550_async *async = &DEV_DATA(dev)->async;
+
+	if (async->cb) {
+		async->cb(dev, evt, async->user_data);
+	}
+}
+
+/* Write as much of the TX buffer as the FIFO takes. Called locked. */
+static void async_tx_fill(const struct device *dev)
+{
+	struct uart_ns16550_dev_data * const dev_data = DEV_DATA(dev);
+	struct uart_ns16550_async_tx *tx = &dev_data->async.tx;
+
+	/* The FIFO may hold bytes written with uart_poll_out() */
+	if ((INBYTE(LSR(dev)) & LSR_THRE) == 0) {
+		return;
+	}
+
+	for (int i = 0; (i < dev_data->fifo_size) && (tx->pos < tx->len);
+	     i++) {
+		OUTBYTE(THR(dev), tx->buf[tx->pos++]);
+	}
+}
+
+static void async_tx_isr(const struct device *dev)
+{
+	struct uart_ns16550_dev_data * const dev_data = DEV_DATA(dev);
+	struct uart_ns16550_async_tx *tx = &dev_data->async.tx;
+	struct uart_event evt = { .type = UART_TX_DONE };
+	k_spinlock_key_t key = k_spin_lock(&dev_data->lock);
+
+	if (tx->buf != NULL) {
+		async_tx_fill(dev);
+	}
+
+	/* The buffer is done with once its last byte is in the FIFO */
+	if ((tx->buf == NULL) || (tx->pos == tx->len)) {
+		OUTBYTE(IER(dev), INBYTE(IER(dev)) & (~IER_TBE));
+		evt.data.tx.buf = tx->buf;
+		evt.data.tx.len = tx->len;
+		tx->buf = NULL;
+		k_timer_stop(&tx->timer);
+	}
+
+	k_spin_unlock(&dev_data->lock, key);
+
+	if (evt.data.tx.buf != NULL) {
+		async_evt(dev, &evt);
+	}
+}
+
+static int uart_ns16550_callback_set(const struct device *dev,
+				     uart_callback_t callback,
+				     void *user_data)
+{
+	struct uart_ns16550_dev_data * const dev_data = DEV_DATA(dev);
+	k_spinlock_key_t key = k_spin_lock(&dev_data->lock);
+
+	dev_data->async.cb = callback;
+	dev_data->async.user_data = user_data;
+#ifdef CONFIG_UART_INTERRUPT_DRIVEN
+	dev_data->cb = NULL;
+#endif
+
+	k_spin_unlock(&dev_data->lock, key);
+
+	return 0;
+}
+
+static int uart_ns16550_tx(const struct device *dev, const uint8_t *buf,
+			   size_t len, int32_t timeout)
+{
+	struct uart_ns16550_dev_data * const dev_data = DEV_DATA(dev);
+	struct uart_ns16550_async_tx *tx = &dev_data->async.tx;
+	k_spinlock_key_t key = k_spin_lock(&dev_data->lock);
+
+	if (tx->buf != NULL) {
+		k_spin_unlock(&dev_data->lock, key);
+		return -EBUSY;
+	}
+
+	tx->buf = buf;
+	tx->len = len;
+	tx->pos = 0;
+
+	/* Armed before the transfer can complete, under the lock, so that
+	 * the completion always stops this timer and not a previous one
+	 */
+	if ((timeout != SYS_FOREVER_US) && (timeout != 0)) {
+		k_timer_start(&tx->timer, K_USEC(timeout), K_NO_WAIT);
+	}
+
+	/* Start right away, completion is left to the THRE interrupt */
+	async_tx_fill(dev);
+	OUTBYTE(IER(dev), INBYTE(IER(dev)) | IER_TBE);
+
+	k_spin_unlock(&dev_data->lock, key);
+
+	return 0;
+}
+
+static int uart_ns16550_tx_abort(const struct device *dev)
+{
+	struct uart_ns16550_dev_data * const dev_data = DEV_DATA(dev);
+	struct uart_ns16550_async_tx *tx = &dev_data->async.tx;
+	struct uart_event evt = { .type = UART_TX_ABORTED };
+	k_spinlock_key_t key = k_spin_lock(&dev_data->lock);
+
+	if (tx->buf == NULL) {
+		k_spin_unlock(&dev_data->lock, key);
+		return -EFAULT;
+	}
+
+	OUTBYTE(IER(dev), INBYTE(IER(dev)) & (~IER_TBE));
+	evt.data.tx.buf = tx->buf;
+	evt.data.tx.len = tx->pos;
+	tx->buf = NULL;
+	k_timer_stop(&tx->timer);
+
+	k_spin_unlock(&dev_data->lock, key);
+
+	async_evt(dev, &evt);
+
+	return 0;
+}
+
+static void async_tx_timeout(struct k_timer *timer)
+{
+	(void)uart_ns16550_tx_abort(k_timer_user_data_get(timer));
+}
+
+/* Report the bytes received since the last UART_RX_RDY. */
+static void async_rx_flush(const struct device *dev)
+{
+	struct uart_ns16550_dev_data * const dev_data = DEV_DATA(dev);
+	struct uart_ns16550_async_rx *rx = &dev_data->async.rx;
+	struct uart_event evt = { .type = UART_RX_RDY };
+	k_spinlock_key_t key = k_spin_lock(&dev_data->lock);
+
+	if (rx->buf != NULL) {
+		evt.data.rx.buf = rx->buf;
+		evt.data.rx.offset = rx->offset;
+		evt.data.rx.len = rx->pos - rx->offset;
+		rx->offset = rx->pos;
+	}
+
+	k_spin_unlock(&dev_data->lock, key);
+
+	if (evt.data.rx.len > 0) {
+		async_evt(dev, &evt);
+	}
+}
+
+static void async_rx_disable(const struct device *dev)
+{
+	struct uart_ns16550_dev_data * const dev_data = DEV_DATA(dev);
+	struct uart_ns16550_async_rx *rx = &dev_data->async.rx;
+	struct uart_event evt = { .type = UART_RX_BUF_RELEASED };
+	uint8_t *buf, *next_buf;
+	k_spinlock_key_t key;
+
+	k_timer_stop(&rx->timer);
+	async_rx_flush(dev);
 
+	key = k_spin_lock(&dev_data->lock);
+	OUTBYTE(IER(dev), INBYTE(IER(dev)) & ~(IER_RXRDY | IER_LSR));
+	buf = rx->buf;
+	next_buf = rx->next_buf;
+	rx->buf = NULL;
+	rx->next_buf = NULL;
 	k_spin_unlock(&dev_data->lock, key);
+
+	if (buf != NULL) {
+		evt.data.rx_buf.buf = buf;
+		async_evt(dev, &evt);
+	}
+
+	if (next_buf != NULL) {
+		evt.data.rx_buf.buf = next_buf;
+		async_evt(dev, &evt);
+	}
+
+	evt.type = UART_RX_DISABLED;
+	async_evt(dev, &evt);
 }
 
+/* Release the full buffer and carry on in the next one, if any. */
+static bool async_rx_next(const struct device *dev)
+{
+	struct uart_ns16550_dev_data * const dev_data = DEV_DATA(dev);
+	struct uart_ns16550_async_rx *rx = &dev_data->async.rx;
+	struct uart_event evt = { .type = UART_RX_BUF_RELEASED };
+	k_spinlock_key_t key;
+
+	async_rx_flush(dev);
+
+	key = k_spin_lock(&dev_data->lock);
+	if (rx->next_buf == NULL) {
+		k_spin_unlock(&dev_data->lock, key);
+		async_rx_disable(dev);
+		return false;
+	}
+
+	evt.data.rx_buf.buf = rx->buf;
+	rx->buf = rx->next_buf;
+	rx->len = rx->next_len;
+	rx->pos = 0;
+	rx->offset = 0;
+	rx->next_buf = NULL;
+	k_spin_unlock(&dev_data->lock, key);
+
+	async_evt(dev, &evt);
+
+	evt.type = UART_RX_BUF_REQUEST;
+	async_evt(dev, &evt);
+
+	return true;
+}
+
+static void async_rx_isr(const struct device *dev)
+{
+	struct uart_ns16550_dev_data * const dev_data = DEV_DATA(dev);
+	struct uart_ns16550_async_rx *rx = &dev_data->async.rx;
+	bool full;
+
+	do {
+		k_spinlock_key_t key = k_spin_lock(&dev_data->lock);
+		uint8_t lsr, err;
+
+		if (rx->buf == NULL) {
+			k_spin_unlock(&dev_data->lock, key);
+			return;
+		}
+
+		/* Error bits are cleared on read, so collect them all */
+		lsr = INBYTE(LSR(dev));
+		err = lsr & LSR_EOB_MASK;
+		while ((lsr & LSR_RXRDY) && (rx->pos < rx->len)) {
+			rx->buf[rx->pos++] = INBYTE(RDR(dev));
+			lsr = INBYTE(LSR(dev));
+			err |= lsr & LSR_EOB_MASK;
+		}
+		full = (rx->pos == rx->len);
+
+		k_spin_unlock(&dev_data->lock, key);
+
+		if (err != 0) {
+			/* LSR_OE..LSR_BI line up with UART_ERROR_OVERRUN..BREAK */
+			struct uart_event evt = {
+				.type = UART_RX_STOPPED,
+				.data.rx_stop.reason = err >> 1,
+			};
+
+			async_evt(dev, &evt);
+			async_rx_disable(dev);
+			return;
+		}
+	} while (full && async_rx_next(dev));
+
+	if (rx->timeout == 0) {
+		async_rx_flush(dev);
+	} else if (rx->timeout != SYS_FOREVER_US) {
+		k_timer_start(&rx->timer, K_USEC(rx->timeout), K_NO_WAIT);
+	}
+}
+
+static void async_rx_timeout(struct k_timer *timer)
+{
+	async_rx_flush(k_timer_user_data_get(timer));
+}
+
+static int uart_ns16550_rx_enable(const struct device *dev, uint8_t *buf,
+				  size_t len, int32_t timeout)
+{
+	struct uart_ns16550_dev_data * const dev_data = DEV_DATA(dev);
+	struct uart_ns16550_async_rx *rx = &dev_data->async.rx;
+	struct uart_event evt = { .type = UART_RX_BUF_REQUEST };
+	k_spinlock_key_t key = k_spin_lock(&dev_data->lock);
+
+	if (rx->buf != NULL) {
+		k_spin_unlock(&dev_data->lock, key);
+		return -EBUSY;
+	}
+
+	rx->buf = buf;
+	rx->len = len;
+	rx->pos = 0;
+	rx->offset = 0;
+	rx->next_buf = NULL;
+	rx->timeout = timeout;
+
+	OUTBYTE(IER(dev), INBYTE(IER(dev)) | IER_RXRDY | IER_LSR);
+
+	k_spin_unlock(&dev_data->lock, key);
+
+	async_evt(dev, &evt);
+
+	return 0;
+}
+
+static int uart_ns16550_rx_buf_rsp(const struct device *dev, uint8_t *buf,
+				   size_t len)
+{
+	struct uart_ns16550_dev_data * const dev_data = DEV_DATA(dev);
+	struct uart_ns16550_async_rx *rx = &dev_data->async.rx;
+	k_spinlock_key_t key = k_spin_lock(&dev_data->lock);
+	int ret = 0;
+
+	if (rx->buf == NULL) {
+		ret = -EACCES;
+	} else if (rx->next_buf != NULL) {
+		ret = -EBUSY;
+	} else {
+		rx->next_buf = buf;
+		rx->next_len = len;
+	}
+
+	k_spin_unlock(&dev_data->lock, key);
+
+	return ret;
+}
+
+static int uart_ns16550_rx_disable(const struct device *dev)
+{
+	if (DEV_DATA(dev)->async.rx.buf == NULL) {
+		return -EFAULT;
+	}
+
+	async_rx_disable(dev);
+
+	return 0;
+}
+
+static void uart_ns16550_async_isr(const struct device *dev)
+{
+	/* Reading IIR acknowledges a THRE interrupt that is not refilled */
+	(void)INBYTE(IIR(dev));
+
+	async_rx_isr(dev);
+	async_tx_isr(dev);
+}
+
+static void uart_ns16550_async_init(const struct device *dev)
+{
+	struct uart_ns16550_async *async = &DEV_DATA(dev)->async;
+
+	k_timer_init(&async->tx.timer, async_tx_timeout, NULL);
+	k_timer_user_data_set(&async->tx.timer, (void *)dev);
+	k_timer_init(&async->rx.timer, async_rx_timeout, NULL);
+	k_timer_user_data_set(&async->rx.timer, (void *)dev);
+}
+
+#endif /* CONFIG_UART_ASYNC_API */
+
+#if defined(CONFIG_UART_INTERRUPT_DRIVEN) || defined(CONFIG_UART_ASYNC_API)
+
 /**
  * @brief Interrupt service routine.
  *
- * This simply calls the callback function, if one exists.
+ * This calls the callback function of the interrupt driven API if one
+ * exists, or handles the transfers of the asynchronous API.
  *
  * @param arg Argument to ISR.
  *
@@ -867,9 +1283,17 @@ static void uart_ns16550_isr(const struct device *dev)
 {
 	struct uart_ns16550_dev_data * const dev_data = DEV_DATA(dev);
 
+#ifdef CONFIG_UART_INTERRUPT_DRIVEN
 	if (dev_data->cb) {
 		dev_data->cb(dev, dev_data->cb_data);
 	}
+#endif
+
+#ifdef CONFIG_UART_ASYNC_API
+	if (dev_data->async.cb) {
+		uart_ns16550_async_isr(dev);
+	}
+#endif
 
 #ifdef CONFIG_UART_NS16550_WA_ISR_REENABLE_INTERRUPT
 	uint8_t cached_ier = INBYTE(IER(dev));
@@ -879,7 +1303,7 @@ static void uart_ns16550_isr(const struct device *dev)
 #endif
 }
 
-#endif /* CONFIG_UART_INTERRUPT_DRIVEN */
+#endif /* CONFIG_UART_INTERRUPT_DRIVEN || CONFIG_UART_ASYNC_API */
 
 #ifdef CONFIG_UART_NS16550_LINE_CTRL
 
@@ -988,6 +1412,15 @@ static const struct uart_driver_api uart_ns16550_driver_api = {
 
 #endif
 
+#ifdef CONFIG_UART_ASYNC_API
+	.callback_set = uart_ns16550_callback_set,
+	.tx = uart_ns16550_tx,
+	.tx_abort = uart_ns16550_tx_abort,
+	.rx_enable = uart_ns16550_rx_enable,
+	.rx_buf_rsp = uart_ns16550_rx_buf_rsp,
+	.rx_disable = uart_ns16550_rx_disable,
+#endif
+
 #ifdef CONFIG_UART_NS16550_LINE_CTRL
 	.line_ctrl_set = uart_ns16550_line_ctrl_set,
 #endif
@@ -1043,7 +1476,7 @@ static const struct uart_driver_api uart_ns16550_driver_api = {
 	_CONCAT(DEV_CONFIG_REG_INIT_PCIE, DT_INST_ON_BUS(n, pcie))(n)
 #endif
 
-#ifdef CONFIG_UART_INTERRUPT_DRIVEN
+#if defined(CONFIG_UART_INTERRUPT_DRIVEN) || defined(CONFIG_UART_ASYNC_API)
 #define DEV_CONFIG_IRQ_FUNC_INIT(n) \
 	.irq_config_func = irq_config_func##n,
 #define UART_NS16550_IRQ_FUNC_DECLARE(n) \
@@ -1051,11 +1484,11 @@ static const struct uart_driver_api uart_ns16550_driver_api = {
 #define UART_NS16550_IRQ_FUNC_DEFINE(n) \
 	_CONCAT(UART_NS16550_IRQ_CONFIG_PCIE, DT_INST_ON_BUS(n, pcie))(n)
 #else
-/* !CONFIG_UART_INTERRUPT_DRIVEN */
+/* !CONFIG_UART_INTERRUPT_DRIVEN && !CONFIG_UART_ASYNC_API */
 #define DEV_CONFIG_IRQ_FUNC_INIT(n)
 #define UART_NS16550_IRQ_FUNC_DECLARE(n)
 #define UART_NS16550_IRQ_FUNC_DEFINE(n)
-#endif /* CONFIG_UART_INTERRUPT_DRIVEN */
+#endif /* CONFIG_UART_INTERRUPT_DRIVEN || CONFIG_UART_ASYNC_API */
 
 #if UART_NS16550_PCP_ENABLED
 #define DEV_CONFIG_PCP_INIT(n) .pcp = DT_INST_PROP_OR(n, pcp, 0),
@@ -7,6 +7,7 @@
 #include <sys_clock.h>
 #include <spinlock.h>
 #include <soc.h>
+#include <debug/sampling_profiler.h>
 
 #define CYC_PER_TICK ((uint32_t)((uint64_t)sys_clock_hw_cycles_per_sec()	\
 			      / (uint64_t)CONFIG_SYS_CLOCK_TICKS_PER_SEC))
@@ -19,28 +20,76 @@
 static struct k_spinlock lock;
 static uint64_t last_count;
 
-static void set_mtimecmp(uint64_t time)
-{
+/* Comparator value that never fires */
+#define MTIMECMP_PARKED UINT64_MAX
+
+/*
+ * The boot hart owns the system clock: it is the only one announcing
+ * ticks, so the tick path never contends on the lock with the other
+ * harts. Every hart also has local events, the end of its time slice on
+ * SMP and the next profiler sample, which go into its own comparator.
+ * The comparator of the boot hart carries whichever of its deadlines
+ * comes first.
+ */
 #if defined(CONFIG_SMP)
-    unsigned int hart_id;
+#define OWNER_CPU (CONFIG_HART_TO_USE - CONFIG_SMP_BASE_CPU)
+#else
+#define OWNER_CPU 0
+#endif
+
+/* Next announcement, protected by lock */
+static uint64_t announce_cmp = MTIMECMP_PARKED;
+
+struct hart_timer {
+	/* Protects the local events of a hart other than the boot hart,
+	 * the ones of the boot hart are protected by lock
+	 */
+	struct k_spinlock lock;
+	/* End of the time slice */
+	uint64_t local;
+	/* Next profiler sample */
+	uint64_t sample;
+};
 
-    __asm__ volatile("csrr %0, mhartid" : "=r" (hart_id));
+static struct hart_timer hart_timers[CONFIG_MP_NUM_CPUS] = {
+	[0 ... (CONFIG_MP_NUM_CPUS - 1)] = {
+		.local = MTIMECMP_PARKED,
+		.sample = MTIMECMP_PARKED,
+	},
+};
+
+#if defined(CONFIG_SAMPLING_PROFILER)
+/* Profiler sampling period in cycles, 0 when stopped */
+static uint32_t sample_period;
 #endif
 
-#ifdef CONFIG_64BIT
+static inline int current_cpu(void)
+{
 #if defined(CONFIG_SMP)
-//    *(volatile uint64_t *)RISCV_MTIMECMP_BY_HART(1) = time;
-    *(volatile uint64_t *)RISCV_MTIMECMP_BY_HART(hart_id) = time;
+	unsigned int hart_id;
+
+	__asm__ volatile("csrr %0, mhartid" : "=r" (hart_id));
+	return hart_id - CONFIG_SMP_BASE_CPU;
 #else
-	*(volatile uint64_t *)RISCV_MTIMECMP_BASE = time;
+	return 0;
 #endif
-#else
+}
+
+static void set_mtimecmp_hart(unsigned int hart_id, uint64_t time)
+{
 #if defined(CONFIG_SMP)
-    volatile uint32_t *r = (uint32_t *)RISCV_MTIMECMP_BY_HART(hart_id);
+	uintptr_t cmp = RISCV_MTIMECMP_BY_HART(hart_id);
 #else
-	volatile uint32_t *r = (uint32_t *)RISCV_MTIMECMP_BASE;
+	uintptr_t cmp = RISCV_MTIMECMP_BASE;
+
+	ARG_UNUSED(hart_id);
 #endif
 
+#ifdef CONFIG_64BIT
+	*(volatile uint64_t *)cmp = time;
+#else
+	volatile uint32_t *r = (uint32_t *)cmp;
+
 	/* Per spec, the RISC-V MTIME/MTIMECMP registers are 64 bit,
 	 * but are NOT internally latched for multiword transfers.  So
 	 * we have to be careful about sequencing to avoid triggering
@@ -53,6 +102,26 @@ static void set_mtimecmp(uint64_t time)
 #endif
 }
 
+/* Lock protecting the comparator of a CPU */
+static inline struct k_spinlock *cmp_lock(int cpu)
+{
+	return (cpu == OWNER_CPU) ? &lock : &hart_timers[cpu].lock;
+}
+
+/* Program the comparator of a CPU with its earliest deadline, with
+ * cmp_lock(cpu) held
+ */
+static void update_mtimecmp(int cpu)
+{
+	struct hart_timer *t = &hart_timers[cpu];
+	uint64_t cmp = MIN(t->local, t->sample);
+
+	if (cpu == OWNER_CPU) {
+		cmp = MIN(cmp, announce_cmp);
+	}
+	set_mtimecmp_hart(cpu + CONFIG_SMP_BASE_CPU, cmp);
+}
+
 static uint64_t mtime(void)
 {
 #ifdef CONFIG_64BIT
@@ -75,23 +144,69 @@ static void timer_isr(const void *arg)
 {
 	ARG_UNUSED(arg);
 
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	int cpu = current_cpu();
+	struct hart_timer *t = &hart_timers[cpu];
+	k_spinlock_key_t key = k_spin_lock(cmp_lock(cpu));
 	uint64_t now = mtime();
-	uint32_t dticks = (uint32_t)((now - last_count) / CYC_PER_TICK);
+	bool local = now >= t->local;
+	bool announce = (cpu == OWNER_CPU) && (now >= announce_cmp);
+	uint32_t dticks = 0U;
 
-	last_count += dticks * CYC_PER_TICK;
+	if (local) {
+		t->local = MTIMECMP_PARKED;
+	}
 
-	if (!TICKLESS) {
-		uint64_t next = last_count + CYC_PER_TICK;
+#if defined(CONFIG_SAMPLING_PROFILER)
+	bool sample = now >= t->sample;
 
-		if ((int64_t)(next - now) < MIN_DELAY) {
-			next += CYC_PER_TICK;
+	if (sample) {
+		/* Keep the sampling rate steady instead of drifting by the
+		 * interrupt latency, unless samples were missed entirely
+		 */
+		t->sample += sample_period;
+		if ((sample_period == 0U) || (t->sample <= now)) {
+			t->sample = (sample_period != 0U) ?
+				    now + sample_period : MTIMECMP_PARKED;
 		}
-		set_mtimecmp(next);
 	}
+#endif
 
-	k_spin_unlock(&lock, key);
-	sys_clock_announce(IS_ENABLED(CONFIG_TICKLESS_KERNEL) ? dticks : 1);
+	if (announce) {
+		dticks = (uint32_t)((now - last_count) / CYC_PER_TICK);
+		last_count += dticks * CYC_PER_TICK;
+
+		if (!TICKLESS) {
+			uint64_t next = last_count + CYC_PER_TICK;
+
+			if ((int64_t)(next - now) < MIN_DELAY) {
+				next += CYC_PER_TICK;
+			}
+			announce_cmp = next;
+		} else {
+			/* The interrupt stays pending as long as the
+			 * comparator is behind mtime; the announcement
+			 * below arms it again for the next timeout.
+			 */
+			announce_cmp = MTIMECMP_PARKED;
+		}
+	}
+
+	update_mtimecmp(cpu);
+	k_spin_unlock(cmp_lock(cpu), key);
+
+#if defined(CONFIG_SAMPLING_PROFILER)
+	if (sample) {
+		z_sampling_profiler_sample();
+	}
+#endif
+#if defined(CONFIG_SMP)
+	if (local) {
+		sys_clock_local_announce();
+	}
+#endif
+	if (announce) {
+		sys_clock_announce(TICKLESS ? dticks : 1);
+	}
 }
 
 int sys_clock_driver_init(const struct device *dev)
@@ -100,7 +215,8 @@ int sys_clock_driver_init(const struct device *dev)
 
 	IRQ_CONNECT(RISCV_MACHINE_TIMER_IRQ, 0, timer_isr, NULL, 0);
 	last_count = mtime();
-	set_mtimecmp(last_count + CYC_PER_TICK);
+	announce_cmp = last_count + CYC_PER_TICK;
+	update_mtimecmp(OWNER_CPU);
 	irq_enable(RISCV_MACHINE_TIMER_IRQ);
 	return 0;
 }
@@ -110,16 +226,6 @@ void sys_clock_set_timeout(int32_t ticks, bool idle)
 	ARG_UNUSED(idle);
 
 #if defined(CONFIG_TICKLESS_KERNEL)
-	/* RISCV has no idle handler yet, so if we try to spin on the
-	 * logic below to reset the comparator, we'll always bump it
-	 * forward to the "next tick" due to MIN_DELAY handling and
-	 * the interrupt will never fire!  Just rely on the fact that
-	 * the OS gave us the proper timeout already.
-	 */
-	if (idle) {
-		return;
-	}
-
 	ticks = ticks == K_TICKS_FOREVER ? MAX_TICKS : ticks;
 	ticks = CLAMP(ticks - 1, 0, (int32_t)MAX_TICKS);
 
@@ -140,7 +246,8 @@ void sys_clock_set_timeout(int32_t ticks, bool idle)
 		cyc += CYC_PER_TICK;
 	}
 
-	set_mtimecmp(cyc + last_count);
+	announce_cmp = cyc + last_count;
+	update_mtimecmp(OWNER_CPU);
 	k_spin_unlock(&lock, key);
 #endif
 }
@@ -163,16 +270,60 @@ uint32_t sys_clock_cycle_get_32(void)
 	return (uint32_t)mtime();
 }
 
+uint64_t sys_clock_cycle_get_64(void)
+{
+	return mtime();
+}
+
+
+#if defined(CONFIG_SMP)
+void sys_clock_set_local_timeout(int32_t ticks)
+{
+	int cpu = current_cpu();
+	uint64_t cmp = MTIMECMP_PARKED;
+
+	if (ticks != K_TICKS_FOREVER) {
+		cmp = mtime() + (uint64_t)MAX(ticks, 1) * CYC_PER_TICK;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(cmp_lock(cpu));
+
+	hart_timers[cpu].local = cmp;
+	update_mtimecmp(cpu);
+	k_spin_unlock(cmp_lock(cpu), key);
+}
 
 void smp_timer_init(void)
 {
     /*
      * Timer ISR is already registered for main hart so just need to configure
-     * and enable int on secondary harts.
-     *
-     * PMCS: Probably need guard on this but I'm not sure if we can do this at
-     * this stage of the start up?
+     * and enable int on secondary harts. Their comparator only carries their
+     * local events, ticks are only announced by the main hart.
      */
-    set_mtimecmp(last_count + CYC_PER_TICK);
+    int cpu = current_cpu();
+    k_spinlock_key_t key = k_spin_lock(cmp_lock(cpu));
+
+    hart_timers[cpu].local = MTIMECMP_PARKED;
+    update_mtimecmp(cpu);
+    k_spin_unlock(cmp_lock(cpu), key);
     irq_enable(RISCV_MACHINE_TIMER_IRQ);
 }
+#endif
+
+#if defined(CONFIG_SAMPLING_PROFILER)
+void z_sampling_profiler_timer_set(uint32_t period_cyc)
+{
+	uint64_t first = mtime() + period_cyc;
+
+	sample_period = period_cyc;
+
+	for (int cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+		k_spinlock_key_t key = k_spin_lock(cmp_lock(cpu));
+
+		hart_timers[cpu].sample = (period_cyc != 0U) ?
+					  first : MTIMECMP_PARKED;
+		update_mtimecmp(cpu);
+		k_spin_unlock(cmp_lock(cpu), key);
+	}
+}
+#endif
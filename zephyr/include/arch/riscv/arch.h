@@ -215,6 +215,7 @@
 #define MSTATUS_MPP_M   (3UL << 11)
 #define MSTATUS_MPIE_EN (1UL << 7)
 #define MSTATUS_FS_INIT (1UL << 13)
+#define MSTATUS_FS_CLEAN (1UL << 14)
 #define MSTATUS_FS_MASK ((1UL << 13) | (1UL << 14))
 
 
@@ -283,6 +284,18 @@ void arch_irq_enable(unsigned int irq);
 void arch_irq_disable(unsigned int irq);
 int arch_irq_is_enabled(unsigned int irq);
 void arch_irq_priority_set(unsigned int irq, unsigned int prio);
+#if defined(CONFIG_PLIC_PER_HART_CONTEXT)
+/**
+ * @brief Route an external interrupt to a set of CPUs
+ *
+ * @param irq Multi-level encoded IRQ number of a PLIC interrupt
+ * @param cpu_mask Bit N set allows Zephyr CPU N to take the interrupt
+ *
+ * @return 0 on success, -ENOTSUP for hart-local interrupts,
+ *         -EINVAL on an invalid IRQ or empty CPU mask
+ */
+int arch_irq_set_affinity(unsigned int irq, uint32_t cpu_mask);
+#endif
 void z_irq_spurious(const void *unused);
 
 #if defined(CONFIG_RISCV_HAS_PLIC)
@@ -354,6 +367,13 @@ static inline uint32_t arch_k_cycle_get_32(void)
 	return sys_clock_cycle_get_32();
 }
 
+extern uint64_t sys_clock_cycle_get_64(void);
+
+static inline uint64_t arch_k_cycle_get_64(void)
+{
+	return sys_clock_cycle_get_64();
+}
+
 extern void arch_switch_riscv(void *switch_to, void **switched_from);
 static inline void arch_switch(void *switch_to, void **switched_from)
 {
@@ -101,6 +101,10 @@
  */
 struct _callee_saved {
 	ulong_t sp;	/* Stack pointer, (x2 register) */
+	ulong_t ra;	/* Return address, where arch_switch() resumes */
+#ifdef CONFIG_THREAD_LOCAL_STORAGE
+	ulong_t tp;	/* Thread pointer */
+#endif
 
 	ulong_t s0;	/* saved register/frame pointer */
 	ulong_t s1;	/* saved register */
@@ -133,9 +137,26 @@ struct _callee_saved {
 };
 typedef struct _callee_saved _callee_saved_t;
 
+#ifdef CONFIG_RISCV_LAZY_FPU_SHARING
+/*
+ * Complete floating-point context, saved when a thread is switched out
+ * with a dirty FPU and restored on its first FP instruction after it is
+ * switched back in.
+ */
+struct z_riscv_fp_context {
+	RV_FP_TYPE fregs[32];	/* f0 to f31 */
+	ulong_t fcsr;		/* Control and status register */
+};
+typedef struct z_riscv_fp_context z_riscv_fp_context_t;
+#endif
+
 struct _thread_arch {
 	uint32_t swap_return_value; /* Return value of z_swap() */
 
+#ifdef CONFIG_RISCV_LAZY_FPU_SHARING
+	struct z_riscv_fp_context fp;
+#endif
+
 #ifdef CONFIG_PMP_STACK_GUARD
 	ulong_t s_pmpcfg[PMP_CFG_CSR_NUM_FOR_STACK_GUARD];
 	ulong_t s_pmpaddr[PMP_REGION_NUM_FOR_STACK_GUARD];
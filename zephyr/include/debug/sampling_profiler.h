@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2021 Microchip Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_DEBUG_SAMPLING_PROFILER_H_
+#define ZEPHYR_INCLUDE_DEBUG_SAMPLING_PROFILER_H_
+
+#include <zephyr/types.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup sampling_profiler Sampling profiler
+ *  @brief Statistical profiler based on a periodic interrupt
+ *
+ *  While running, the profiler interrupts every CPU at a fixed period
+ *  and records the interrupted program counter, along with the
+ *  increments of the configured hardware event counters, into a ring
+ *  buffer of that CPU.
+ *  @{
+ */
+
+/** @brief One sample */
+struct sampling_profiler_record {
+	/** Interrupted program counter */
+	uintptr_t pc;
+#if defined(CONFIG_SAMPLING_PROFILER_EVENTS) && \
+	(CONFIG_SAMPLING_PROFILER_EVENTS > 0)
+	/** Event counter increments since the previous sample */
+	uint32_t events[CONFIG_SAMPLING_PROFILER_EVENTS];
+#endif
+};
+
+/** @brief Start sampling on all CPUs
+ *
+ *  Records taken by a previous run and not read yet are kept.
+ *
+ *  @param period_us Sampling period in microseconds.
+ *
+ *  @retval 0 on success.
+ *  @retval -EINVAL if the period is zero.
+ *  @retval -EALREADY if the profiler is already running.
+ */
+int sampling_profiler_start(uint32_t period_us);
+
+/** @brief Stop sampling on all CPUs */
+void sampling_profiler_stop(void);
+
+/** @brief Read and remove the oldest records of a CPU
+ *
+ *  May be called while the profiler is running.
+ *
+ *  @param cpu CPU whose records are read.
+ *  @param records Destination of the records.
+ *  @param count Maximum number of records to read.
+ *
+ *  @return Number of records read.
+ */
+size_t sampling_profiler_read(int cpu, struct sampling_profiler_record *records,
+			      size_t count);
+
+/** @brief Number of samples of a CPU lost because its buffer was full
+ *
+ *  @param cpu CPU whose counter is returned.
+ *
+ *  @return Number of dropped samples since the profiler was started.
+ */
+uint32_t sampling_profiler_dropped(int cpu);
+
+/** @brief Print and remove all records
+ *
+ *  The output is parsed by scripts/profiling/flat_profile.py.
+ */
+void sampling_profiler_dump(void);
+
+/** @} */
+
+/* Interfaces between the profiler, the timer driver and the architecture */
+
+/**
+ * @brief Set the sampling period of the timer driver
+ *
+ * @param period_cyc Sampling period in hardware cycles, 0 to stop.
+ */
+void z_sampling_profiler_timer_set(uint32_t period_cyc);
+
+/**
+ * @brief Sample the interrupted context
+ *
+ * Called by the timer driver from the sampling interrupt, implemented by
+ * the architecture.
+ */
+void z_sampling_profiler_sample(void);
+
+/**
+ * @brief Store a sample of the current CPU
+ *
+ * @param pc Interrupted program counter.
+ * @param events Event counter increments, CONFIG_SAMPLING_PROFILER_EVENTS
+ *		 of them.
+ */
+void z_sampling_profiler_record(uintptr_t pc, const uint32_t *events);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DEBUG_SAMPLING_PROFILER_H_ */
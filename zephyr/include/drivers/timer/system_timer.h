@@ -120,6 +120,37 @@ extern void sys_clock_idle_exit(void);
  */
 extern void sys_clock_announce(int32_t ticks);
 
+/**
+ * @brief 64-bit hardware cycle counter
+ *
+ * With CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER, returns the full width of
+ * the counter read by sys_clock_cycle_get_32(), in the same units.
+ *
+ * @return Current value of the hardware cycle counter
+ */
+extern uint64_t sys_clock_cycle_get_64(void);
+
+/**
+ * @brief Set a local timer event on the current CPU
+ *
+ * With CONFIG_SYSTEM_CLOCK_LOCAL_TIMEOUT, the kernel uses this to
+ * program the end of the time slice of the current CPU. The driver
+ * calls sys_clock_local_announce() on this CPU once the specified
+ * number of ticks has elapsed. Each CPU has a single local event, a
+ * new call replaces the previous one.
+ *
+ * @param ticks Timeout in ticks, or K_TICKS_FOREVER to cancel the event
+ */
+extern void sys_clock_set_local_timeout(int32_t ticks);
+
+/**
+ * @brief Announce the local timer event of the current CPU
+ *
+ * Called by timer drivers with CONFIG_SYSTEM_CLOCK_LOCAL_TIMEOUT when
+ * the event set with sys_clock_set_local_timeout() expires.
+ */
+extern void sys_clock_local_announce(void);
+
 /**
  * @brief Ticks elapsed since last sys_clock_announce() call
  *
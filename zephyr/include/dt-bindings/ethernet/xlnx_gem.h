@@ -18,6 +18,10 @@
  * divider /32 is to be used for a 100 MHz LPD LSBUS clock.
  */
 #define XLNX_GEM_MDC_DIVIDER_48  3 /* LPD_LSBUS_CLK  80 - 120 MHz */
+#define XLNX_GEM_MDC_DIVIDER_64  4 /* LPD_LSBUS_CLK 120 - 160 MHz */
+#define XLNX_GEM_MDC_DIVIDER_96  5 /* LPD_LSBUS_CLK 160 - 240 MHz */
+#define XLNX_GEM_MDC_DIVIDER_128 6 /* LPD_LSBUS_CLK 240 - 320 MHz */
+#define XLNX_GEM_MDC_DIVIDER_224 7 /* LPD_LSBUS_CLK 320 - 540 MHz */
 
 /* Link speed values */
 #define XLNX_GEM_LINK_SPEED_10MBIT  1
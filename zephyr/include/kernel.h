@@ -1269,7 +1269,7 @@ const char *k_thread_state_str(k_tid_t thread_id);
 struct k_timer {
 	/*
 	 * _timeout structure must be first here if we want to use
-	 * dynamic timer allocation. timeout.node is used in the double-linked
+	 * dynamic timer allocation. The timeout queue links are used in the
 	 * list of free timers
 	 */
 	struct _timeout timeout;
@@ -1297,7 +1297,6 @@ struct k_timer {
 #define Z_TIMER_INITIALIZER(obj, expiry, stop) \
 	{ \
 	.timeout = { \
-		.node = {},\
 		.fn = z_timer_expiration_handler, \
 		.dticks = 0, \
 	}, \
@@ -1639,6 +1638,26 @@ static inline uint32_t k_cycle_get_32(void)
 	return arch_k_cycle_get_32();
 }
 
+/**
+ * @brief Read the 64-bit hardware clock.
+ *
+ * This routine returns the current time in 64 bits, as measured by the
+ * system's hardware clock, if available.
+ *
+ * @see CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER
+ *
+ * @return Current hardware clock up-counter (in cycles).
+ */
+static inline uint64_t k_cycle_get_64(void)
+{
+#ifdef CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER
+	return arch_k_cycle_get_64();
+#else
+	__ASSERT(0, "64-bit cycle counter not available on this platform");
+	return 0;
+#endif
+}
+
 /**
  * @}
  */
@@ -4911,6 +4930,11 @@ struct k_mem_slab {
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	uint32_t max_used;
 #endif
+#ifdef CONFIG_MEM_SLAB_LOCKFREE
+	/* Replace free_list and num_used, see kernel/mem_slab.c */
+	uint64_t lf_head;
+	atomic_t lf_used;
+#endif
 
 };
 
@@ -5038,7 +5062,11 @@ extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_LOCKFREE
+	return (uint32_t)atomic_get(&slab->lf_used);
+#else
 	return slab->num_used;
+#endif
 }
 
 /**
@@ -5073,7 +5101,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->num_blocks - slab->num_used;
+	return slab->num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /** @} */
@@ -5083,12 +5111,31 @@ static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
  * @{
  */
 
+#ifdef CONFIG_HEAP_CPU_CACHE
+/* Per-CPU cache of free small blocks of a k_heap, one list per size
+ * class, linked through the first word of the blocks
+ */
+struct z_heap_cpu_cache {
+	struct k_spinlock lock;
+	void *free[CONFIG_HEAP_CPU_CACHE_CLASSES];
+	uint16_t count[CONFIG_HEAP_CPU_CACHE_CLASSES];
+	uint32_t alloc_hits;
+	uint32_t alloc_misses;
+	uint32_t free_hits;
+};
+#endif
+
 /* kernel synchronized heap struct */
 
 struct k_heap {
 	struct sys_heap heap;
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
+#ifdef CONFIG_HEAP_CPU_CACHE
+	uint32_t lock_count;
+	atomic_t waiters;
+	struct z_heap_cpu_cache cpu_cache[CONFIG_MP_NUM_CPUS];
+#endif
 };
 
 /**
@@ -5163,6 +5210,43 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes,
  */
 void k_heap_free(struct k_heap *h, void *mem);
 
+/** Statistics of the per-CPU caches of a k_heap, summed over all CPUs */
+struct k_heap_cache_stats {
+	/** Allocations served by a per-CPU cache */
+	uint32_t alloc_hits;
+	/** Cacheable allocations that had to refill a per-CPU cache */
+	uint32_t alloc_misses;
+	/** Frees kept in a per-CPU cache */
+	uint32_t free_hits;
+	/** Acquisitions of the lock of the heap itself */
+	uint32_t heap_locks;
+};
+
+/**
+ * @brief Get the statistics of the per-CPU caches of a k_heap
+ *
+ * Available with CONFIG_HEAP_CPU_CACHE.  The counters wrap around and
+ * are not reset, so rates are obtained from the difference of two
+ * samples.
+ *
+ * @param h Heap to query
+ * @param stats Filled with the counters summed over all CPUs
+ */
+void k_heap_cache_stats_get(struct k_heap *h, struct k_heap_cache_stats *stats);
+
+/**
+ * @brief Return the blocks held in the per-CPU caches to a k_heap
+ *
+ * Available with CONFIG_HEAP_CPU_CACHE.  Blocks kept in the caches can
+ * only serve allocations of their size class, which fragments the
+ * heap for other sizes.  Allocations that fail flush the caches
+ * before giving up or blocking, so this is only needed to get an
+ * accurate picture of the heap, e.g. before inspecting it.
+ *
+ * @param h Heap to flush
+ */
+void k_heap_cache_flush(struct k_heap *h);
+
 /* Hand-calculated minimum heap sizes needed to return a successful
  * 1-byte allocation.  See details in lib/os/heap.[ch]
  */
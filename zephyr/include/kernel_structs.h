@@ -92,6 +92,11 @@ struct _ready_q {
 #elif defined(CONFIG_SCHED_MULTIQ)
 	struct _priq_mq runq;
 #endif
+
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	/* best thread of runq, for peer CPUs to compare against */
+	struct k_thread *best;
+#endif
 };
 
 typedef struct _ready_q _ready_q_t;
@@ -109,7 +114,8 @@ struct _cpu {
 	/* one assigned idle thread per CPU */
 	struct k_thread *idle_thread;
 
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || \
+	defined(CONFIG_SCHED_PER_CPU_RUNQ)
 	struct _ready_q ready_q;
 #endif
 
@@ -130,6 +136,11 @@ struct _cpu {
 	uint8_t swap_ok;
 #endif
 
+#ifdef CONFIG_SCHED_IPI_STATS
+	/* number of scheduler IPIs taken by this CPU */
+	uint32_t ipi_count;
+#endif
+
 	/* Per CPU architecture specifics */
 	struct _cpu_arch arch;
 };
@@ -180,6 +191,39 @@ extern struct z_kernel _kernel;
  * another SMP CPU.
  */
 bool z_smp_cpu_mobile(void);
+
+#ifdef CONFIG_SCHED_IPI_STATS
+/* Number of scheduler IPIs taken by the given CPU since boot */
+uint32_t z_smp_ipi_count_get(int cpu);
+#endif
+
+#ifdef CONFIG_SMP_GLOBAL_LOCK_STATS
+/* Use of the irq_lock() global lock by one call site */
+struct z_smp_global_lock_site {
+	/* Return address of the irq_lock() call */
+	void *site;
+	/* Outermost acquisitions, and how many of them had to wait */
+	uint32_t count;
+	uint32_t contended;
+	/* Time the lock was held, in k_cycle_get_32() cycles */
+	uint64_t hold_cycles;
+	uint32_t max_hold_cycles;
+};
+
+/* Copy up to max call sites into sites, returns how many were copied.
+ * Acquisitions from sites that did not fit in the table are added to
+ * *untracked if it is not NULL.
+ */
+int z_smp_global_lock_stats_get(struct z_smp_global_lock_site *sites,
+				int max, uint32_t *untracked);
+
+/* Forget all call sites */
+void z_smp_global_lock_stats_reset(void);
+
+/* Print the call sites, busiest first */
+void z_smp_global_lock_stats_print(void);
+#endif
+
 /* PMCS ToDo: removed cpu mobile for the moment as it creates circular reference in SMP...
  *#define _current_cpu ({ __ASSERT_NO_MSG(!z_smp_cpu_mobile()); \
  *			arch_curr_cpu(); })
@@ -221,10 +265,24 @@ struct _timeout;
 typedef void (*_timeout_func_t)(struct _timeout *t);
 
 struct _timeout {
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+	/* Pairing heap links: first child, next sibling, and previous
+	 * sibling or parent (NULL when not queued).
+	 */
+	struct _timeout *child;
+	struct _timeout *next;
+	struct _timeout *prev;
+	/* Orders timeouts with the same expiry */
+	uint32_t seq;
+#else
 	sys_dnode_t node;
+#endif
 	_timeout_func_t fn;
 #ifdef CONFIG_TIMEOUT_64BIT
-	/* Can't use k_ticks_t for header dependency reasons */
+	/* Can't use k_ticks_t for header dependency reasons.  Absolute
+	 * expiry tick with CONFIG_TIMEOUT_QUEUE_SCALABLE, ticks from the
+	 * previous timeout in the queue otherwise.
+	 */
 	int64_t dticks;
 #else
 	int32_t dticks;
@@ -29,6 +29,16 @@ void z_log_dropped(void);
  */
 uint32_t z_log_dropped_read_and_clear(void);
 
+/** @brief Read and clear the drop indications counter of a CPU.
+ *
+ * Only available with CONFIG_LOG_PERCPU_BUFFERS.
+ *
+ * @param cpu CPU index.
+ *
+ * @return Count of messages dropped on @p cpu.
+ */
+uint32_t z_log_dropped_cpu_read_and_clear(unsigned int cpu);
+
 /** @brief Check if there are any pending drop notifications.
  *
  * @retval true Pending unreported drop indications.
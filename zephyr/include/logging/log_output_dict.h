@@ -47,6 +47,27 @@ struct log_dict_output_dropped_msg_t {
 	uint16_t num_dropped_messages;
 } __packed;
 
+/** First sync byte of a dictionary based log record frame. */
+#define LOG_DICT_FRAME_SYNC0 0xA5U
+
+/** Second sync byte of a dictionary based log record frame. */
+#define LOG_DICT_FRAME_SYNC1 0x5AU
+
+/** Initial value of the frame check sequence (CRC-16/CCITT-FALSE). */
+#define LOG_DICT_FRAME_FCS_INIT 0xFFFFU
+
+/**
+ * Header of one dictionary based log record frame, used if
+ * CONFIG_LOG_DICTIONARY_FRAMED is enabled.
+ *
+ * It is followed by @p len bytes of record and by the 16-bit frame check
+ * sequence, computed over @p len and the record.
+ */
+struct log_dict_output_frame_hdr_t {
+	uint8_t sync[2];
+	uint16_t len;
+} __packed;
+
 /** @brief Process log messages v2 for dictionary-based logging.
  *
  * Function is using provided context with the buffer and output function to
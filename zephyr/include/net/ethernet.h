@@ -164,6 +164,11 @@ enum ethernet_hw_caps {
 
 	/** TXTIME supported */
 	ETHERNET_TXTIME			= BIT(19),
+
+	/** TCP segmentation offload supported, requires TX checksum
+	 * offloading to be supported as well
+	 */
+	ETHERNET_HW_TX_TSO		= BIT(20),
 };
 
 /** @cond INTERNAL_HIDDEN */
@@ -1964,6 +1964,18 @@ bool net_if_need_calc_rx_checksum(struct net_if *iface);
  */
 bool net_if_need_calc_tx_checksum(struct net_if *iface);
 
+/**
+ * @brief Check if the network device can split a TCP packet carrying more
+ * than one segment of data into segments of a given size when sending it.
+ * The TCP checksums of the resulting segments are then computed by the
+ * network device as well.
+ *
+ * @param iface Network interface
+ *
+ * @return True if TCP segmentation offload can be used, false otherwise.
+ */
+bool net_if_is_tcp_tso_supported(struct net_if *iface);
+
 /**
  * @brief Get interface according to index
  *
@@ -192,6 +192,11 @@ struct net_pkt {
 				 * defined(CONFIG_NET_ETHERNET_BRIDGE).
 				 */
 
+	uint8_t chksum_done : 1; /* For incoming packet: the network device
+				  * has verified the IP header and transport
+				  * checksums, the IP stack can skip them.
+				  */
+
 	union {
 		/* IPv6 hop limit or IPv4 ttl for this network packet.
 		 * The value is shared between IPv6 and IPv4.
@@ -214,6 +219,19 @@ struct net_pkt {
 	 */
 	uint8_t priority;
 
+	/* For outgoing packet: offset of the checksum field within the
+	 * transport header if the IP header and transport checksums are
+	 * left to the network device, 0 if they are filled in already.
+	 */
+	uint8_t tx_chksum_offset;
+
+#if defined(CONFIG_NET_TCP_TSO)
+	/* For outgoing TCP packet: segment size the network device splits
+	 * the payload into, 0 if the packet is sent as is.
+	 */
+	uint16_t tso_mss;
+#endif
+
 #if defined(CONFIG_NET_VLAN)
 	/* VLAN TCI (Tag Control Information). This contains the Priority
 	 * Code Point (PCP), Drop Eligible Indicator (DEI) and VLAN
@@ -368,6 +386,17 @@ static inline void net_pkt_set_l2_bridged(struct net_pkt *pkt, bool is_l2_bridge
 	}
 }
 
+static inline bool net_pkt_is_chksum_done(struct net_pkt *pkt)
+{
+	return !!(pkt->chksum_done);
+}
+
+static inline void net_pkt_set_chksum_done(struct net_pkt *pkt,
+					   bool is_chksum_done)
+{
+	pkt->chksum_done = is_chksum_done;
+}
+
 static inline uint8_t net_pkt_ip_hdr_len(struct net_pkt *pkt)
 {
 	return pkt->ip_hdr_len;
@@ -635,6 +664,51 @@ static inline uint16_t net_pkt_ip_opts_len(struct net_pkt *pkt)
 #endif
 }
 
+static inline uint8_t net_pkt_tx_chksum_offset(struct net_pkt *pkt)
+{
+	return pkt->tx_chksum_offset;
+}
+
+static inline void net_pkt_set_tx_chksum_offset(struct net_pkt *pkt,
+						uint8_t offset)
+{
+	pkt->tx_chksum_offset = offset;
+}
+
+static inline bool net_pkt_is_tx_chksum_offload(struct net_pkt *pkt)
+{
+	return pkt->tx_chksum_offset != 0U;
+}
+
+/* Offset of the transport header, where the checksum left to the network
+ * device starts, from the start of the IP header.
+ */
+static inline uint16_t net_pkt_tx_chksum_start(struct net_pkt *pkt)
+{
+	return net_pkt_ip_hdr_len(pkt) + net_pkt_ip_opts_len(pkt);
+}
+
+static inline uint16_t net_pkt_tso_mss(struct net_pkt *pkt)
+{
+#if defined(CONFIG_NET_TCP_TSO)
+	return pkt->tso_mss;
+#else
+	ARG_UNUSED(pkt);
+
+	return 0;
+#endif
+}
+
+static inline void net_pkt_set_tso_mss(struct net_pkt *pkt, uint16_t mss)
+{
+#if defined(CONFIG_NET_TCP_TSO)
+	pkt->tso_mss = mss;
+#else
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(mss);
+#endif
+}
+
 #if defined(CONFIG_NET_IPV6_FRAGMENT)
 static inline uint16_t net_pkt_ipv6_fragment_start(struct net_pkt *pkt)
 {
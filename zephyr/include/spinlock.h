@@ -28,8 +28,16 @@ struct z_spinlock_key {
  */
 struct k_spinlock {
 #ifdef CONFIG_SMP
+#ifdef CONFIG_SPINLOCK_TICKET
+	/* Next ticket handed out, and ticket currently holding the
+	 * lock.  The lock is free when they are equal.
+	 */
+	atomic_t next;
+	atomic_t owner;
+#else
 	atomic_t locked;
 #endif
+#endif
 
 #ifdef CONFIG_SPIN_VALIDATE
 	/* Stores the thread that holds the lock with the locking CPU
@@ -133,9 +141,17 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 #endif
 
 #ifdef CONFIG_SMP
+#ifdef CONFIG_SPINLOCK_TICKET
+	atomic_val_t ticket = atomic_inc(&l->next);
+
+	/* Only the holder moves owner, so waiters just watch it */
+	while (atomic_get(&l->owner) != ticket) {
+	}
+#else
 	while (!atomic_cas(&l->locked, 0, 1)) {
 	}
 #endif
+#endif
 
 #ifdef CONFIG_SPIN_VALIDATE
 	z_spin_lock_set_owner(l);
@@ -143,6 +159,29 @@ static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
 	return k;
 }
 
+#ifdef CONFIG_SMP
+/* Internal function: hands the lock over, interrupts are untouched */
+static ALWAYS_INLINE void z_spin_unlock_smp(struct k_spinlock *l)
+{
+#ifdef CONFIG_SPINLOCK_TICKET
+	/* Only the holder writes owner, so a plain increment would do,
+	 * but the atomic one also orders the critical section before
+	 * the hand-over.
+	 */
+	(void)atomic_inc(&l->owner);
+#else
+	/* Strictly we don't need atomic_clear() here (which is an
+	 * exchange operation that returns the old value).  We are always
+	 * setting a zero and (because we hold the lock) know the existing
+	 * state won't change due to a race.  But some architectures need
+	 * a memory barrier when used like this, and we don't have a
+	 * Zephyr framework for that.
+	 */
+	atomic_clear(&l->locked);
+#endif
+}
+#endif
+
 /**
  * @brief Unlock a spin lock
  *
@@ -173,14 +212,7 @@ static ALWAYS_INLINE void k_spin_unlock(struct k_spinlock *l,
 #endif
 
 #ifdef CONFIG_SMP
-	/* Strictly we don't need atomic_clear() here (which is an
-	 * exchange operation that returns the old value).  We are always
-	 * setting a zero and (because we hold the lock) know the existing
-	 * state won't change due to a race.  But some architectures need
-	 * a memory barrier when used like this, and we don't have a
-	 * Zephyr framework for that.
-	 */
-	atomic_clear(&l->locked);
+	z_spin_unlock_smp(l);
 #endif
 	arch_irq_unlock(key.key);
 }
@@ -195,7 +227,7 @@ static ALWAYS_INLINE void k_spin_release(struct k_spinlock *l)
 	__ASSERT(z_spin_unlock_valid(l), "Not my spinlock %p", l);
 #endif
 #ifdef CONFIG_SMP
-	atomic_clear(&l->locked);
+	z_spin_unlock_smp(l);
 #endif
 }
 
@@ -389,6 +389,17 @@ static inline struct _cpu *arch_curr_cpu(void);
  * This will invoke z_sched_ipi() on other CPUs in the system.
  */
 void arch_sched_ipi(void);
+
+#ifdef CONFIG_ARCH_HAS_DIRECTED_IPIS
+/**
+ * Send an interrupt to a set of CPUs
+ *
+ * This will invoke z_sched_ipi() on the CPUs selected in the mask.
+ *
+ * @param cpu_bitmap Mask of the CPUs to interrupt, bit N is CPU N
+ */
+void arch_sched_directed_ipi(uint32_t cpu_bitmap);
+#endif /* CONFIG_ARCH_HAS_DIRECTED_IPIS */
 #endif /* CONFIG_SMP */
 
 /** @} */
@@ -80,32 +80,52 @@ typedef uint32_t (*mpsc_pbuf_get_wlen)(const union mpsc_pbuf_generic *packet);
 typedef void (*mpsc_pbuf_notify_drop)(const struct mpsc_pbuf_buffer *buffer,
 				      const union mpsc_pbuf_generic *packet);
 
+/* Producers and the consumer update their indices in separate cache
+ * lines, when configured
+ */
+#if defined(CONFIG_MPSC_PBUF_CACHE_LINE_SIZE) && \
+	(CONFIG_MPSC_PBUF_CACHE_LINE_SIZE > 0)
+#define Z_MPSC_PBUF_ALIGN __aligned(CONFIG_MPSC_PBUF_CACHE_LINE_SIZE)
+#else
+#define Z_MPSC_PBUF_ALIGN
+#endif
+
 /** @brief MPSC packet buffer structure. */
 struct mpsc_pbuf_buffer {
 	/** Temporary write index. */
-	uint32_t tmp_wr_idx;
+	uint32_t tmp_wr_idx Z_MPSC_PBUF_ALIGN;
 
 	/** Write index. */
 	uint32_t wr_idx;
 
 	/** Temporary read index. */
-	uint32_t tmp_rd_idx;
+	uint32_t tmp_rd_idx Z_MPSC_PBUF_ALIGN;
 
 	/** Read index. */
 	uint32_t rd_idx;
 
-	/** Flags. */
-	uint32_t flags;
-
 	/** Lock. */
 	struct k_spinlock lock;
 
+	/** Flags. */
+	uint32_t flags Z_MPSC_PBUF_ALIGN;
+
 	/** User callback called whenever packet is dropped. */
 	mpsc_pbuf_notify_drop notify_drop;
 
 	/** Callback for getting packet length. */
 	mpsc_pbuf_get_wlen get_wlen;
 
+#ifdef CONFIG_MPSC_PBUF_LOCKFREE
+	/* Set while a producer holds the lock to update the write indices */
+	atomic_t wr_locked;
+
+	/* Set by each CPU while it reserves space without the lock */
+	struct {
+		atomic_t reserving;
+	} Z_MPSC_PBUF_ALIGN cpu[CONFIG_MP_NUM_CPUS];
+#endif
+
 	/* Buffer. */
 	uint32_t *buf;
 
@@ -237,6 +257,117 @@ void mpsc_pbuf_free(struct mpsc_pbuf_buffer *buffer,
  */
 bool mpsc_pbuf_is_pending(struct mpsc_pbuf_buffer *buffer);
 
+/** @brief Callback prototype for ordering packets of per-CPU buffers.
+ *
+ * @param a Packet.
+ *
+ * @param b Packet.
+ *
+ * @return True if @p a must be consumed before @p b.
+ */
+typedef bool (*mpsc_pbuf_is_older)(const union mpsc_pbuf_generic *a,
+				   const union mpsc_pbuf_generic *b);
+
+/** @brief Per-CPU packet buffer.
+ *
+ * Set of packet buffers, one per CPU, so that producers on different CPUs
+ * never contend. Producers use the buffer of the CPU they run on. The
+ * consumer merges the buffers: it claims the oldest head packet according
+ * to a user callback, or takes the buffers in turn when there is none.
+ */
+struct mpsc_pbuf_percpu {
+	/** Buffer of each CPU. */
+	struct mpsc_pbuf_buffer bufs[CONFIG_MP_NUM_CPUS];
+
+	/* Packets claimed from each buffer and not returned yet. */
+	const union mpsc_pbuf_generic *heads[CONFIG_MP_NUM_CPUS];
+
+	/* Merge order, or null for round robin. */
+	mpsc_pbuf_is_older is_older;
+
+	/* Next buffer in round robin. */
+	uint32_t next;
+};
+
+/** @brief Initialize a per-CPU packet buffer.
+ *
+ * The memory given in @p config is split evenly between CPUs, the other
+ * settings apply to the buffer of each CPU.  Index wrapping is cheaper if
+ * the size of each piece is a power of two.
+ *
+ * @param pcbuf Per-CPU buffer.
+ *
+ * @param config Configuration.
+ *
+ * @param is_older Merge order, null for round robin.
+ */
+void mpsc_pbuf_percpu_init(struct mpsc_pbuf_percpu *pcbuf,
+			   const struct mpsc_pbuf_buffer_config *config,
+			   mpsc_pbuf_is_older is_older);
+
+/** @brief Get the buffer of the current CPU.
+ *
+ * The caller may migrate to another CPU afterwards, which is harmless as
+ * each buffer accepts producers from any CPU.
+ *
+ * @param pcbuf Per-CPU buffer.
+ *
+ * @return Buffer to produce to with the mpsc_pbuf_* functions.
+ */
+struct mpsc_pbuf_buffer *mpsc_pbuf_percpu_get(struct mpsc_pbuf_percpu *pcbuf);
+
+/** @brief Get the CPU index of a buffer, e.g. in the drop callback.
+ *
+ * @param pcbuf Per-CPU buffer.
+ *
+ * @param buffer Buffer of one of the CPUs.
+ *
+ * @return CPU index.
+ */
+static inline uint32_t mpsc_pbuf_percpu_idx(const struct mpsc_pbuf_percpu *pcbuf,
+					    const struct mpsc_pbuf_buffer *buffer)
+{
+	return buffer - pcbuf->bufs;
+}
+
+/** @brief Find the buffer holding a packet.
+ *
+ * @param pcbuf Per-CPU buffer.
+ *
+ * @param packet Packet allocated or claimed from @p pcbuf.
+ *
+ * @return Buffer of the packet, for @ref mpsc_pbuf_commit.
+ */
+struct mpsc_pbuf_buffer *mpsc_pbuf_percpu_find(struct mpsc_pbuf_percpu *pcbuf,
+					       const union mpsc_pbuf_generic *packet);
+
+/** @brief Claim the next pending packet of any CPU.
+ *
+ * @param pcbuf Per-CPU buffer.
+ *
+ * @return Pointer to the claimed packet or null if none available.
+ */
+const union mpsc_pbuf_generic *
+mpsc_pbuf_percpu_claim(struct mpsc_pbuf_percpu *pcbuf);
+
+/** @brief Free a packet claimed with @ref mpsc_pbuf_percpu_claim.
+ *
+ * @param pcbuf Per-CPU buffer.
+ *
+ * @param packet Packet.
+ */
+void mpsc_pbuf_percpu_free(struct mpsc_pbuf_percpu *pcbuf,
+			   union mpsc_pbuf_generic *packet);
+
+/** @brief Check if any CPU has a message pending.
+ *
+ * @param pcbuf Per-CPU buffer.
+ *
+ * @retval true if pending.
+ * @retval false if no message is pending.
+ */
+bool mpsc_pbuf_percpu_is_pending(struct mpsc_pbuf_percpu *pcbuf);
+
 /**
  * @}
  */
@@ -11,6 +11,7 @@
 /* Zephyr Pooled Parallel Preemptible Priority-based Work Queues */
 
 struct k_p4wq_work;
+struct k_p4wq_batch;
 
 /**
  * P4 Queue handler callback
@@ -40,11 +41,39 @@ struct k_p4wq_work {
 	};
 	struct k_thread *thread;
 	struct k_p4wq *queue;
+	struct k_p4wq_batch *batch;
+};
+
+/**
+ * @brief P4 Queue Batch
+ *
+ * Tracks the completion of the work items submitted together with
+ * k_p4wq_submit_batch(), see k_p4wq_wait_all().
+ */
+struct k_p4wq_batch {
+	/* reserved for implementation */
+	atomic_t remaining;
+	struct k_sem done_sem;
 };
 
 #define K_P4WQ_QUEUE_PER_THREAD		BIT(0)
 #define K_P4WQ_DELAYED_START		BIT(1)
 #define K_P4WQ_USER_CPU_MASK		BIT(2)
+#define K_P4WQ_WORK_STEALING		BIT(3)
+
+/**
+ * @brief Work-stealing P4 Queue thread deque
+ *
+ * Work items queued for one thread of a K_P4WQ_WORK_STEALING queue.
+ * The thread runs the most recently queued item first, idle threads
+ * steal the oldest half of the items of another thread.
+ */
+struct k_p4wq_deque {
+	struct k_spinlock lock;
+	sys_dlist_t items;
+	uint32_t count;
+	struct k_thread *thread;
+};
 
 /**
  * @brief P4 Queue
@@ -73,6 +102,19 @@ struct k_p4wq {
 
 	/* K_P4WQ_* flags above */
 	uint32_t flags;
+
+#ifdef CONFIG_P4WQ_WORK_STEALING
+	/* One deque per thread of a K_P4WQ_WORK_STEALING queue, which
+	 * holds its items there instead of in the tree above
+	 */
+	struct k_p4wq_deque *deques;
+	uint32_t num_deques;
+	atomic_t next_deque;
+
+	/* Items in the deques, and threads pended on waitq for some */
+	atomic_t pending;
+	atomic_t idle;
+#endif
 };
 
 struct k_p4wq_initparam {
@@ -81,6 +123,7 @@ struct k_p4wq_initparam {
 	struct k_p4wq *queue;
 	struct k_thread *threads;
 	struct z_thread_stack_element *stacks;
+	struct k_p4wq_deque *deques;
 	uint32_t flags;
 };
 
@@ -137,6 +180,44 @@ struct k_p4wq_initparam {
 		.flags = K_P4WQ_QUEUE_PER_THREAD | flg,			\
 	}
 
+/**
+ * @brief Statically initialize a work-stealing P4 Work Queue
+ *
+ * Like K_P4WQ_DEFINE(), but each thread of the pool keeps its own
+ * deque of work items.  Items submitted by a handler are queued on the
+ * deque of the thread running it, other items are spread over the
+ * deques in turn.  Threads run the items of their deque newest first,
+ * and steal half of the oldest items of another thread when theirs is
+ * empty.  Items run at their priority and deadline, but queued items
+ * are not ordered by them: use these queues for many small items of
+ * similar importance, typically split with k_p4wq_submit_batch().
+ *
+ * With CONFIG_SCHED_CPU_MASK, thread i is pinned to CPU i modulo
+ * CONFIG_MP_NUM_CPUS, unless the K_P4WQ_USER_CPU_MASK flag is given
+ * and k_p4wq_enable_static_thread() is used instead.
+ *
+ * @param name Symbol name of the struct k_p4wq that will be defined
+ * @param n_threads Number of threads in the work queue pool
+ * @param stack_sz Requested stack size of each thread, in bytes
+ * @param flg Flags
+ */
+#define K_P4WQ_WORK_STEALING_DEFINE(name, n_threads, stack_sz, flg)	\
+	static K_THREAD_STACK_ARRAY_DEFINE(_p4stacks_##name,		\
+					   n_threads, stack_sz);	\
+	static struct k_thread _p4threads_##name[n_threads];		\
+	static struct k_p4wq_deque _p4deques_##name[n_threads];	\
+	static struct k_p4wq name;					\
+	static const STRUCT_SECTION_ITERABLE(k_p4wq_initparam,		\
+					     _init_##name) = {		\
+		.num = n_threads,					\
+		.stack_size = stack_sz,					\
+		.threads = _p4threads_##name,				\
+		.stacks = &(_p4stacks_##name[0][0]),			\
+		.deques = _p4deques_##name,				\
+		.queue = &name,						\
+		.flags = K_P4WQ_WORK_STEALING | flg,			\
+	}
+
 /**
  * @brief Initialize P4 Queue
  *
@@ -204,6 +285,43 @@ bool k_p4wq_cancel(struct k_p4wq *queue, struct k_p4wq_work *item);
  */
 int k_p4wq_wait(struct k_p4wq_work *work, k_timeout_t timeout);
 
+/**
+ * @brief Submit a batch of work items to a P4 queue
+ *
+ * Submits each item as per k_p4wq_submit(), and tracks their
+ * completion in @a batch for k_p4wq_wait_all().  The batch object
+ * needs no initialization and must not be reused before the wait
+ * returns.  Called from a handler, this forks the work of the handler.
+ *
+ * @param queue P4 Queue to which to submit
+ * @param batch Batch tracking the items
+ * @param items Work items to be submitted
+ * @param num Number of items
+ */
+void k_p4wq_submit_batch(struct k_p4wq *queue, struct k_p4wq_batch *batch,
+			 struct k_p4wq_work **items, size_t num);
+
+/**
+ * @brief Wait for all the items of a batch
+ *
+ * Waits until every item submitted with the batch has run or has been
+ * cancelled, after which the caller owns the items again.  Called from
+ * a handler running on a work-stealing queue, the thread runs queued
+ * items of the queue while it waits, so that nested fork/join does not
+ * need a thread per level.  On other queues, a handler waiting here
+ * holds its thread.
+ *
+ * @param queue P4 Queue to which the batch was submitted
+ * @param batch Batch to wait for
+ * @param timeout Waiting period
+ *
+ * @retval 0 All items completed
+ * @retval -EBUSY Returned without waiting
+ * @retval -EAGAIN Waiting period timed out
+ */
+int k_p4wq_wait_all(struct k_p4wq *queue, struct k_p4wq_batch *batch,
+		    k_timeout_t timeout);
+
 void k_p4wq_enable_static_thread(struct k_p4wq *queue, struct k_thread *thread,
 				 uint32_t cpu_mask);
 
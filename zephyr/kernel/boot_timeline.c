@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2021 Microchip Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Boot timeline
+ *
+ * Cycle stamps of the boot milestones, printed just before main().
+ */
+
+#include <kernel.h>
+#include <init.h>
+#include <sys/printk.h>
+#include <kernel_internal.h>
+
+/* A zero stamp means that the event has not been reached (yet) */
+static uint32_t event_stamps[Z_BOOT_EVENT_COUNT];
+
+#ifdef CONFIG_SMP
+static uint32_t cpu_stamps[CONFIG_MP_NUM_CPUS];
+#endif
+
+/* Events in the order they happen during boot */
+static const struct {
+	int event;
+	const char *name;
+} events[] = {
+	{ Z_BOOT_EVENT_CSTART, "z_cstart" },
+	{ _SYS_INIT_LEVEL_PRE_KERNEL_1, "PRE_KERNEL_1" },
+	{ _SYS_INIT_LEVEL_PRE_KERNEL_2, "PRE_KERNEL_2" },
+	{ _SYS_INIT_LEVEL_POST_KERNEL, "POST_KERNEL" },
+	{ _SYS_INIT_LEVEL_APPLICATION, "APPLICATION" },
+#ifdef CONFIG_SMP
+	{ _SYS_INIT_LEVEL_SMP, "SMP" },
+#endif
+	{ Z_BOOT_EVENT_MAIN, "main" },
+};
+
+static inline uint32_t stamp(void)
+{
+	uint32_t now = k_cycle_get_32();
+
+	/* Keep zero for "not reached" */
+	return (now != 0U) ? now : 1U;
+}
+
+void z_boot_timeline_mark(int event)
+{
+	__ASSERT_NO_MSG(event >= 0 && event < Z_BOOT_EVENT_COUNT);
+
+	event_stamps[event] = stamp();
+}
+
+void z_boot_timeline_cpu(int cpu)
+{
+#ifdef CONFIG_SMP
+	__ASSERT_NO_MSG(cpu >= 0 && cpu < CONFIG_MP_NUM_CPUS);
+
+	cpu_stamps[cpu] = stamp();
+#else
+	ARG_UNUSED(cpu);
+#endif
+}
+
+void z_boot_timeline_print(void)
+{
+	uint32_t start = event_stamps[Z_BOOT_EVENT_CSTART];
+	uint32_t prev = start;
+
+	printk("Boot timeline (cycles, z_cstart at %u):\n", start);
+
+	for (int i = 0; i < ARRAY_SIZE(events); i++) {
+		uint32_t t = event_stamps[events[i].event];
+
+		if (t == 0U) {
+			continue;
+		}
+		printk("  %-14s +%-10u (+%u)\n", events[i].name,
+		       t - start, t - prev);
+		prev = t;
+	}
+
+#ifdef CONFIG_SMP
+	for (int cpu = 1; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+		/* Harts released in parallel may still be on their way */
+		uint32_t t = *(volatile uint32_t *)&cpu_stamps[cpu];
+
+		if (t == 0U) {
+			printk("  cpu %d          not up yet\n", cpu);
+		} else {
+			printk("  cpu %d          +%u\n", cpu, t - start);
+		}
+	}
+#endif
+}
@@ -8,6 +8,7 @@
 #include <device.h>
 #include <sys/atomic.h>
 #include <syscall_handler.h>
+#include <kernel_internal.h>
 
 extern const struct init_entry __init_start[];
 extern const struct init_entry __init_PRE_KERNEL_1_start[];
@@ -67,6 +68,8 @@ void z_sys_init_run_level(int32_t level)
 	};
 	const struct init_entry *entry;
 
+	z_boot_timeline_mark(level);
+
 	for (entry = levels[level]; entry < levels[level+1]; entry++) {
 		const struct device *dev = entry->dev;
 		int rc = entry->init(dev);
@@ -141,6 +141,33 @@ extern void z_smp_init(void);
 extern void smp_timer_init(void);
 #endif
 
+#ifdef CONFIG_BOOT_TIMELINE
+/* Boot timeline events, after the init levels which are recorded by
+ * their _SYS_INIT_LEVEL_* value
+ */
+#define Z_BOOT_EVENT_CSTART	5
+#define Z_BOOT_EVENT_MAIN	6
+#define Z_BOOT_EVENT_COUNT	7
+
+extern void z_boot_timeline_mark(int event);
+extern void z_boot_timeline_cpu(int cpu);
+extern void z_boot_timeline_print(void);
+#else
+static inline void z_boot_timeline_mark(int event)
+{
+	ARG_UNUSED(event);
+}
+
+static inline void z_boot_timeline_cpu(int cpu)
+{
+	ARG_UNUSED(cpu);
+}
+
+static inline void z_boot_timeline_print(void)
+{
+}
+#endif
+
 extern void z_early_boot_rand_get(uint8_t *buf, size_t length);
 
 #if CONFIG_STACK_POINTER_RANDOM
@@ -225,6 +225,9 @@ static void bg_thread_main(void *unused1, void *unused2, void *unused3)
 
 	extern void main(void);
 
+	z_boot_timeline_mark(Z_BOOT_EVENT_MAIN);
+	z_boot_timeline_print();
+
 	main();
 
 	/* Mark nonessenrial since main() has no more work to do */
@@ -413,6 +416,8 @@ FUNC_NORETURN void z_cstart(void)
 	/* gcov hook needed to get the coverage report.*/
 	gcov_static_init();
 
+	z_boot_timeline_mark(Z_BOOT_EVENT_CSTART);
+
 	LOG_CORE_INIT();
 
 	/* perform any architecture-specific initialization */
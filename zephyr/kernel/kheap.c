@@ -9,11 +9,261 @@
 #include <wait_q.h>
 #include <init.h>
 #include <linker/linker-defs.h>
+#include <string.h>
+
+#ifdef CONFIG_HEAP_CPU_CACHE
+/*
+ * Per-CPU caches of small blocks.  Freed blocks of up to
+ * CLASS_SIZE(CACHE_CLASSES - 1) bytes are kept in a list of the freeing
+ * CPU, per power of two size class, and allocations of those sizes are
+ * served from the list of the allocating CPU.  Empty lists are
+ * refilled, and full ones spilled, CACHE_BATCH blocks at a time so
+ * that the heap lock, which all CPUs share, is taken once per batch.
+ *
+ * Each cache has its own lock, normally only taken by its CPU.  The
+ * heap lock is never taken with a cache lock held, but cache locks are
+ * taken with the heap lock held to flush the caches.
+ */
+#define CACHE_CLASSES CONFIG_HEAP_CPU_CACHE_CLASSES
+#define CACHE_DEPTH CONFIG_HEAP_CPU_CACHE_DEPTH
+#define CACHE_BATCH MAX(CACHE_DEPTH / 2, 1)
+#define CLASS_SIZE(c) ((size_t)16 << (c))
+
+static inline void *block_next(void *mem)
+{
+	return *(void **)mem;
+}
+
+static inline void block_set_next(void *mem, void *next)
+{
+	*(void **)mem = next;
+}
+
+static struct z_heap_cpu_cache *cpu_cache(struct k_heap *h)
+{
+	/* Stale if the thread migrates before locking the cache, which
+	 * only costs locality: every cache has its own lock
+	 */
+	return &h->cpu_cache[arch_curr_cpu()->id];
+}
+
+static int alloc_class(size_t align, size_t bytes)
+{
+	int c = 0;
+
+	/* sys_heap_alloc() aligns on at least a pointer */
+	if (align > sizeof(void *) || bytes == 0U ||
+	    bytes > CLASS_SIZE(CACHE_CLASSES - 1)) {
+		return -1;
+	}
+
+	while (CLASS_SIZE(c) < bytes) {
+		c++;
+	}
+
+	return c;
+}
+
+/* Blocks of any origin are cached by their usable size, so that every
+ * block of a class can serve all of its allocations
+ */
+static int free_class(struct k_heap *h, void *mem)
+{
+	size_t size = sys_heap_usable_size(&h->heap, mem);
+	int c = 0;
+
+	if (size < CLASS_SIZE(0) || size >= CLASS_SIZE(CACHE_CLASSES)) {
+		return -1;
+	}
+
+	while (CLASS_SIZE(c + 1) <= size) {
+		c++;
+	}
+
+	return c;
+}
+
+/* Return all cached blocks to the heap, with the heap lock held */
+static int cache_flush_locked(struct k_heap *h)
+{
+	int n = 0;
+
+	for (int cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+		struct z_heap_cpu_cache *cache = &h->cpu_cache[cpu];
+		k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+		for (int c = 0; c < CACHE_CLASSES; c++) {
+			while (cache->free[c] != NULL) {
+				void *mem = cache->free[c];
+
+				cache->free[c] = block_next(mem);
+				sys_heap_free(&h->heap, mem);
+				n++;
+			}
+			cache->count[c] = 0U;
+		}
+		k_spin_unlock(&cache->lock, key);
+	}
+
+	return n;
+}
+
+static void *cache_alloc(struct k_heap *h, size_t align, size_t bytes)
+{
+	int c = alloc_class(align, bytes);
+	struct z_heap_cpu_cache *cache;
+	k_spinlock_key_t key;
+	void *mem, *head = NULL, *tail = NULL;
+	int n;
+
+	if (c < 0) {
+		return NULL;
+	}
+
+	cache = cpu_cache(h);
+	key = k_spin_lock(&cache->lock);
+	mem = cache->free[c];
+	if (mem != NULL) {
+		cache->free[c] = block_next(mem);
+		cache->count[c]--;
+		cache->alloc_hits++;
+		k_spin_unlock(&cache->lock, key);
+		return mem;
+	}
+	cache->alloc_misses++;
+	k_spin_unlock(&cache->lock, key);
+
+	/* Refill: one block for the caller, the rest for the cache */
+	key = k_spin_lock(&h->lock);
+	h->lock_count++;
+	for (n = 0; n < CACHE_BATCH; n++) {
+		void *blk = sys_heap_alloc(&h->heap, CLASS_SIZE(c));
+
+		if (blk == NULL) {
+			break;
+		}
+		block_set_next(blk, head);
+		head = blk;
+		if (tail == NULL) {
+			tail = blk;
+		}
+	}
+	k_spin_unlock(&h->lock, key);
+
+	if (head == NULL) {
+		return NULL;
+	}
+
+	mem = head;
+	head = block_next(head);
+	if (head != NULL) {
+		cache = cpu_cache(h);
+		key = k_spin_lock(&cache->lock);
+		block_set_next(tail, cache->free[c]);
+		cache->free[c] = head;
+		cache->count[c] += n - 1;
+		k_spin_unlock(&cache->lock, key);
+	}
+
+	return mem;
+}
+
+static bool cache_free(struct k_heap *h, void *mem)
+{
+	int c = free_class(h, mem);
+	struct z_heap_cpu_cache *cache;
+	k_spinlock_key_t key;
+	void *spill = NULL;
+
+	/* Waiters only see memory freed to the heap itself */
+	if (c < 0 || atomic_get(&h->waiters) != 0) {
+		return false;
+	}
+
+	cache = cpu_cache(h);
+	key = k_spin_lock(&cache->lock);
+	block_set_next(mem, cache->free[c]);
+	cache->free[c] = mem;
+	cache->free_hits++;
+	if (++cache->count[c] >= CACHE_DEPTH) {
+		void *last = cache->free[c];
+
+		/* Spill the oldest blocks, keeping the most recently freed
+		 * ones, which are likely still in the data cache
+		 */
+		for (int i = 1; i < cache->count[c] - CACHE_BATCH; i++) {
+			last = block_next(last);
+		}
+		spill = block_next(last);
+		block_set_next(last, NULL);
+		cache->count[c] -= CACHE_BATCH;
+	}
+	k_spin_unlock(&cache->lock, key);
+
+	if (spill != NULL) {
+		key = k_spin_lock(&h->lock);
+		h->lock_count++;
+		while (spill != NULL) {
+			void *next = block_next(spill);
+
+			sys_heap_free(&h->heap, spill);
+			spill = next;
+		}
+		k_spin_unlock(&h->lock, key);
+	}
+
+	/* A thread may have started to wait since the check above.  It
+	 * flushed the caches after announcing itself, possibly before this
+	 * block was added: flush them again and wake it up.
+	 */
+	if (atomic_get(&h->waiters) != 0) {
+		k_heap_cache_flush(h);
+	}
+
+	return true;
+}
+
+void k_heap_cache_stats_get(struct k_heap *h, struct k_heap_cache_stats *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&h->lock);
+
+	(void)memset(stats, 0, sizeof(*stats));
+	stats->heap_locks = h->lock_count;
+	for (int cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+		struct z_heap_cpu_cache *cache = &h->cpu_cache[cpu];
+		k_spinlock_key_t cache_key = k_spin_lock(&cache->lock);
+
+		stats->alloc_hits += cache->alloc_hits;
+		stats->alloc_misses += cache->alloc_misses;
+		stats->free_hits += cache->free_hits;
+		k_spin_unlock(&cache->lock, cache_key);
+	}
+	k_spin_unlock(&h->lock, key);
+}
+
+void k_heap_cache_flush(struct k_heap *h)
+{
+	k_spinlock_key_t key = k_spin_lock(&h->lock);
+
+	h->lock_count++;
+	if (cache_flush_locked(h) != 0 && IS_ENABLED(CONFIG_MULTITHREADING) &&
+	    z_unpend_all(&h->wait_q) != 0) {
+		z_reschedule(&h->lock, key);
+	} else {
+		k_spin_unlock(&h->lock, key);
+	}
+}
+#endif /* CONFIG_HEAP_CPU_CACHE */
 
 void k_heap_init(struct k_heap *h, void *mem, size_t bytes)
 {
 	z_waitq_init(&h->wait_q);
 	sys_heap_init(&h->heap, mem, bytes);
+#ifdef CONFIG_HEAP_CPU_CACHE
+	h->lock_count = 0U;
+	(void)atomic_set(&h->waiters, 0);
+	(void)memset(h->cpu_cache, 0, sizeof(h->cpu_cache));
+#endif
 
 	SYS_PORT_TRACING_OBJ_INIT(k_heap, h);
 }
@@ -66,17 +316,37 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 {
 	int64_t now, end = sys_clock_timeout_end_calc(timeout);
 	void *ret = NULL;
-	k_spinlock_key_t key = k_spin_lock(&h->lock);
+	k_spinlock_key_t key;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, h, timeout);
 
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
 
+#ifdef CONFIG_HEAP_CPU_CACHE
+	ret = cache_alloc(h, align, bytes);
+	if (ret != NULL) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, h, timeout, ret);
+		return ret;
+	}
+#endif
+
+	key = k_spin_lock(&h->lock);
+#ifdef CONFIG_HEAP_CPU_CACHE
+	h->lock_count++;
+#endif
+
 	bool blocked_alloc = false;
 
 	while (ret == NULL) {
 		ret = sys_heap_aligned_alloc(&h->heap, align, bytes);
 
+#ifdef CONFIG_HEAP_CPU_CACHE
+		/* Cached blocks may be what is missing */
+		if (ret == NULL && cache_flush_locked(h) != 0) {
+			continue;
+		}
+#endif
+
 		now = sys_clock_tick_get();
 		if (!IS_ENABLED(CONFIG_MULTITHREADING) ||
 		    (ret != NULL) || ((end - now) <= 0)) {
@@ -87,6 +357,16 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 			blocked_alloc = true;
 
 			SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_heap, aligned_alloc, h, timeout);
+
+#ifdef CONFIG_HEAP_CPU_CACHE
+			/* Frees bypass the caches from now on, blocks
+			 * cached before that are flushed once more
+			 */
+			(void)atomic_inc(&h->waiters);
+			if (cache_flush_locked(h) != 0) {
+				continue;
+			}
+#endif
 		} else {
 			/**
 			 * @todo	Trace attempt to avoid empty trace segments
@@ -96,8 +376,17 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 		(void) z_pend_curr(&h->lock, key, &h->wait_q,
 				   K_TICKS(end - now));
 		key = k_spin_lock(&h->lock);
+#ifdef CONFIG_HEAP_CPU_CACHE
+		h->lock_count++;
+#endif
 	}
 
+#ifdef CONFIG_HEAP_CPU_CACHE
+	if (blocked_alloc) {
+		(void)atomic_dec(&h->waiters);
+	}
+#endif
+
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, h, timeout, ret);
 
 	k_spin_unlock(&h->lock, key);
@@ -117,7 +406,19 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout)
 
 void k_heap_free(struct k_heap *h, void *mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&h->lock);
+	k_spinlock_key_t key;
+
+#ifdef CONFIG_HEAP_CPU_CACHE
+	if (mem != NULL && cache_free(h, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, h);
+		return;
+	}
+#endif
+
+	key = k_spin_lock(&h->lock);
+#ifdef CONFIG_HEAP_CPU_CACHE
+	h->lock_count++;
+#endif
 
 	sys_heap_free(&h->heap, mem);
 
@@ -15,6 +15,114 @@
 #include <init.h>
 #include <sys/check.h>
 
+#ifdef CONFIG_MEM_SLAB_LOCKFREE
+/*
+ * Lock-free free list.  The head word packs:
+ *
+ * - the offset in the buffer of the first free block, with its low bit
+ *   set so that 0 means an empty list;
+ * - a tag incremented by every update, so that a head read before
+ *   other CPUs popped and pushed the same block back never compares
+ *   equal (ABA);
+ * - a flag set while threads pend on the empty slab, which sends frees
+ *   to the locked path that hands blocks to them.
+ *
+ * Free blocks hold the encoded offset of the next one in their first
+ * 32 bits.  The flag is only set and cleared with the lock held.
+ */
+#define LF_OFFSET_MASK 0xffffffffULL
+#define LF_TAG_ONE (1ULL << 32)
+#define LF_TAG_MASK (0x7fffffffULL << 32)
+#define LF_WAITERS (1ULL << 63)
+
+static inline uint64_t lf_load(struct k_mem_slab *slab)
+{
+	return __atomic_load_n(&slab->lf_head, __ATOMIC_ACQUIRE);
+}
+
+static inline bool lf_cas(struct k_mem_slab *slab, uint64_t old, uint64_t new)
+{
+	return __atomic_compare_exchange_n(&slab->lf_head, &old, new, false,
+					   __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+}
+
+static inline uint64_t lf_next_tag(uint64_t head)
+{
+	return (head + LF_TAG_ONE) & LF_TAG_MASK;
+}
+
+static inline uint32_t lf_encode(struct k_mem_slab *slab, char *mem)
+{
+	return (uint32_t)(mem - slab->buffer) | 1U;
+}
+
+static inline char *lf_decode(struct k_mem_slab *slab, uint64_t head)
+{
+	return slab->buffer + ((uint32_t)head & ~1U);
+}
+
+/* Take the first free block, NULL if there is none */
+static char *lf_pop(struct k_mem_slab *slab)
+{
+	uint64_t head, next;
+	char *mem;
+
+	do {
+		head = lf_load(slab);
+		if ((head & LF_OFFSET_MASK) == 0U) {
+			return NULL;
+		}
+		mem = lf_decode(slab, head);
+
+		/* The block may be taken and written by another CPU
+		 * meanwhile, the tag then fails the exchange
+		 */
+		next = lf_next_tag(head) | *(volatile uint32_t *)mem;
+	} while (!lf_cas(slab, head, next));
+
+	atomic_inc(&slab->lf_used);
+
+	return mem;
+}
+
+/* Return a block, unless threads pend for one */
+static bool lf_push(struct k_mem_slab *slab, char *mem)
+{
+	uint64_t head;
+
+	do {
+		head = lf_load(slab);
+		if ((head & LF_WAITERS) != 0U) {
+			return false;
+		}
+		*(volatile uint32_t *)mem = (uint32_t)head;
+	} while (!lf_cas(slab, head, lf_next_tag(head) | lf_encode(slab, mem)));
+
+	atomic_dec(&slab->lf_used);
+
+	return true;
+}
+
+/* With the lock held: clear the waiters flag, returning mem if not NULL */
+static void lf_clear_waiters(struct k_mem_slab *slab, char *mem)
+{
+	uint64_t head, next;
+
+	do {
+		head = lf_load(slab);
+		next = lf_next_tag(head) | (head & LF_OFFSET_MASK);
+		if (mem != NULL) {
+			*(volatile uint32_t *)mem = (uint32_t)head;
+			next = lf_next_tag(head) | lf_encode(slab, mem);
+		}
+	} while (!lf_cas(slab, head, next));
+
+	if (mem != NULL) {
+		atomic_dec(&slab->lf_used);
+	}
+}
+#endif /* CONFIG_MEM_SLAB_LOCKFREE */
+
 /**
  * @brief Initialize kernel memory slab subsystem.
  *
@@ -37,11 +145,28 @@ static int create_free_list(struct k_mem_slab *slab)
 	slab->free_list = NULL;
 	p = slab->buffer;
 
+#ifdef CONFIG_MEM_SLAB_LOCKFREE
+	uint32_t next = 0U;
+
+	/* Offsets are kept on 32 bits */
+	CHECKIF((uint64_t)slab->block_size * slab->num_blocks > UINT32_MAX) {
+		return -EINVAL;
+	}
+
+	for (j = 0U; j < slab->num_blocks; j++) {
+		*(uint32_t *)p = next;
+		next = lf_encode(slab, p);
+		p += slab->block_size;
+	}
+	slab->lf_head = next;
+	atomic_clear(&slab->lf_used);
+#else
 	for (j = 0U; j < slab->num_blocks; j++) {
 		*(char **)p = slab->free_list;
 		slab->free_list = p;
 		p += slab->block_size;
 	}
+#endif
 	return 0;
 }
 
@@ -100,6 +225,92 @@ out:
 	return rc;
 }
 
+#ifdef CONFIG_MEM_SLAB_LOCKFREE
+int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
+	uint64_t head;
+	int result;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
+
+	*mem = lf_pop(slab);
+	if (*mem != NULL) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+		return 0;
+	}
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) ||
+	    !IS_ENABLED(CONFIG_MULTITHREADING)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, -ENOMEM);
+		return -ENOMEM;
+	}
+
+	/* Flag the list as waited on, unless a block came back meanwhile:
+	 * from then on frees take the lock, and cannot miss this thread
+	 */
+	key = k_spin_lock(&slab->lock);
+	do {
+		head = lf_load(slab);
+		if ((head & LF_OFFSET_MASK) != 0U) {
+			*mem = lf_pop(slab);
+			if (*mem != NULL) {
+				k_spin_unlock(&slab->lock, key);
+				SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
+				return 0;
+			}
+			continue;
+		}
+	} while ((head & LF_WAITERS) == 0U &&
+		 !lf_cas(slab, head, head | LF_WAITERS));
+
+	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_mem_slab, alloc, slab, timeout);
+
+	result = z_pend_curr(&slab->lock, key, &slab->wait_q, timeout);
+	if (result == 0) {
+		*mem = _current->base.swap_data;
+	}
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, result);
+
+	return result;
+}
+
+void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
+{
+	k_spinlock_key_t key;
+	struct k_thread *pending_thread;
+
+	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
+
+	if (lf_push(slab, *mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+		return;
+	}
+
+	key = k_spin_lock(&slab->lock);
+	pending_thread = z_unpend_first_thread(&slab->wait_q);
+	if (pending_thread != NULL) {
+		if (z_waitq_head(&slab->wait_q) == NULL) {
+			lf_clear_waiters(slab, NULL);
+		}
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+
+		z_thread_return_value_set_with_data(pending_thread, 0, *mem);
+		z_ready_thread(pending_thread);
+		z_reschedule(&slab->lock, key);
+		return;
+	}
+
+	/* The waiters timed out */
+	lf_clear_waiters(slab, *mem);
+
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+
+	k_spin_unlock(&slab->lock, key);
+}
+#else
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 {
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
@@ -169,3 +380,4 @@ void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 
 	k_spin_unlock(&slab->lock, key);
 }
+#endif /* CONFIG_MEM_SLAB_LOCKFREE */
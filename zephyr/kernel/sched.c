@@ -202,6 +202,11 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 	cpu = m == 0 ? 0 : u32_count_trailing_zeros(m);
 
 	return &_kernel.cpus[cpu].ready_q.runq;
+#elif defined(CONFIG_SCHED_PER_CPU_RUNQ)
+	/* A queued thread lives in the queue of the CPU it last ran
+	 * on, see next_up()
+	 */
+	return &_kernel.cpus[thread->base.cpu].ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
 #endif
@@ -209,13 +214,40 @@ static ALWAYS_INLINE void *thread_runq(struct k_thread *thread)
 
 static ALWAYS_INLINE void *curr_cpu_runq(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || \
+	defined(CONFIG_SCHED_PER_CPU_RUNQ)
 	return &arch_curr_cpu()->ready_q.runq;
 #else
 	return &_kernel.ready_q.runq;
 #endif
 }
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+/* Each per-CPU queue caches its best thread, so that a CPU can compare
+ * its own best thread with those of its peers without walking their
+ * queues.  A thread of the same priority is queued after the best one,
+ * so only a strictly higher priority thread replaces it.
+ */
+static ALWAYS_INLINE void runq_add(struct k_thread *thread)
+{
+	_ready_q_t *rq = &_kernel.cpus[thread->base.cpu].ready_q;
+
+	_priq_run_add(&rq->runq, thread);
+	if (rq->best == NULL || z_sched_prio_cmp(thread, rq->best) > 0) {
+		rq->best = thread;
+	}
+}
+
+static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
+{
+	_ready_q_t *rq = &_kernel.cpus[thread->base.cpu].ready_q;
+
+	_priq_run_remove(&rq->runq, thread);
+	if (rq->best == thread) {
+		rq->best = _priq_run_best(&rq->runq);
+	}
+}
+#else
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
 {
 	_priq_run_add(thread_runq(thread), thread);
@@ -225,11 +257,37 @@ static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
 {
 	_priq_run_remove(thread_runq(thread), thread);
 }
+#endif
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+/* Best thread of the local run queue, or a thread stolen from a peer
+ * CPU if the local queue is empty or the peer's cached best thread has
+ * a strictly higher priority.  Peers are scanned starting after the
+ * current CPU so that idle CPUs do not all steal from the same queue.
+ */
+static ALWAYS_INLINE struct k_thread *runq_best(void)
+{
+	struct k_thread *best = _current_cpu->ready_q.best;
+	unsigned int id = _current_cpu->id;
+
+	for (unsigned int i = 1; i < CONFIG_MP_NUM_CPUS; i++) {
+		unsigned int cpu = (id + i) % CONFIG_MP_NUM_CPUS;
+		struct k_thread *thread = _kernel.cpus[cpu].ready_q.best;
+
+		if (thread != NULL &&
+		    (best == NULL || z_sched_prio_cmp(thread, best) > 0)) {
+			best = thread;
+		}
+	}
+
+	return best;
+}
+#else
 static ALWAYS_INLINE struct k_thread *runq_best(void)
 {
 	return _priq_run_best(curr_cpu_runq());
 }
+#endif
 
 /* _current is never in the run queue until context switch on
  * SMP configurations, see z_requeue_current()
@@ -357,6 +415,13 @@ static ALWAYS_INLINE struct k_thread *next_up(void)
 		dequeue_thread(thread);
 	}
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	/* From now on the thread is queued on this CPU, this must
+	 * only change while it is out of any run queue
+	 */
+	thread->base.cpu = _current_cpu->id;
+#endif
+
 	_current_cpu->swap_ok = false;
 	return thread;
 #endif
@@ -385,8 +450,33 @@ static int slice_max_prio;
 static struct k_thread *pending_current;
 #endif
 
-void z_reset_time_slice(void)
+static inline int sliceable(struct k_thread *thread)
 {
+	return is_preempt(thread)
+		&& !z_is_thread_prevented_from_running(thread)
+		&& !z_is_prio_higher(thread->base.prio, slice_max_prio)
+		&& !z_is_idle_thread_object(thread);
+}
+
+/* Restart the time slice for the thread about to run on this CPU */
+void z_reset_time_slice(struct k_thread *curr)
+{
+#ifdef CONFIG_SYSTEM_CLOCK_LOCAL_TIMEOUT
+	/* Slices expire on their own CPU, through its local timer
+	 * event, instead of on the CPU announcing ticks.  The event is
+	 * cancelled when the CPU switches to a thread that cannot be
+	 * sliced, e.g. the idle thread, so that it is left alone.
+	 */
+	if (slice_time != 0 && sliceable(curr)) {
+		_current_cpu->slice_ticks = slice_time;
+		sys_clock_set_local_timeout(slice_time);
+	} else if (_current_cpu->slice_ticks != 0) {
+		_current_cpu->slice_ticks = 0;
+		sys_clock_set_local_timeout(K_TICKS_FOREVER);
+	}
+#else
+	ARG_UNUSED(curr);
+
 	/* Add the elapsed time since the last announced tick to the
 	 * slice count, as we'll see those "expired" ticks arrive in a
 	 * FUTURE z_time_slice() call.
@@ -395,12 +485,15 @@ void z_reset_time_slice(void)
 		_current_cpu->slice_ticks = slice_time + sys_clock_elapsed();
 		z_set_timeout_expiry(slice_time, false);
 	}
+#endif
 }
 
 void k_sched_time_slice_set(int32_t slice, int prio)
 {
 	LOCKED(&sched_spinlock) {
+#ifndef CONFIG_SYSTEM_CLOCK_LOCAL_TIMEOUT
 		_current_cpu->slice_ticks = 0;
+#endif
 		slice_time = k_ms_to_ticks_ceil32(slice);
 		if (IS_ENABLED(CONFIG_TICKLESS_KERNEL) && slice > 0) {
 			/* It's not possible to reliably set a 1-tick
@@ -409,18 +502,10 @@ void k_sched_time_slice_set(int32_t slice, int prio)
 			slice_time = MAX(2, slice_time);
 		}
 		slice_max_prio = prio;
-		z_reset_time_slice();
+		z_reset_time_slice(_current);
 	}
 }
 
-static inline int sliceable(struct k_thread *thread)
-{
-	return is_preempt(thread)
-		&& !z_is_thread_prevented_from_running(thread)
-		&& !z_is_prio_higher(thread->base.prio, slice_max_prio)
-		&& !z_is_idle_thread_object(thread);
-}
-
 /* Called out of each timer interrupt */
 void z_time_slice(int ticks)
 {
@@ -435,7 +520,7 @@ void z_time_slice(int ticks)
 
 #ifdef CONFIG_SWAP_NONATOMIC
 	if (pending_current == _current) {
-		z_reset_time_slice();
+		z_reset_time_slice(_current);
 		k_spin_unlock(&sched_spinlock, key);
 		return;
 	}
@@ -445,7 +530,7 @@ void z_time_slice(int ticks)
 	if (slice_time && sliceable(_current)) {
 		if (ticks >= _current_cpu->slice_ticks) {
 			move_thread_to_end_of_prio_q(_current);
-			z_reset_time_slice();
+			z_reset_time_slice(_current);
 		} else {
 			_current_cpu->slice_ticks -= ticks;
 		}
@@ -482,7 +567,7 @@ static void update_cache(int preempt_ok)
 	if (should_preempt(thread, preempt_ok)) {
 #ifdef CONFIG_TIMESLICING
 		if (thread != _current) {
-			z_reset_time_slice();
+			z_reset_time_slice(thread);
 		}
 #endif
 		update_metairq_preempt(thread);
@@ -502,25 +587,80 @@ static void update_cache(int preempt_ok)
 #endif
 }
 
-static bool thread_active_elsewhere(struct k_thread *thread)
+static uint32_t thread_active_cpus(struct k_thread *thread)
 {
-	/* True if the thread is currently running on another CPU.
-	 * There are more scalable designs to answer this question in
-	 * constant time, but this is fine for now.
+	/* Mask of the other CPUs the thread is currently running on
+	 * (at most one).  There are more scalable designs to answer
+	 * this question in constant time, but this is fine for now.
 	 */
+	uint32_t mask = 0U;
 #ifdef CONFIG_SMP
 	int currcpu = _current_cpu->id;
 
 	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
 		if ((i != currcpu) &&
 		    (_kernel.cpus[i].current == thread)) {
-			return true;
+			mask |= BIT(i);
 		}
 	}
 #endif
-	return false;
+	return mask;
+}
+
+static bool thread_active_elsewhere(struct k_thread *thread)
+{
+	/* True if the thread is currently running on another CPU */
+	return thread_active_cpus(thread) != 0U;
+}
+
+#if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
+/* Mask of the other CPUs that have to pick a new thread now that
+ * the thread is ready: the ones allowed to run it that are idle or
+ * running a lower priority thread it can preempt.
+ */
+static uint32_t ipi_mask_for(struct k_thread *thread)
+{
+	uint32_t mask = 0U;
+	int currcpu = _current_cpu->id;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct k_thread *curr = _kernel.cpus[i].current;
+
+		if ((i == currcpu) || (curr == NULL)) {
+			continue;
+		}
+#ifdef CONFIG_SCHED_CPU_MASK
+		if ((thread->base.cpu_mask & BIT(i)) == 0) {
+			continue;
+		}
+#endif
+		if (z_is_idle_thread_object(curr) ||
+		    ((z_sched_prio_cmp(thread, curr) > 0) &&
+		     (is_preempt(curr) || is_metairq(thread)))) {
+			mask |= BIT(i);
+		}
+	}
+
+	return mask;
 }
 
+/* Interrupt the CPUs of the mask, or all others if the architecture
+ * can only broadcast
+ */
+static void signal_ipi(uint32_t mask)
+{
+	if (mask == 0U) {
+		return;
+	}
+
+#ifdef CONFIG_ARCH_HAS_DIRECTED_IPIS
+	arch_sched_directed_ipi(mask);
+#else
+	arch_sched_ipi();
+#endif
+}
+#endif /* CONFIG_SMP && CONFIG_SCHED_IPI_SUPPORTED */
+
 static void ready_thread(struct k_thread *thread)
 {
 #ifdef CONFIG_KERNEL_COHERENCE
@@ -536,7 +676,7 @@ static void ready_thread(struct k_thread *thread)
 		queue_thread(thread);
 		update_cache(0);
 #if defined(CONFIG_SMP) &&  defined(CONFIG_SCHED_IPI_SUPPORTED)
-		arch_sched_ipi();
+		signal_ipi(ipi_mask_for(thread));
 #endif
 	}
 }
@@ -943,7 +1083,7 @@ void *z_get_next_switch_handle(void *interrupted)
 			arch_cohere_stacks(old_thread, interrupted, new_thread);
 
 #ifdef CONFIG_TIMESLICING
-			z_reset_time_slice();
+			z_reset_time_slice(new_thread);
 #endif
 			_current_cpu->swap_ok = 0;
 			set_current(new_thread);
@@ -1139,7 +1279,8 @@ void init_ready_q(struct _ready_q *rq)
 
 void z_sched_init(void)
 {
-#ifdef CONFIG_SCHED_CPU_MASK_PIN_ONLY
+#if defined(CONFIG_SCHED_CPU_MASK_PIN_ONLY) || \
+	defined(CONFIG_SCHED_PER_CPU_RUNQ)
 	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
 		init_ready_q(&_kernel.cpus[i].ready_q);
 	}
@@ -1374,11 +1515,9 @@ void z_impl_k_wakeup(k_tid_t thread)
 	}
 
 	z_mark_thread_as_not_suspended(thread);
-	z_ready_thread(thread);
 
-#if defined(CONFIG_SMP) && defined(CONFIG_SCHED_IPI_SUPPORTED)
-	arch_sched_ipi();
-#endif
+	/* Signals the CPUs that may run the thread */
+	z_ready_thread(thread);
 
 	if (!arch_is_in_isr()) {
 		z_reschedule_unlocked();
@@ -1395,6 +1534,10 @@ void z_sched_ipi(void)
 	/* NOTE: When adding code to this, make sure this is called
 	 * at appropriate location when !CONFIG_SCHED_IPI_SUPPORTED.
 	 */
+#ifdef CONFIG_SCHED_IPI_STATS
+	_current_cpu->ipi_count++;
+#endif
+
 #ifdef CONFIG_TRACE_SCHED_IPI
 	z_trace_sched_ipi();
 #endif
@@ -1567,14 +1710,15 @@ void z_thread_abort(struct k_thread *thread)
 		end_thread(thread);
 	}
 
-	bool active = thread_active_elsewhere(thread);
+	uint32_t active_cpus = thread_active_cpus(thread);
+	bool active = active_cpus != 0U;
 
 	if (active) {
 		/* It's running somewhere else, flag and poke */
 		thread->base.thread_state |= _THREAD_ABORTING;
 
 #ifdef CONFIG_SCHED_IPI_SUPPORTED
-		arch_sched_ipi();
+		signal_ipi(active_cpus);
 #endif
 	}
 
@@ -9,10 +9,69 @@
 #include <spinlock.h>
 #include <kswap.h>
 #include <kernel_internal.h>
+#include <string.h>
+#include <sys/printk.h>
 
 static atomic_t global_lock;
 static atomic_t start_flag;
 
+#ifdef CONFIG_SMP_GLOBAL_LOCK_STATS
+/* Protected by stats_lock rather than the global lock, so that they can
+ * be read without irq_lock(). Sites fill the table in order, so the
+ * first free entry ends a lookup.
+ */
+static struct k_spinlock stats_lock;
+static struct z_smp_global_lock_site
+	lock_sites[CONFIG_SMP_GLOBAL_LOCK_STATS_SITES];
+static uint32_t untracked_count;
+static struct z_smp_global_lock_site *holder_site;
+static uint32_t hold_start;
+
+static void lock_stats_acquired(void *site, bool contended)
+{
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+	struct z_smp_global_lock_site *s = NULL;
+
+	for (int i = 0; i < ARRAY_SIZE(lock_sites); i++) {
+		if ((lock_sites[i].site == site) ||
+		    (lock_sites[i].site == NULL)) {
+			s = &lock_sites[i];
+			s->site = site;
+			break;
+		}
+	}
+
+	if (s != NULL) {
+		s->count++;
+		s->contended += contended ? 1U : 0U;
+	} else {
+		untracked_count++;
+	}
+
+	holder_site = s;
+	hold_start = k_cycle_get_32();
+	k_spin_unlock(&stats_lock, key);
+}
+
+static void lock_stats_released(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+	if (holder_site != NULL) {
+		uint32_t held = k_cycle_get_32() - hold_start;
+
+		holder_site->hold_cycles += held;
+		holder_site->max_hold_cycles =
+			MAX(holder_site->max_hold_cycles, held);
+		holder_site = NULL;
+	}
+	k_spin_unlock(&stats_lock, key);
+}
+#else
+#define lock_stats_acquired(site, contended) do { } while (false)
+#define lock_stats_released() do { } while (false)
+#endif
+
 unsigned int z_smp_global_lock(void)
 {
 	/* Debugging in SoftConsole has a problem with breaking on empty loops
@@ -21,10 +80,16 @@ unsigned int z_smp_global_lock(void)
     volatile int dummy = 0;
 	unsigned int key = arch_irq_lock();
 
+#ifdef CONFIG_SMP_GLOBAL_LOCK_ASSERT
+	__ASSERT(false, "irq_lock() on SMP from %p, use a spinlock",
+		 __builtin_return_address(0));
+#endif
+
 	if (!_current->base.global_lock_count) {
 		while (!atomic_cas(&global_lock, 0, 1)) {
 		    dummy++;
 		}
+		lock_stats_acquired(__builtin_return_address(0), dummy != 0);
 	}
 
 	_current->base.global_lock_count++;
@@ -38,6 +103,7 @@ void z_smp_global_unlock(unsigned int key)
 		_current->base.global_lock_count--;
 
 		if (!_current->base.global_lock_count) {
+			lock_stats_released();
 			atomic_clear(&global_lock);
 		}
 	}
@@ -49,10 +115,84 @@ void z_smp_global_unlock(unsigned int key)
 void z_smp_release_global_lock(struct k_thread *thread)
 {
 	if (!thread->base.global_lock_count) {
+		/* Only account the release if the outgoing thread really
+		 * holds the lock, it may belong to another CPU otherwise
+		 */
+		if (_current->base.global_lock_count) {
+			lock_stats_released();
+		}
 		atomic_clear(&global_lock);
 	}
 }
 
+#ifdef CONFIG_SMP_GLOBAL_LOCK_STATS
+int z_smp_global_lock_stats_get(struct z_smp_global_lock_site *sites,
+				int max, uint32_t *untracked)
+{
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+	int n;
+
+	for (n = 0; (n < max) && (n < ARRAY_SIZE(lock_sites)); n++) {
+		if (lock_sites[n].site == NULL) {
+			break;
+		}
+		sites[n] = lock_sites[n];
+	}
+
+	if (untracked != NULL) {
+		*untracked = untracked_count;
+	}
+	k_spin_unlock(&stats_lock, key);
+
+	return n;
+}
+
+void z_smp_global_lock_stats_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+	(void)memset(lock_sites, 0, sizeof(lock_sites));
+	untracked_count = 0U;
+	/* A hold in progress is not accounted */
+	holder_site = NULL;
+	k_spin_unlock(&stats_lock, key);
+}
+
+void z_smp_global_lock_stats_print(void)
+{
+	static struct z_smp_global_lock_site
+		sites[CONFIG_SMP_GLOBAL_LOCK_STATS_SITES];
+	uint32_t untracked;
+	int n = z_smp_global_lock_stats_get(sites, ARRAY_SIZE(sites),
+					    &untracked);
+
+	printk("irq_lock() call sites (hold times in cycles):\n");
+
+	/* Busiest first, the table is small */
+	for (int i = 0; i < n; i++) {
+		struct z_smp_global_lock_site *s = &sites[i];
+
+		for (int j = i + 1; j < n; j++) {
+			if (sites[j].count > s->count) {
+				struct z_smp_global_lock_site tmp = *s;
+
+				*s = sites[j];
+				sites[j] = tmp;
+			}
+		}
+
+		printk("  %p: %u locks, %u contended, hold avg %u max %u\n",
+		       s->site, s->count, s->contended,
+		       (uint32_t)(s->hold_cycles / s->count),
+		       s->max_hold_cycles);
+	}
+
+	if (untracked != 0U) {
+		printk("  other sites: %u locks\n", untracked);
+	}
+}
+#endif
+
 #if CONFIG_MP_NUM_CPUS > 1
 
 void z_smp_thread_init(void *arg, struct k_thread *thread)
@@ -75,6 +215,7 @@ static inline FUNC_NORETURN void smp_init_top(void *arg)
 {
 	struct k_thread dummy_thread;
 
+	z_boot_timeline_cpu(arch_curr_cpu()->id);
 	z_smp_thread_init(arg, &dummy_thread);
 	smp_timer_init();
 
@@ -107,6 +248,15 @@ void z_smp_init(void)
 	(void)atomic_set(&start_flag, 1);
 }
 
+#ifdef CONFIG_SCHED_IPI_STATS
+uint32_t z_smp_ipi_count_get(int cpu)
+{
+	__ASSERT_NO_MSG(cpu >= 0 && cpu < CONFIG_MP_NUM_CPUS);
+
+	return _kernel.cpus[cpu].ipi_count;
+}
+#endif
+
 bool z_smp_cpu_mobile(void)
 {
 	unsigned int k = arch_irq_lock();
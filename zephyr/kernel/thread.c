@@ -783,6 +783,11 @@ void z_init_thread_base(struct _thread_base *thread_base, int priority,
 	thread_base->is_idle = 0;
 #endif
 
+#ifdef CONFIG_SCHED_PER_CPU_RUNQ
+	/* Queue new threads on the CPU creating them */
+	thread_base->cpu = arch_curr_cpu()->id;
+#endif
+
 	/* swap_data does not need to be initialized */
 
 	z_init_thread_timeout(thread_base);
@@ -14,7 +14,13 @@
 
 static uint64_t curr_tick;
 
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+/* Root of the pairing heap, the first timeout to expire */
+static struct _timeout *timeout_heap;
+static uint32_t timeout_seq;
+#else
 static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+#endif
 
 static struct k_spinlock timeout_lock;
 
@@ -36,6 +42,136 @@ static inline int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+#ifdef CONFIG_TIMEOUT_QUEUE_SCALABLE
+
+/*
+ * Pairing heap of the pending timeouts, keyed on the absolute expiry tick
+ * kept in dticks.  A node links to its first child and to its next
+ * sibling; prev is the previous sibling, or the parent for a first child,
+ * or the node itself for the root.  Adding a timeout melds it with the
+ * root in O(1), removing one merges its children in pairs, which is
+ * O(log n) amortized.
+ */
+
+static bool before(const struct _timeout *a, const struct _timeout *b)
+{
+	return (a->dticks < b->dticks) ||
+	       ((a->dticks == b->dticks) && ((int32_t)(a->seq - b->seq) < 0));
+}
+
+/* Meld two heaps, the other one becomes the first child of the winner */
+static struct _timeout *meld(struct _timeout *a, struct _timeout *b)
+{
+	if (before(b, a)) {
+		struct _timeout *tmp = a;
+
+		a = b;
+		b = tmp;
+	}
+
+	b->prev = a;
+	b->next = a->child;
+	if (a->child != NULL) {
+		a->child->prev = b;
+	}
+	a->child = b;
+
+	return a;
+}
+
+/* Merge a list of siblings into one heap: meld them in pairs from the
+ * left, then meld the pairs from the right.
+ */
+static struct _timeout *merge_pairs(struct _timeout *t)
+{
+	struct _timeout *pairs = NULL, *root;
+
+	while (t != NULL) {
+		struct _timeout *a = t, *b = t->next;
+
+		if (b == NULL) {
+			a->next = pairs;
+			pairs = a;
+			break;
+		}
+
+		t = b->next;
+		a = meld(a, b);
+		a->next = pairs;
+		pairs = a;
+	}
+
+	root = pairs;
+	if (root != NULL) {
+		pairs = root->next;
+		while (pairs != NULL) {
+			struct _timeout *n = pairs->next;
+
+			root = meld(root, pairs);
+			pairs = n;
+		}
+		root->next = NULL;
+		root->prev = root;
+	}
+
+	return root;
+}
+
+static struct _timeout *first(void)
+{
+	return timeout_heap;
+}
+
+/* Ticks from curr_tick to the expiry of a queued timeout */
+static k_ticks_t timeout_dticks(const struct _timeout *t)
+{
+	return t->dticks - curr_tick;
+}
+
+static void insert_timeout(struct _timeout *to, k_ticks_t dticks)
+{
+	to->dticks = curr_tick + dticks;
+	to->seq = timeout_seq++;
+	to->child = NULL;
+	to->next = NULL;
+
+	if (timeout_heap == NULL) {
+		timeout_heap = to;
+	} else {
+		timeout_heap = meld(timeout_heap, to);
+	}
+	timeout_heap->prev = timeout_heap;
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	struct _timeout *sub = merge_pairs(t->child);
+
+	if (t == timeout_heap) {
+		timeout_heap = sub;
+	} else {
+		if (t->prev->child == t) {
+			t->prev->child = t->next;
+		} else {
+			t->prev->next = t->next;
+		}
+		if (t->next != NULL) {
+			t->next->prev = t->prev;
+		}
+
+		if (sub != NULL) {
+			timeout_heap = meld(timeout_heap, sub);
+			timeout_heap->prev = timeout_heap;
+		}
+	}
+
+	t->child = NULL;
+	t->next = NULL;
+	t->prev = NULL;
+}
+
+#else
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -50,6 +186,41 @@ static struct _timeout *next(struct _timeout *t)
 	return n == NULL ? NULL : CONTAINER_OF(n, struct _timeout, node);
 }
 
+/* Ticks from curr_tick to the expiry of a queued timeout */
+static k_ticks_t timeout_dticks(const struct _timeout *timeout)
+{
+	k_ticks_t ticks = 0;
+
+	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
+		ticks += t->dticks;
+		if (timeout == t) {
+			break;
+		}
+	}
+
+	return ticks;
+}
+
+static void insert_timeout(struct _timeout *to, k_ticks_t dticks)
+{
+	struct _timeout *t;
+
+	to->dticks = dticks;
+
+	for (t = first(); t != NULL; t = next(t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&timeout_list, &to->node);
+	}
+}
+
 static void remove_timeout(struct _timeout *t)
 {
 	if (next(t) != NULL) {
@@ -59,6 +230,8 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
+#endif /* CONFIG_TIMEOUT_QUEUE_SCALABLE */
+
 static int32_t elapsed(void)
 {
 	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
@@ -69,9 +242,10 @@ static int32_t next_timeout(void)
 	struct _timeout *to = first();
 	int32_t ticks_elapsed = elapsed();
 	int32_t ret = to == NULL ? MAX_WAIT
-		: CLAMP(to->dticks - ticks_elapsed, 0, MAX_WAIT);
+		: CLAMP(timeout_dticks(to) - ticks_elapsed, 0, MAX_WAIT);
 
-#ifdef CONFIG_TIMESLICING
+	/* With local timer events, the slice is not a system clock timeout */
+#if defined(CONFIG_TIMESLICING) && !defined(CONFIG_SYSTEM_CLOCK_LOCAL_TIMEOUT)
 	if (_current_cpu->slice_ticks && _current_cpu->slice_ticks < ret) {
 		ret = _current_cpu->slice_ticks;
 	}
@@ -90,36 +264,26 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	__ASSERT_NO_MSG(arch_mem_coherent(to));
 #endif
 
-	__ASSERT(!sys_dnode_is_linked(&to->node), "");
+	__ASSERT(z_is_inactive_timeout(to), "");
 	to->fn = fn;
 
 	LOCKED(&timeout_lock) {
-		struct _timeout *t;
+		k_ticks_t dticks;
 
 		if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
 		    Z_TICK_ABS(timeout.ticks) >= 0) {
 			k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
 
-			to->dticks = MAX(1, ticks);
+			dticks = MAX(1, ticks);
 		} else {
-			to->dticks = timeout.ticks + 1 + elapsed();
+			dticks = timeout.ticks + 1 + elapsed();
 		}
 
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
-		}
-
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
-		}
+		insert_timeout(to, dticks);
 
 		if (to == first()) {
-#if CONFIG_TIMESLICING
+#if defined(CONFIG_TIMESLICING) && \
+	!defined(CONFIG_SYSTEM_CLOCK_LOCAL_TIMEOUT)
 			/*
 			 * This is not ideal, since it does not
 			 * account the time elapsed since the
@@ -146,7 +310,7 @@ int z_abort_timeout(struct _timeout *to)
 	int ret = -EINVAL;
 
 	LOCKED(&timeout_lock) {
-		if (sys_dnode_is_linked(&to->node)) {
+		if (!z_is_inactive_timeout(to)) {
 			remove_timeout(to);
 			ret = 0;
 		}
@@ -158,20 +322,11 @@ int z_abort_timeout(struct _timeout *to)
 /* must be locked */
 static k_ticks_t timeout_rem(const struct _timeout *timeout)
 {
-	k_ticks_t ticks = 0;
-
 	if (z_is_inactive_timeout(timeout)) {
 		return 0;
 	}
 
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-		ticks += t->dticks;
-		if (timeout == t) {
-			break;
-		}
-	}
-
-	return ticks - elapsed();
+	return timeout_dticks(timeout) - elapsed();
 }
 
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
@@ -230,9 +385,19 @@ void z_set_timeout_expiry(int32_t ticks, bool is_idle)
 	}
 }
 
-void sys_clock_announce(int32_t ticks)
+#ifdef CONFIG_SYSTEM_CLOCK_LOCAL_TIMEOUT
+void sys_clock_local_announce(void)
 {
 #ifdef CONFIG_TIMESLICING
+	/* The only local event is the end of the current time slice */
+	z_time_slice(INT_MAX);
+#endif
+}
+#endif
+
+void sys_clock_announce(int32_t ticks)
+{
+#if defined(CONFIG_TIMESLICING) && !defined(CONFIG_SYSTEM_CLOCK_LOCAL_TIMEOUT)
 	z_time_slice(ticks);
 #endif
 
@@ -240,9 +405,10 @@ void sys_clock_announce(int32_t ticks)
 
 	announce_remaining = ticks;
 
-	while (first() != NULL && first()->dticks <= announce_remaining) {
+	while (first() != NULL &&
+	       timeout_dticks(first()) <= announce_remaining) {
 		struct _timeout *t = first();
-		int dt = t->dticks;
+		int dt = timeout_dticks(t);
 
 		curr_tick += dt;
 		announce_remaining -= dt;
@@ -254,9 +420,11 @@ void sys_clock_announce(int32_t ticks)
 		key = k_spin_lock(&timeout_lock);
 	}
 
+#ifndef CONFIG_TIMEOUT_QUEUE_SCALABLE
 	if (first() != NULL) {
 		first()->dticks -= announce_remaining;
 	}
+#endif
 
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
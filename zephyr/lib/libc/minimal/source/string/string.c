@@ -230,6 +230,9 @@ char *strncat(char *_MLIBC_RESTRICT dest, const char *_MLIBC_RESTRICT src,
 	return orig_dest;
 }
 
+/* Assembly versions of memcmp, memmove, memcpy and memset in mem_riscv64.S */
+#if !defined(CONFIG_MINIMAL_LIBC_RISCV64_MEM_FUNCS)
+
 /**
  *
  * @brief Compare two memory areas
@@ -394,6 +397,8 @@ void *memset(void *buf, int c, size_t n)
 	return buf;
 }
 
+#endif /* !CONFIG_MINIMAL_LIBC_RISCV64_MEM_FUNCS */
+
 /**
  *
  * @brief Scan byte in memory
@@ -5,6 +5,7 @@
  */
 
 #include <sys/crc.h>
+#include "crc_tables.h"
 
 uint16_t crc16(const uint8_t *src, size_t len, uint16_t polynomial,
 	    uint16_t initial_value, bool pad)
@@ -37,6 +38,11 @@ uint16_t crc16(const uint8_t *src, size_t len, uint16_t polynomial,
 
 uint16_t crc16_ccitt(uint16_t seed, const uint8_t *src, size_t len)
 {
+#if CRC_TABLE_ROWS > 0
+	for (; len > 0; len--) {
+		seed = (seed >> 8) ^ crc16_ccitt_table[(seed ^ *src++) & 0xff];
+	}
+#else
 	for (; len > 0; len--) {
 		uint8_t e, f;
 
@@ -44,12 +50,18 @@ uint16_t crc16_ccitt(uint16_t seed, const uint8_t *src, size_t len)
 		f = e ^ (e << 4);
 		seed = (seed >> 8) ^ ((uint16_t)f << 8) ^ ((uint16_t)f << 3) ^ ((uint16_t)f >> 4);
 	}
+#endif
 
 	return seed;
 }
 
 uint16_t crc16_itu_t(uint16_t seed, const uint8_t *src, size_t len)
 {
+#if CRC_TABLE_ROWS > 0
+	for (; len > 0; len--) {
+		seed = (seed << 8) ^ crc16_itu_t_table[(seed >> 8) ^ *src++];
+	}
+#else
 	for (; len > 0; len--) {
 		seed = (seed >> 8U) | (seed << 8U);
 		seed ^= *src++;
@@ -57,6 +69,7 @@ uint16_t crc16_itu_t(uint16_t seed, const uint8_t *src, size_t len)
 		seed ^= seed << 12U;
 		seed ^= (seed & 0xffU) << 5U;
 	}
+#endif
 
 	return seed;
 }
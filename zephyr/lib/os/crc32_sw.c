@@ -5,6 +5,7 @@
  */
 
 #include <sys/crc.h>
+#include "crc_tables.h"
 
 uint32_t crc32_ieee(const uint8_t *data, size_t len)
 {
@@ -13,6 +14,12 @@ uint32_t crc32_ieee(const uint8_t *data, size_t len)
 
 uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
 {
+#if defined(CONFIG_CRC_RISCV_ZBC)
+	return ~crc32_le_zbc(~crc, data, len, CRC32_IEEE_POLY,
+			     CRC32_IEEE_POLY_QT);
+#elif CRC_TABLE_ROWS > 0
+	return ~crc32_le_tables(crc32_ieee_table, ~crc, data, len);
+#else
 	/* crc table generated from polynomial 0xedb88320 */
 	static const uint32_t table[16] = {
 		0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac,
@@ -31,4 +38,5 @@ uint32_t crc32_ieee_update(uint32_t crc, const uint8_t *data, size_t len)
 	}
 
 	return (~crc);
+#endif
 }
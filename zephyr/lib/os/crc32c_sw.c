@@ -5,14 +5,17 @@
  */
 
 #include <sys/crc.h>
+#include "crc_tables.h"
 
+#if CRC_TABLE_ROWS == 0 && !defined(CONFIG_CRC_RISCV_ZBC)
 /* crc table generated from polynomial 0x1EDC6F41UL (Castagnoli) */
-static const uint32_t crc32c_table[16] = {
+static const uint32_t crc32c_small_table[16] = {
 	0x00000000UL, 0x105EC76FUL, 0x20BD8EDEUL, 0x30E349B1UL,
 	0x417B1DBCUL, 0x5125DAD3UL, 0x61C69362UL, 0x7198540DUL,
 	0x82F63B78UL, 0x92A8FC17UL, 0xA24BB5A6UL, 0xB21572C9UL,
 	0xC38D26C4UL, 0xD3D3E1ABUL, 0xE330A81AUL, 0xF36E6F75UL
 };
+#endif
 
 /* This value needs to be XORed with the final crc value once crc for
  * the entire stream is calculated. This is a requirement of crc32c algo.
@@ -31,10 +34,16 @@ uint32_t crc32_c(uint32_t crc, const uint8_t *data,
 		crc = CRC32C_INIT;
 	}
 
+#if defined(CONFIG_CRC_RISCV_ZBC)
+	crc = crc32_le_zbc(crc, data, len, CRC32C_POLY, CRC32C_POLY_QT);
+#elif CRC_TABLE_ROWS > 0
+	crc = crc32_le_tables(crc32c_table, crc, data, len);
+#else
 	for (size_t i = 0; i < len; i++) {
-		crc = crc32c_table[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
-		crc = crc32c_table[(crc ^ ((uint32_t)data[i] >> 4)) & 0x0F] ^ (crc >> 4);
+		crc = crc32c_small_table[(crc ^ data[i]) & 0x0F] ^ (crc >> 4);
+		crc = crc32c_small_table[(crc ^ ((uint32_t)data[i] >> 4)) & 0x0F] ^ (crc >> 4);
 	}
+#endif
 
 	return last_pkt ? (crc ^ CRC32C_XOR_OUT) : crc;
 }
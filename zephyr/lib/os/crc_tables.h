@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2021 Microchip Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Private to the CRC implementations: lookup tables generated by
+ * scripts/gen_crc_tables.py and the word at a time CRC32 loops shared by
+ * CRC32 and CRC32C.
+ */
+
+#ifndef ZEPHYR_LIB_OS_CRC_TABLES_H_
+#define ZEPHYR_LIB_OS_CRC_TABLES_H_
+
+#include <zephyr/types.h>
+#include <stddef.h>
+#include <sys/byteorder.h>
+
+/* Rows of the CRC32 tables, none when the nibble tables are used */
+#if defined(CONFIG_CRC_SLICING_BY_8)
+#define CRC_TABLE_ROWS 8
+#elif defined(CONFIG_CRC_SLICING_BY_4)
+#define CRC_TABLE_ROWS 4
+#elif defined(CONFIG_CRC_BYTE_TABLES)
+#define CRC_TABLE_ROWS 1
+#else
+#define CRC_TABLE_ROWS 0
+#endif
+
+#if CRC_TABLE_ROWS > 0
+extern const uint32_t crc32_ieee_table[CRC_TABLE_ROWS][256];
+extern const uint32_t crc32c_table[CRC_TABLE_ROWS][256];
+extern const uint16_t crc16_ccitt_table[256];
+extern const uint16_t crc16_itu_t_table[256];
+extern const uint8_t crc8_ccitt_table[256];
+
+/*
+ * Update a reflected CRC32 register, without the pre and post inversion.
+ * With slicing, whole words are folded with one lookup per byte in
+ * distinct tables, which the CPU can issue in parallel.
+ */
+static inline uint32_t crc32_le_tables(const uint32_t table[][256],
+				       uint32_t crc, const uint8_t *data,
+				       size_t len)
+{
+#if CRC_TABLE_ROWS >= 4
+	/* Align, so that words are read with single loads */
+	for (; len > 0 && ((uintptr_t)data & 3) != 0; len--) {
+		crc = table[0][(crc ^ *data++) & 0xff] ^ (crc >> 8);
+	}
+
+#if CRC_TABLE_ROWS == 8
+	for (; len >= 8; len -= 8, data += 8) {
+		uint32_t lo = crc ^ sys_le32_to_cpu(*(const uint32_t *)data);
+		uint32_t hi = sys_le32_to_cpu(*(const uint32_t *)(data + 4));
+
+		crc = table[7][lo & 0xff] ^ table[6][(lo >> 8) & 0xff] ^
+		      table[5][(lo >> 16) & 0xff] ^ table[4][lo >> 24] ^
+		      table[3][hi & 0xff] ^ table[2][(hi >> 8) & 0xff] ^
+		      table[1][(hi >> 16) & 0xff] ^ table[0][hi >> 24];
+	}
+#endif
+
+	for (; len >= 4; len -= 4, data += 4) {
+		uint32_t w = crc ^ sys_le32_to_cpu(*(const uint32_t *)data);
+
+		crc = table[3][w & 0xff] ^ table[2][(w >> 8) & 0xff] ^
+		      table[1][(w >> 16) & 0xff] ^ table[0][w >> 24];
+	}
+#endif
+
+	for (; len > 0; len--) {
+		crc = table[0][(crc ^ *data++) & 0xff] ^ (crc >> 8);
+	}
+
+	return crc;
+}
+#endif /* CRC_TABLE_ROWS > 0 */
+
+#ifdef CONFIG_CRC_RISCV_ZBC
+/* Quotients of x^96 by the polynomials, reflected, with their x^64 term
+ * implicit
+ */
+#define CRC32_IEEE_POLY 0xedb88320U
+#define CRC32_IEEE_POLY_QT 0x5a72d812fb808b20ULL
+#define CRC32C_POLY 0x82f63b78U
+#define CRC32C_POLY_QT 0xa434f61c6f5389f8ULL
+
+/*
+ * Reduce 64 bits of reflected data by Barrett reduction: the quotient of
+ * the data by the polynomial is estimated with a multiplication by the
+ * precomputed quotient, and its product with the polynomial leaves the
+ * remainder. The clmul and clmulr instructions of Zbc are emitted with
+ * .insn so that assemblers without Zbc support can build this.
+ */
+static inline uint32_t crc32_zbc_fold(uint64_t s, uint32_t poly, uint64_t qt)
+{
+	uint64_t crc;
+
+	__asm__ (".insn r 0x33, 1, 5, %0, %1, %2\n\t"	/* clmul */
+		 "slli %0, %0, 1\n\t"
+		 "xor %0, %0, %1\n\t"
+		 ".insn r 0x33, 2, 5, %0, %0, %3\n\t"	/* clmulr */
+		 "srli %0, %0, 32"
+		 : "=&r" (crc)
+		 : "r" (s), "r" (qt), "r" ((uint64_t)poly << 32));
+
+	return (uint32_t)crc;
+}
+
+static inline uint32_t crc32_le_zbc(uint32_t crc, const uint8_t *data,
+				    size_t len, uint32_t poly, uint64_t qt)
+{
+	/* A byte is folded as a word of seven zero bytes followed by it */
+	for (; len > 0 && ((uintptr_t)data & 7) != 0; len--) {
+		crc = (crc >> 8) ^
+		      crc32_zbc_fold((uint64_t)((crc ^ *data++) & 0xff) << 56,
+				     poly, qt);
+	}
+
+	for (; len >= 8; len -= 8, data += 8) {
+		crc = crc32_zbc_fold(crc ^ sys_le64_to_cpu(*(const uint64_t *)data),
+				     poly, qt);
+	}
+
+	for (; len > 0; len--) {
+		crc = (crc >> 8) ^
+		      crc32_zbc_fold((uint64_t)((crc ^ *data++) & 0xff) << 56,
+				     poly, qt);
+	}
+
+	return crc;
+}
+#endif /* CONFIG_CRC_RISCV_ZBC */
+
+#endif /* ZEPHYR_LIB_OS_CRC_TABLES_H_ */
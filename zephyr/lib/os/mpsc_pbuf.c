@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 #include <sys/mpsc_pbuf.h>
+#include <kernel_structs.h>
 
 #define MPSC_PBUF_DEBUG 0
 
@@ -45,26 +46,42 @@ void mpsc_pbuf_init(struct mpsc_pbuf_buffer *buffer,
 	__ASSERT_NO_MSG(err == 0);
 }
 
-static inline bool free_space(struct mpsc_pbuf_buffer *buffer, uint32_t *res)
+static inline bool free_space_at(struct mpsc_pbuf_buffer *buffer,
+				 uint32_t tmp_wr_idx, uint32_t rd_idx,
+				 uint32_t *res)
 {
-	if (buffer->rd_idx > buffer->tmp_wr_idx) {
-		*res =  buffer->rd_idx - buffer->tmp_wr_idx - 1;
+	if (rd_idx > tmp_wr_idx) {
+		*res =  rd_idx - tmp_wr_idx - 1;
 
 		return false;
-	} else if (!buffer->rd_idx) {
-		*res = buffer->size - buffer->tmp_wr_idx - 1;
+	} else if (!rd_idx) {
+		*res = buffer->size - tmp_wr_idx - 1;
 		return false;
 	}
 
-	*res = buffer->size - buffer->tmp_wr_idx;
+	*res = buffer->size - tmp_wr_idx;
 
 	return true;
 }
 
+static inline bool free_space(struct mpsc_pbuf_buffer *buffer, uint32_t *res)
+{
+	return free_space_at(buffer, buffer->tmp_wr_idx, buffer->rd_idx, res);
+}
+
+/* Indices updated without the lock by other CPUs */
+static inline uint32_t idx_get(uint32_t *idx)
+{
+	return (uint32_t)atomic_get((atomic_t *)idx);
+}
+
 static inline bool available(struct mpsc_pbuf_buffer *buffer, uint32_t *res)
 {
-	if (buffer->tmp_rd_idx <= buffer->wr_idx) {
-		*res = (buffer->wr_idx - buffer->tmp_rd_idx);
+	uint32_t wr_idx = IS_ENABLED(CONFIG_MPSC_PBUF_LOCKFREE) ?
+			  idx_get(&buffer->wr_idx) : buffer->wr_idx;
+
+	if (buffer->tmp_rd_idx <= wr_idx) {
+		*res = (wr_idx - buffer->tmp_rd_idx);
 
 		return false;
 	}
@@ -84,6 +101,16 @@ static inline bool is_invalid(union mpsc_pbuf_generic *item)
 	return !item->hdr.valid && !item->hdr.busy;
 }
 
+/* In lock-free mode a packet is published on allocation, with both bits
+ * clear until it is committed.  The busy bit cannot be used to guard it,
+ * busy without valid is a skip packet.  Its producer still writes it and
+ * its length is not known yet, so it must not be dropped.
+ */
+static inline bool is_uncommitted(union mpsc_pbuf_generic *item)
+{
+	return IS_ENABLED(CONFIG_MPSC_PBUF_LOCKFREE) && is_invalid(item);
+}
+
 static inline uint32_t idx_inc(struct mpsc_pbuf_buffer *buffer,
 				uint32_t idx, uint32_t val)
 {
@@ -128,6 +155,92 @@ static void add_skip_item(struct mpsc_pbuf_buffer *buffer, uint32_t wlen)
 	buffer->wr_idx = idx_inc(buffer, buffer->wr_idx, wlen);
 }
 
+/*
+ * In lock-free mode, producers reserve space by moving tmp_wr_idx with
+ * compare-and-swap, write the packet header, then publish the space by
+ * moving wr_idx, in reservation order, so that the consumer never reads
+ * the stale header of reserved space.  Allocation therefore publishes
+ * the packet, and commit only sets its valid bit.  Interrupts stay
+ * locked from reservation to publication, so waiting for an earlier
+ * reservation only ever waits for another CPU.
+ *
+ * Producers that need to wrap around, drop packets or pend take the
+ * lock as before.  They set wr_locked, which stops new reservations,
+ * and wait for the CPUs that are reserving, after which they own both
+ * write indices and keep them equal.
+ */
+static k_spinlock_key_t wr_lock(struct mpsc_pbuf_buffer *buffer)
+{
+	k_spinlock_key_t key = k_spin_lock(&buffer->lock);
+
+#ifdef CONFIG_MPSC_PBUF_LOCKFREE
+	atomic_set(&buffer->wr_locked, 1);
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		while (atomic_get(&buffer->cpu[i].reserving) != 0) {
+		}
+	}
+#endif
+
+	return key;
+}
+
+static void wr_unlock(struct mpsc_pbuf_buffer *buffer, k_spinlock_key_t key)
+{
+#ifdef CONFIG_MPSC_PBUF_LOCKFREE
+	atomic_clear(&buffer->wr_locked);
+#endif
+	k_spin_unlock(&buffer->lock, key);
+}
+
+#ifdef CONFIG_MPSC_PBUF_LOCKFREE
+/* Reserve contiguous space, returning with interrupts locked on success */
+static bool reserve(struct mpsc_pbuf_buffer *buffer, uint32_t wlen,
+		    uint32_t *idx, unsigned int *key)
+{
+	atomic_t *reserving;
+
+	*key = arch_irq_lock();
+	reserving = &buffer->cpu[_current_cpu->id].reserving;
+	atomic_set(reserving, 1);
+
+	while (atomic_get(&buffer->wr_locked) == 0) {
+		uint32_t wr = idx_get(&buffer->tmp_wr_idx);
+		uint32_t rd = idx_get(&buffer->rd_idx);
+		uint32_t free_wlen;
+
+		/* rd_idx read after tmp_wr_idx can only show more space
+		 * than there was, if tmp_wr_idx did not move meanwhile
+		 */
+		(void)free_space_at(buffer, wr, rd, &free_wlen);
+		if (free_wlen < wlen) {
+			break;
+		}
+
+		if (atomic_cas((atomic_t *)&buffer->tmp_wr_idx, wr,
+			       idx_inc(buffer, wr, wlen))) {
+			*idx = wr;
+			return true;
+		}
+	}
+
+	atomic_clear(reserving);
+	arch_irq_unlock(*key);
+
+	return false;
+}
+
+static void publish(struct mpsc_pbuf_buffer *buffer, uint32_t idx,
+		    uint32_t wlen, unsigned int key)
+{
+	while (idx_get(&buffer->wr_idx) != idx) {
+	}
+
+	atomic_set((atomic_t *)&buffer->wr_idx, idx_inc(buffer, idx, wlen));
+	atomic_clear(&buffer->cpu[_current_cpu->id].reserving);
+	arch_irq_unlock(key);
+}
+#endif /* CONFIG_MPSC_PBUF_LOCKFREE */
+
 /* Attempts to drop a packet. If user packets dropping is allowed then any
  * type of packet is dropped. Otherwise only skip packets (internal padding).
  *
@@ -146,6 +259,10 @@ static union mpsc_pbuf_generic *drop_item_locked(struct mpsc_pbuf_buffer *buffer
 
 	*user_packet = false;
 	item = (union mpsc_pbuf_generic *)&buffer->buf[buffer->rd_idx];
+	if (is_uncommitted(item)) {
+		return NULL;
+	}
+
 	skip_wlen = get_skip(item);
 
 	rd_wlen = skip_wlen ? skip_wlen : buffer->get_wlen(item);
@@ -153,6 +270,12 @@ static union mpsc_pbuf_generic *drop_item_locked(struct mpsc_pbuf_buffer *buffer
 		allow_drop = true;
 	} else if (allow_drop) {
 		if (item->hdr.busy) {
+			if (is_uncommitted((union mpsc_pbuf_generic *)
+				&buffer->buf[idx_inc(buffer, buffer->rd_idx,
+						     rd_wlen)])) {
+				return NULL;
+			}
+
 			/* item is currently processed and cannot be overwritten. */
 			add_skip_item(buffer, free_wlen + 1);
 			buffer->wr_idx = idx_inc(buffer, buffer->wr_idx, rd_wlen);
@@ -193,9 +316,20 @@ void mpsc_pbuf_put_word(struct mpsc_pbuf_buffer *buffer,
 	union mpsc_pbuf_generic *dropped_item = NULL;
 	bool valid_drop;
 
+#ifdef CONFIG_MPSC_PBUF_LOCKFREE
+	unsigned int irq_key;
+	uint32_t idx;
+
+	if (reserve(buffer, 1, &idx, &irq_key)) {
+		buffer->buf[idx] = item.raw;
+		publish(buffer, idx, 1, irq_key);
+		return;
+	}
+#endif
+
 	do {
 		cont = false;
-		key = k_spin_lock(&buffer->lock);
+		key = wr_lock(buffer);
 		(void)free_space(buffer, &free_wlen);
 		if (free_wlen) {
 			buffer->buf[buffer->tmp_wr_idx] = item.raw;
@@ -210,7 +344,7 @@ void mpsc_pbuf_put_word(struct mpsc_pbuf_buffer *buffer,
 			cont = dropped_item != NULL;
 		}
 
-		k_spin_unlock(&buffer->lock, key);
+		wr_unlock(buffer, key);
 
 		if (cont && valid_drop) {
 			/* Notify about item being dropped. */
@@ -236,12 +370,27 @@ union mpsc_pbuf_generic *mpsc_pbuf_alloc(struct mpsc_pbuf_buffer *buffer,
 		return NULL;
 	}
 
-	do {
+	cont = true;
+
+#ifdef CONFIG_MPSC_PBUF_LOCKFREE
+	unsigned int irq_key;
+	uint32_t idx;
+
+	if (reserve(buffer, wlen, &idx, &irq_key)) {
+		item = (union mpsc_pbuf_generic *)&buffer->buf[idx];
+		item->hdr.valid = 0;
+		item->hdr.busy = 0;
+		publish(buffer, idx, wlen, irq_key);
+		cont = false;
+	}
+#endif
+
+	while (cont) {
 		k_spinlock_key_t key;
 		bool wrap;
 
 		cont = false;
-		key = k_spin_lock(&buffer->lock);
+		key = wr_lock(buffer);
 		wrap = free_space(buffer, &free_wlen);
 
 		if (free_wlen >= wlen) {
@@ -251,6 +400,9 @@ union mpsc_pbuf_generic *mpsc_pbuf_alloc(struct mpsc_pbuf_buffer *buffer,
 			item->hdr.busy = 0;
 			buffer->tmp_wr_idx = idx_inc(buffer,
 						     buffer->tmp_wr_idx, wlen);
+			if (IS_ENABLED(CONFIG_MPSC_PBUF_LOCKFREE)) {
+				buffer->wr_idx = buffer->tmp_wr_idx;
+			}
 		} else if (wrap) {
 			add_skip_item(buffer, free_wlen);
 			cont = true;
@@ -258,9 +410,9 @@ union mpsc_pbuf_generic *mpsc_pbuf_alloc(struct mpsc_pbuf_buffer *buffer,
 			   !k_is_in_isr()) {
 			int err;
 
-			k_spin_unlock(&buffer->lock, key);
+			wr_unlock(buffer, key);
 			err = k_sem_take(&buffer->sem, timeout);
-			key = k_spin_lock(&buffer->lock);
+			key = wr_lock(buffer);
 			if (err == 0) {
 				cont = true;
 			}
@@ -272,14 +424,14 @@ union mpsc_pbuf_generic *mpsc_pbuf_alloc(struct mpsc_pbuf_buffer *buffer,
 			cont = dropped_item != NULL;
 		}
 
-		k_spin_unlock(&buffer->lock, key);
+		wr_unlock(buffer, key);
 
 		if (cont && dropped_item && valid_drop) {
 			/* Notify about item being dropped. */
 			buffer->notify_drop(buffer, dropped_item);
 			dropped_item = NULL;
 		}
-	} while (cont);
+	}
 
 	MPSC_PBUF_DBG(buffer, "allocated %p ", item);
 
@@ -294,6 +446,13 @@ union mpsc_pbuf_generic *mpsc_pbuf_alloc(struct mpsc_pbuf_buffer *buffer,
 void mpsc_pbuf_commit(struct mpsc_pbuf_buffer *buffer,
 		       union mpsc_pbuf_generic *item)
 {
+#ifdef CONFIG_MPSC_PBUF_LOCKFREE
+	/* Published on allocation, the packet content must be visible
+	 * before the valid bit
+	 */
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	item->hdr.valid = 1;
+#else
 	uint32_t wlen = buffer->get_wlen(item);
 
 	k_spinlock_key_t key = k_spin_lock(&buffer->lock);
@@ -301,6 +460,7 @@ void mpsc_pbuf_commit(struct mpsc_pbuf_buffer *buffer,
 	item->hdr.valid = 1;
 	buffer->wr_idx = idx_inc(buffer, buffer->wr_idx, wlen);
 	k_spin_unlock(&buffer->lock, key);
+#endif
 	MPSC_PBUF_DBG(buffer, "committed %p ", item);
 }
 
@@ -314,13 +474,25 @@ void mpsc_pbuf_put_word_ext(struct mpsc_pbuf_buffer *buffer,
 	bool cont;
 	bool valid_drop;
 
+#ifdef CONFIG_MPSC_PBUF_LOCKFREE
+	unsigned int irq_key;
+	uint32_t idx;
+
+	if (reserve(buffer, l, &idx, &irq_key)) {
+		buffer->buf[idx] = item.raw;
+		*(void **)&buffer->buf[idx + 1] = (void *)data;
+		publish(buffer, idx, l, irq_key);
+		return;
+	}
+#endif
+
 	do {
 		k_spinlock_key_t key;
 		uint32_t free_wlen;
 		bool wrap;
 
 		cont = false;
-		key = k_spin_lock(&buffer->lock);
+		key = wr_lock(buffer);
 		wrap = free_space(buffer, &free_wlen);
 
 		if (free_wlen >= l) {
@@ -343,7 +515,7 @@ void mpsc_pbuf_put_word_ext(struct mpsc_pbuf_buffer *buffer,
 			cont = dropped_item != NULL;
 		}
 
-		k_spin_unlock(&buffer->lock, key);
+		wr_unlock(buffer, key);
 
 		if (cont && dropped_item && valid_drop) {
 			/* Notify about item being dropped. */
@@ -360,13 +532,24 @@ void mpsc_pbuf_put_data(struct mpsc_pbuf_buffer *buffer, const uint32_t *data,
 	union mpsc_pbuf_generic *dropped_item = NULL;
 	bool valid_drop;
 
+#ifdef CONFIG_MPSC_PBUF_LOCKFREE
+	unsigned int irq_key;
+	uint32_t idx;
+
+	if (reserve(buffer, wlen, &idx, &irq_key)) {
+		memcpy(&buffer->buf[idx], data, wlen * sizeof(uint32_t));
+		publish(buffer, idx, wlen, irq_key);
+		return;
+	}
+#endif
+
 	do {
 		uint32_t free_wlen;
 		k_spinlock_key_t key;
 		bool wrap;
 
 		cont = false;
-		key = k_spin_lock(&buffer->lock);
+		key = wr_lock(buffer);
 		wrap = free_space(buffer, &free_wlen);
 
 		if (free_wlen >= wlen) {
@@ -386,7 +569,7 @@ void mpsc_pbuf_put_data(struct mpsc_pbuf_buffer *buffer, const uint32_t *data,
 			cont = dropped_item != NULL;
 		}
 
-		k_spin_unlock(&buffer->lock, key);
+		wr_unlock(buffer, key);
 
 		if (cont && dropped_item && valid_drop) {
 			/* Notify about item being dropped. */
@@ -427,6 +610,10 @@ const union mpsc_pbuf_generic *mpsc_pbuf_claim(struct mpsc_pbuf_buffer *buffer)
 					idx_inc(buffer, buffer->rd_idx, inc);
 				cont = true;
 			} else {
+				if (IS_ENABLED(CONFIG_MPSC_PBUF_LOCKFREE)) {
+					/* Pairs with the fence of commit */
+					__atomic_thread_fence(__ATOMIC_ACQUIRE);
+				}
 				item->hdr.busy = 1;
 				buffer->tmp_rd_idx =
 					idx_inc(buffer, buffer->tmp_rd_idx,
@@ -471,3 +658,109 @@ bool mpsc_pbuf_is_pending(struct mpsc_pbuf_buffer *buffer)
 
 	return a ? true : false;
 }
+
+void mpsc_pbuf_percpu_init(struct mpsc_pbuf_percpu *pcbuf,
+			   const struct mpsc_pbuf_buffer_config *config,
+			   mpsc_pbuf_is_older is_older)
+{
+	struct mpsc_pbuf_buffer_config cpu_config = *config;
+
+	cpu_config.size = config->size / CONFIG_MP_NUM_CPUS;
+	/* Index masking only works if each piece is a power of two too,
+	 * mpsc_pbuf_init() sets the flag again if it is
+	 */
+	cpu_config.flags &= ~MPSC_PBUF_SIZE_POW2;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		cpu_config.buf = &config->buf[i * cpu_config.size];
+		mpsc_pbuf_init(&pcbuf->bufs[i], &cpu_config);
+		pcbuf->heads[i] = NULL;
+	}
+
+	pcbuf->is_older = is_older;
+	pcbuf->next = 0;
+}
+
+struct mpsc_pbuf_buffer *mpsc_pbuf_percpu_get(struct mpsc_pbuf_percpu *pcbuf)
+{
+	unsigned int key = arch_irq_lock();
+	uint32_t id = _current_cpu->id;
+
+	arch_irq_unlock(key);
+
+	return &pcbuf->bufs[id];
+}
+
+struct mpsc_pbuf_buffer *mpsc_pbuf_percpu_find(struct mpsc_pbuf_percpu *pcbuf,
+					       const union mpsc_pbuf_generic *packet)
+{
+	const uint32_t *p = (const uint32_t *)packet;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct mpsc_pbuf_buffer *buffer = &pcbuf->bufs[i];
+
+		if (p >= buffer->buf && p < &buffer->buf[buffer->size]) {
+			return buffer;
+		}
+	}
+
+	__ASSERT(0, "packet %p not in buffer", packet);
+
+	return NULL;
+}
+
+const union mpsc_pbuf_generic *
+mpsc_pbuf_percpu_claim(struct mpsc_pbuf_percpu *pcbuf)
+{
+	const union mpsc_pbuf_generic *item = NULL;
+	int oldest = -1;
+
+	if (pcbuf->is_older == NULL) {
+		for (int i = 0; i < CONFIG_MP_NUM_CPUS && item == NULL; i++) {
+			uint32_t cpu = pcbuf->next;
+
+			pcbuf->next = (cpu + 1) % CONFIG_MP_NUM_CPUS;
+			item = mpsc_pbuf_claim(&pcbuf->bufs[cpu]);
+		}
+
+		return item;
+	}
+
+	/* Keep the head of every buffer claimed, and return the oldest */
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if (pcbuf->heads[i] == NULL) {
+			pcbuf->heads[i] = mpsc_pbuf_claim(&pcbuf->bufs[i]);
+		}
+
+		if (pcbuf->heads[i] != NULL &&
+		    (oldest < 0 ||
+		     pcbuf->is_older(pcbuf->heads[i], pcbuf->heads[oldest]))) {
+			oldest = i;
+		}
+	}
+
+	if (oldest >= 0) {
+		item = pcbuf->heads[oldest];
+		pcbuf->heads[oldest] = NULL;
+	}
+
+	return item;
+}
+
+void mpsc_pbuf_percpu_free(struct mpsc_pbuf_percpu *pcbuf,
+			   union mpsc_pbuf_generic *packet)
+{
+	mpsc_pbuf_free(mpsc_pbuf_percpu_find(pcbuf, packet), packet);
+}
+
+bool mpsc_pbuf_percpu_is_pending(struct mpsc_pbuf_percpu *pcbuf)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if (pcbuf->heads[i] != NULL ||
+		    mpsc_pbuf_is_pending(&pcbuf->bufs[i])) {
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -70,11 +70,267 @@ static inline bool item_lessthan(struct k_p4wq_work *a, struct k_p4wq_work *b)
 	return false;
 }
 
+/* The item is done, its owner may reuse it as soon as it's signaled */
+static void item_complete(struct k_p4wq_work *w)
+{
+	struct k_p4wq_batch *batch = w->batch;
+
+	k_sem_give(&w->done_sem);
+
+	if (batch != NULL && atomic_dec(&batch->remaining) == 1) {
+		k_sem_give(&batch->done_sem);
+	}
+}
+
+#ifdef CONFIG_P4WQ_WORK_STEALING
+/*
+ * Work-stealing queues keep the items in per-thread deques, each with
+ * its own lock, so threads only contend when stealing.  The queue lock
+ * only guards the pending of idle threads on waitq.  A thread going
+ * idle increments queue->idle and then checks queue->pending, while
+ * submitters increment queue->pending and then check queue->idle: as
+ * both are atomic, either the thread sees the item or the submitter
+ * sees the idle thread and unpends it.
+ */
+static inline bool is_stealing(struct k_p4wq *queue)
+{
+	return (queue->flags & K_P4WQ_WORK_STEALING) != 0U;
+}
+
+static struct k_p4wq_deque *thread_deque(struct k_p4wq *queue,
+					 struct k_thread *th)
+{
+	for (uint32_t i = 0; i < queue->num_deques; i++) {
+		if (queue->deques[i].thread == th) {
+			return &queue->deques[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void deque_push(struct k_p4wq_deque *dq, struct k_p4wq_work *w)
+{
+	k_spinlock_key_t k = k_spin_lock(&dq->lock);
+
+	sys_dlist_append(&dq->items, &w->dlnode);
+	dq->count++;
+
+	k_spin_unlock(&dq->lock, k);
+}
+
+/* Newest first, its data is the most likely to still be cached */
+static struct k_p4wq_work *deque_pop(struct k_p4wq *queue,
+				     struct k_p4wq_deque *dq)
+{
+	struct k_p4wq_work *w = NULL;
+	k_spinlock_key_t k = k_spin_lock(&dq->lock);
+	sys_dnode_t *n = sys_dlist_peek_tail(&dq->items);
+
+	if (n != NULL) {
+		sys_dlist_remove(n);
+		dq->count--;
+		w = CONTAINER_OF(n, struct k_p4wq_work, dlnode);
+	}
+
+	k_spin_unlock(&dq->lock, k);
+
+	if (w != NULL) {
+		atomic_dec(&queue->pending);
+	}
+
+	return w;
+}
+
+/* Take the oldest half of the items of the first other thread that
+ * has some, run the first one and keep the others on our deque
+ */
+static struct k_p4wq_work *steal(struct k_p4wq *queue,
+				 struct k_p4wq_deque *dq)
+{
+	uint32_t self = dq - queue->deques;
+
+	for (uint32_t i = 1; i < queue->num_deques; i++) {
+		struct k_p4wq_deque *victim =
+			&queue->deques[(self + i) % queue->num_deques];
+		struct k_p4wq_work *w;
+		sys_dlist_t stolen;
+		uint32_t num;
+		k_spinlock_key_t k;
+
+		if (*(volatile uint32_t *)&victim->count == 0U) {
+			continue;
+		}
+
+		sys_dlist_init(&stolen);
+		k = k_spin_lock(&victim->lock);
+		num = (victim->count + 1) / 2;
+		for (uint32_t j = 0; j < num; j++) {
+			sys_dnode_t *n = sys_dlist_get(&victim->items);
+
+			sys_dlist_append(&stolen, n);
+		}
+		victim->count -= num;
+		k_spin_unlock(&victim->lock, k);
+
+		if (num == 0U) {
+			continue;
+		}
+
+		w = CONTAINER_OF(sys_dlist_get(&stolen), struct k_p4wq_work,
+				 dlnode);
+		atomic_dec(&queue->pending);
+
+		if (num > 1U) {
+			sys_dnode_t *n;
+
+			k = k_spin_lock(&dq->lock);
+			while ((n = sys_dlist_get(&stolen)) != NULL) {
+				sys_dlist_append(&dq->items, n);
+			}
+			dq->count += num - 1U;
+			k_spin_unlock(&dq->lock, k);
+		}
+
+		return w;
+	}
+
+	return NULL;
+}
+
+static struct k_p4wq_work *deque_next(struct k_p4wq *queue,
+				      struct k_p4wq_deque *dq)
+{
+	struct k_p4wq_work *w = deque_pop(queue, dq);
+
+	return w != NULL ? w : steal(queue, dq);
+}
+
+/* Runs an item on the current thread, which may already be running
+ * one whose handler waits in k_p4wq_wait_all()
+ */
+static void run_item(struct k_p4wq_work *w)
+{
+	struct k_thread *th = _current;
+	bool outer_requeued = thread_was_requeued(th);
+	int8_t outer_prio = th->base.prio;
+	int outer_deadline = th->base.prio_deadline;
+
+	w->thread = th;
+	set_prio(th, w);
+	thread_clear_requeued(th);
+
+	w->handler(w);
+
+	if (!thread_was_requeued(th)) {
+		w->thread = NULL;
+		item_complete(w);
+	}
+
+	if (outer_requeued) {
+		thread_set_requeued(th);
+	} else {
+		thread_clear_requeued(th);
+	}
+	th->base.prio = outer_prio;
+	th->base.prio_deadline = outer_deadline;
+}
+
+static FUNC_NORETURN void steal_loop(struct k_p4wq *queue,
+				     struct k_p4wq_deque *dq)
+{
+	while (true) {
+		struct k_p4wq_work *w = deque_next(queue, dq);
+
+		if (w != NULL) {
+			run_item(w);
+			continue;
+		}
+
+		k_spinlock_key_t k = k_spin_lock(&queue->lock);
+
+		atomic_inc(&queue->idle);
+		if (atomic_get(&queue->pending) > 0) {
+			atomic_dec(&queue->idle);
+			k_spin_unlock(&queue->lock, k);
+			continue;
+		}
+
+		/* The submitter unpending us decrements idle */
+		z_pend_curr(&queue->lock, k, &queue->waitq, K_FOREVER);
+	}
+}
+
+static void steal_submit(struct k_p4wq *queue, struct k_p4wq_work *item)
+{
+	struct k_p4wq_deque *dq = thread_deque(queue, _current);
+	k_spinlock_key_t k;
+	struct k_thread *th;
+
+	if (dq == NULL) {
+		uint32_t i = (uint32_t)atomic_inc(&queue->next_deque);
+
+		dq = &queue->deques[i % queue->num_deques];
+	}
+
+	deque_push(dq, item);
+	atomic_inc(&queue->pending);
+
+	if (atomic_get(&queue->idle) == 0) {
+		return;
+	}
+
+	k = k_spin_lock(&queue->lock);
+	th = z_unpend_first_thread(&queue->waitq);
+	if (th == NULL) {
+		k_spin_unlock(&queue->lock, k);
+		return;
+	}
+
+	atomic_dec(&queue->idle);
+	set_prio(th, item);
+	z_ready_thread(th);
+	z_reschedule(&queue->lock, k);
+}
+
+static bool steal_cancel(struct k_p4wq *queue, struct k_p4wq_work *item)
+{
+	for (uint32_t i = 0; i < queue->num_deques; i++) {
+		struct k_p4wq_deque *dq = &queue->deques[i];
+		k_spinlock_key_t k = k_spin_lock(&dq->lock);
+		sys_dnode_t *n;
+
+		SYS_DLIST_FOR_EACH_NODE(&dq->items, n) {
+			if (n == &item->dlnode) {
+				sys_dlist_remove(n);
+				dq->count--;
+				k_spin_unlock(&dq->lock, k);
+				atomic_dec(&queue->pending);
+				item_complete(item);
+				return true;
+			}
+		}
+
+		k_spin_unlock(&dq->lock, k);
+	}
+
+	return false;
+}
+#endif /* CONFIG_P4WQ_WORK_STEALING */
+
 static FUNC_NORETURN void p4wq_loop(void *p0, void *p1, void *p2)
 {
-	ARG_UNUSED(p1);
 	ARG_UNUSED(p2);
 	struct k_p4wq *queue = p0;
+
+#ifdef CONFIG_P4WQ_WORK_STEALING
+	if (p1 != NULL) {
+		steal_loop(queue, p1);
+	}
+#else
+	ARG_UNUSED(p1);
+#endif
+
 	k_spinlock_key_t k = k_spin_lock(&queue->lock);
 
 	while (true) {
@@ -102,7 +358,7 @@ static FUNC_NORETURN void p4wq_loop(void *p0, void *p1, void *p2)
 			if (!thread_was_requeued(_current)) {
 				sys_dlist_remove(&w->dlnode);
 				w->thread = NULL;
-				k_sem_give(&w->done_sem);
+				item_complete(w);
 			}
 		} else {
 			z_pend_curr(&queue->lock, k, &queue->waitq, K_FOREVER);
@@ -133,6 +389,38 @@ void k_p4wq_add_thread(struct k_p4wq *queue, struct k_thread *thread,
 			k_thread_stack_t *stack,
 			size_t stack_size)
 {
+#ifdef CONFIG_P4WQ_WORK_STEALING
+	if (is_stealing(queue)) {
+		struct k_p4wq_deque *dq = thread_deque(queue, thread);
+
+		/* Only the static threads of the queue have deques */
+		__ASSERT_NO_MSG(dq != NULL);
+
+		k_thread_create(thread, stack, stack_size,
+				p4wq_loop, queue, dq, NULL,
+				K_HIGHEST_THREAD_PRIO, 0, K_FOREVER);
+
+#ifdef CONFIG_SCHED_CPU_MASK
+		if (!(queue->flags & K_P4WQ_USER_CPU_MASK)) {
+			int cpu = (dq - queue->deques) % CONFIG_MP_NUM_CPUS;
+			int ret = k_thread_cpu_mask_clear(thread);
+
+			if (ret == 0) {
+				ret = k_thread_cpu_mask_enable(thread, cpu);
+			}
+			if (ret < 0) {
+				LOG_ERR("Couldn't pin to CPU %d: %d", cpu, ret);
+			}
+		}
+#endif
+
+		if (!(queue->flags & K_P4WQ_DELAYED_START)) {
+			k_thread_start(thread);
+		}
+		return;
+	}
+#endif
+
 	k_thread_create(thread, stack, stack_size,
 			p4wq_loop, queue, NULL, NULL,
 			K_HIGHEST_THREAD_PRIO, 0,
@@ -155,6 +443,21 @@ static int static_init(const struct device *dev)
 
 			q->flags = pp->flags;
 
+#ifdef CONFIG_P4WQ_WORK_STEALING
+			if (pp->flags & K_P4WQ_WORK_STEALING) {
+				struct k_p4wq_deque *dq = &pp->deques[i];
+
+				__ASSERT_NO_MSG(!(pp->flags & K_P4WQ_QUEUE_PER_THREAD));
+				q->deques = pp->deques;
+				q->num_deques = pp->num;
+				sys_dlist_init(&dq->items);
+				dq->thread = &pp->threads[i];
+			}
+#else
+			__ASSERT(!(pp->flags & K_P4WQ_WORK_STEALING),
+				 "CONFIG_P4WQ_WORK_STEALING is disabled");
+#endif
+
 			/*
 			 * If the user wants to specify CPU affinity, we have to
 			 * delay starting threads until that has been done
@@ -214,8 +517,30 @@ void k_p4wq_enable_static_thread(struct k_p4wq *queue, struct k_thread *thread,
  */
 SYS_INIT(static_init, APPLICATION, 99);
 
-void k_p4wq_submit(struct k_p4wq *queue, struct k_p4wq_work *item)
+static void submit(struct k_p4wq *queue, struct k_p4wq_work *item,
+		   struct k_p4wq_batch *batch)
 {
+#ifdef CONFIG_P4WQ_WORK_STEALING
+	if (is_stealing(queue)) {
+		item->deadline += k_cycle_get_32();
+
+		/* Resubmission from within handler?  Not on a deque,
+		 * just don't complete it
+		 */
+		if (item->thread == _current) {
+			thread_set_requeued(_current);
+			item->thread = NULL;
+		} else {
+			k_sem_init(&item->done_sem, 0, 1);
+			item->batch = batch;
+		}
+		item->queue = queue;
+
+		steal_submit(queue, item);
+		return;
+	}
+#endif
+
 	k_spinlock_key_t k = k_spin_lock(&queue->lock);
 
 	/* Input is a delta time from now (to match
@@ -231,6 +556,7 @@ void k_p4wq_submit(struct k_p4wq *queue, struct k_p4wq_work *item)
 		item->thread = NULL;
 	} else {
 		k_sem_init(&item->done_sem, 0, 1);
+		item->batch = batch;
 	}
 	__ASSERT_NO_MSG(item->thread == NULL);
 
@@ -291,14 +617,59 @@ out:
 	k_spin_unlock(&queue->lock, k);
 }
 
+void k_p4wq_submit(struct k_p4wq *queue, struct k_p4wq_work *item)
+{
+	submit(queue, item, NULL);
+}
+
+void k_p4wq_submit_batch(struct k_p4wq *queue, struct k_p4wq_batch *batch,
+			 struct k_p4wq_work **items, size_t num)
+{
+	atomic_set(&batch->remaining, (atomic_val_t)num);
+	k_sem_init(&batch->done_sem, num == 0 ? 1 : 0, 1);
+
+	for (size_t i = 0; i < num; i++) {
+		submit(queue, items[i], batch);
+	}
+}
+
+int k_p4wq_wait_all(struct k_p4wq *queue, struct k_p4wq_batch *batch,
+		    k_timeout_t timeout)
+{
+#ifdef CONFIG_P4WQ_WORK_STEALING
+	struct k_p4wq_deque *dq = is_stealing(queue) ?
+		thread_deque(queue, _current) : NULL;
+
+	/* On one of the queue threads: help rather than block it */
+	while (dq != NULL && atomic_get(&batch->remaining) != 0) {
+		struct k_p4wq_work *w = deque_next(queue, dq);
+
+		if (w == NULL) {
+			break;
+		}
+		run_item(w);
+	}
+#else
+	ARG_UNUSED(queue);
+#endif
+
+	return k_sem_take(&batch->done_sem, timeout);
+}
+
 bool k_p4wq_cancel(struct k_p4wq *queue, struct k_p4wq_work *item)
 {
+#ifdef CONFIG_P4WQ_WORK_STEALING
+	if (is_stealing(queue)) {
+		return steal_cancel(queue, item);
+	}
+#endif
+
 	k_spinlock_key_t k = k_spin_lock(&queue->lock);
 	bool ret = rb_contains(&queue->queue, &item->rbnode);
 
 	if (ret) {
 		rb_remove(&queue->queue, &item->rbnode);
-		k_sem_give(&item->done_sem);
+		item_complete(item);
 	}
 
 	k_spin_unlock(&queue->lock, k);
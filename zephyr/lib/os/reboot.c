@@ -13,7 +13,10 @@ extern void sys_clock_disable(void);
 
 FUNC_NORETURN void sys_reboot(int type)
 {
-	(void)irq_lock();
+	/* Only this CPU has to stop taking interrupts, there is no point
+	 * in waiting for the SMP global lock
+	 */
+	(void)arch_irq_lock();
 #ifdef CONFIG_SYS_CLOCK_EXISTS
 	sys_clock_disable();
 #endif
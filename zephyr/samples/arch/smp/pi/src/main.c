@@ -77,16 +77,27 @@ void test_thread(void *arg1, void *arg2, void *arg3)
 	atomic_dec(counter);
 }
 
+/* The 64-bit counter doesn't wrap around during long runs */
+static inline uint64_t cycles_get(void)
+{
+#ifdef CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER
+	return k_cycle_get_64();
+#else
+	return k_cycle_get_32();
+#endif
+}
+
 void main(void)
 {
-	uint32_t start_time, stop_time, cycles_spent, nanoseconds_spent;
+	uint64_t start_time, stop_time, cycles_spent;
+	uint32_t nanoseconds_spent;
 	int i;
 
 	printk("Calculate first %d digits of Pi independently by %d threads.\n",
 	       DIGITS_NUM, THREADS_NUM);
 
 	/* Capture initial time stamp */
-	start_time = k_cycle_get_32();
+	start_time = cycles_get();
 
 	for (i = 0; i < THREADS_NUM; i++) {
 		k_thread_create(&tthread[i], tstack[i], STACK_SIZE,
@@ -100,14 +111,19 @@ void main(void)
 		k_sleep(K_MSEC(1));
 
 	/* Capture final time stamp */
-	stop_time = k_cycle_get_32();
+	stop_time = cycles_get();
 
 	cycles_spent = stop_time - start_time;
+#ifndef CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER
+	/* Account for a wraparound of the 32-bit counter */
+	cycles_spent = (uint32_t)cycles_spent;
+#endif
 	nanoseconds_spent = (uint32_t)k_cyc_to_ns_floor64(cycles_spent);
 
 	for (i = 0; i < THREADS_NUM; i++)
 		printk("Pi value calculated by thread #%d: %s\n", i, buffer[i]);
 
-	printk("All %d threads executed by %d cores in %d msec\n", THREADS_NUM,
-	       CORES_NUM, nanoseconds_spent / 1000 / 1000);
+	printk("All %d threads executed by %d cores in %d msec (%llu cycles)\n",
+	       THREADS_NUM, CORES_NUM, nanoseconds_spent / 1000 / 1000,
+	       cycles_spent);
 }
@@ -0,0 +1,122 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2021 Microchip Inc.
+#
+# SPDX-License-Identifier: Apache-2.0
+"""
+Generate lib/os/crc_tables.c, the lookup tables of the table driven CRC
+implementations selected in lib/os/Kconfig.
+
+Row k of a CRC32 table gives the CRC of a byte followed by k zero bytes,
+which is what slicing-by-4 and slicing-by-8 fold with. Rows past the
+first are only compiled in when the configuration uses them.
+
+    ./scripts/gen_crc_tables.py > lib/os/crc_tables.c
+"""
+
+import sys
+
+CRC32_ROWS = 8
+
+HEADER = """\
+/*
+ * Copyright (c) 2021 Microchip Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/* Generated by scripts/gen_crc_tables.py, do not edit */
+
+#include "crc_tables.h"
+
+#if CRC_TABLE_ROWS > 0
+"""
+
+FOOTER = """\
+#endif /* CRC_TABLE_ROWS > 0 */
+"""
+
+
+def reflected_table(poly):
+    """Table of a CRC shifted out least significant bit first."""
+    table = []
+    for n in range(256):
+        crc = n
+        for _ in range(8):
+            crc = (crc >> 1) ^ (poly if crc & 1 else 0)
+        table.append(crc)
+    return table
+
+
+def normal_table(poly, width):
+    """Table of a CRC shifted out most significant bit first."""
+    top = 1 << (width - 1)
+    mask = (1 << width) - 1
+    table = []
+    for n in range(256):
+        crc = n << (width - 8)
+        for _ in range(8):
+            crc = ((crc << 1) ^ (poly if crc & top else 0)) & mask
+        table.append(crc)
+    return table
+
+
+def slicing_rows(table):
+    rows = [table]
+    for _ in range(1, CRC32_ROWS):
+        prev = rows[-1]
+        rows.append([(c >> 8) ^ table[c & 0xff] for c in prev])
+    return rows
+
+
+def emit_values(out, values, width, indent):
+    digits = width // 4
+    per_line = 4 if width == 32 else 8
+    for i in range(0, len(values), per_line):
+        line = ", ".join(f"0x{v:0{digits}x}" for v in values[i:i + per_line])
+        out.write(f"{indent}{line},\n")
+
+
+def emit_crc32(out, name, comment, poly):
+    rows = slicing_rows(reflected_table(poly))
+
+    out.write(f"\n/* {comment} */\n")
+    out.write(f"const uint32_t {name}[CRC_TABLE_ROWS][256] = {{\n")
+    for k, row in enumerate(rows):
+        if k == 1:
+            out.write("#if CRC_TABLE_ROWS > 1\n")
+        elif k == 4:
+            out.write("#endif\n#if CRC_TABLE_ROWS > 4\n")
+        out.write("\t{\n")
+        emit_values(out, row, 32, "\t\t")
+        out.write("\t},\n")
+    out.write("#endif\n};\n")
+
+
+def emit_table(out, name, comment, ctype, width, table):
+    out.write(f"\n/* {comment} */\n")
+    out.write(f"const {ctype} {name}[256] = {{\n")
+    emit_values(out, table, width, "\t")
+    out.write("};\n")
+
+
+def main():
+    out = sys.stdout
+
+    out.write(HEADER)
+    emit_crc32(out, "crc32_ieee_table", "Polynomial 0x04c11db7, reflected",
+               0xedb88320)
+    emit_crc32(out, "crc32c_table",
+               "Polynomial 0x1edc6f41 (Castagnoli), reflected", 0x82f63b78)
+    emit_table(out, "crc16_ccitt_table", "Polynomial 0x1021, reflected",
+               "uint16_t", 16, reflected_table(0x8408))
+    emit_table(out, "crc16_itu_t_table", "Polynomial 0x1021",
+               "uint16_t", 16, normal_table(0x1021, 16))
+    emit_table(out, "crc8_ccitt_table", "Polynomial 0x07",
+               "uint8_t", 8, normal_table(0x07, 8))
+    out.write("\n")
+    out.write(FOOTER)
+
+
+if __name__ == "__main__":
+    main()
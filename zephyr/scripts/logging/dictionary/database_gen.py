@@ -187,6 +187,11 @@ def process_kconfigs(elf, database):
         database.add_kconfig("CONFIG_LOG_TIMESTAMP_64BIT",
                              kconfigs['CONFIG_LOG_TIMESTAMP_64BIT'])
 
+    # Are log records framed?
+    if "CONFIG_LOG_DICTIONARY_FRAMED" in kconfigs:
+        database.add_kconfig("CONFIG_LOG_DICTIONARY_FRAMED",
+                             kconfigs['CONFIG_LOG_DICTIONARY_FRAMED'])
+
 
 def extract_static_string_sections(elf, database):
     """Extract sections containing static strings"""
@@ -11,6 +11,7 @@ This contains the implementation of the parser for
 version 1 databases.
 """
 
+import binascii
 import logging
 import math
 import struct
@@ -56,6 +57,21 @@ MSG_TYPE_DROPPED = 1
 # Number of dropped messages
 FMT_DROPPED_CNT = "H"
 
+# Need to keep sync with struct log_dict_output_frame_hdr_t in
+# include/logging/log_output_dict.h, used if CONFIG_LOG_DICTIONARY_FRAMED.
+#
+# struct log_dict_output_frame_hdr_t {
+#     uint8_t sync[2];
+#     uint16_t len;
+# } __packed;
+#
+# The record follows, then the 16-bit frame check sequence which is
+# the CRC-16/CCITT-FALSE of "len" and the record.
+FRAME_SYNC = b'\xa5\x5a'
+FMT_FRAME_LEN = "H"
+FMT_FRAME_FCS = "H"
+FRAME_FCS_INIT = 0xFFFF
+
 
 logger = logging.getLogger("parser")
 
@@ -101,14 +117,19 @@ class DataTypes():
 
         if database.is_tgt_64bit():
             self.add_data_type(self.LONG, "q")
+            self.add_data_type(self.ULONG, "Q")
             self.add_data_type(self.LONG_LONG, "q")
+            self.add_data_type(self.ULONG_LONG, "Q")
             self.add_data_type(self.PTR, "Q")
         else:
             self.add_data_type(self.LONG, "i")
+            self.add_data_type(self.ULONG, "I")
             self.add_data_type(self.LONG_LONG, "q")
+            self.add_data_type(self.ULONG_LONG, "Q")
             self.add_data_type(self.PTR, "I")
 
         self.add_data_type(self.INT, "i")
+        self.add_data_type(self.UINT, "I")
         self.add_data_type(self.DOUBLE, "d")
         self.add_data_type(self.LONG_DOUBLE, "d")
 
@@ -169,6 +190,8 @@ class LogParserV1(LogParser):
 
         self.fmt_msg_type = endian + FMT_MSG_TYPE
         self.fmt_dropped_cnt = endian + FMT_DROPPED_CNT
+        self.fmt_frame_len = endian + FMT_FRAME_LEN
+        self.fmt_frame_fcs = endian + FMT_FRAME_FCS
 
         if self.database.is_tgt_64bit():
             self.fmt_msg_hdr = endian + FMT_MSG_HDR_64
@@ -180,6 +203,8 @@ class LogParserV1(LogParser):
         else:
             self.fmt_msg_timestamp = endian + FMT_MSG_TIMESTAMP_32
 
+        self.framed = "CONFIG_LOG_DICTIONARY_FRAMED" in self.database.get_kconfigs()
+
         self.data_types = DataTypes(self.database)
 
 
@@ -237,13 +262,19 @@ class LogParserV1(LogParser):
                 arg_data_type = DataTypes.LONG
 
             elif fmt in ('c', 'd', 'i', 'o', 'u') or str.lower(fmt) == 'x':
+                # Unsigned conversions must not be sign extended
+                is_unsigned = fmt in ('o', 'u') or str.lower(fmt) == 'x'
+
                 if fmt_str[idx - 1] == 'l':
                     if fmt_str[idx - 2] == 'l':
-                        arg_data_type = DataTypes.LONG_LONG
+                        arg_data_type = DataTypes.ULONG_LONG if is_unsigned \
+                                        else DataTypes.LONG_LONG
                     else:
-                        arg_data_type = DataTypes.LONG
+                        arg_data_type = DataTypes.ULONG if is_unsigned \
+                                        else DataTypes.LONG
                 else:
-                    arg_data_type = DataTypes.INT
+                    arg_data_type = DataTypes.UINT if is_unsigned \
+                                    else DataTypes.INT
 
                 is_parsing = False
                 do_extract = True
@@ -422,30 +453,90 @@ class LogParserV1(LogParser):
         return next_msg_offset
 
 
-    def parse_log_data(self, logdata, debug=False):
-        """Parse binary log data and print the encoded log messages"""
+    def parse_one_record(self, logdata, offset):
+        """Parse one log record and print it, returning the offset of
+        the next record or None on error"""
+        # Get message type
+        msg_type = struct.unpack_from(self.fmt_msg_type, logdata, offset)[0]
+        offset += struct.calcsize(self.fmt_msg_type)
+
+        if msg_type == MSG_TYPE_DROPPED:
+            num_dropped = struct.unpack_from(self.fmt_dropped_cnt, logdata, offset)
+            offset += struct.calcsize(self.fmt_dropped_cnt)
+
+            print("--- %d messages dropped ---" % num_dropped)
+
+            return offset
+
+        if msg_type == MSG_TYPE_NORMAL:
+            return self.parse_one_normal_msg(logdata, offset)
+
+        logger.error("------ Unknown message type: %s", msg_type)
+        return None
+
+
+    def parse_framed_log_data(self, logdata):
+        """Parse framed binary log data and print the encoded log messages.
+
+        Data between frames is skipped. A frame failing the check is
+        reported, and parsing resumes with the next sync bytes."""
         offset = 0
+        ret = True
 
-        while offset < len(logdata):
-            # Get message type
-            msg_type = struct.unpack_from(self.fmt_msg_type, logdata, offset)[0]
-            offset += struct.calcsize(self.fmt_msg_type)
+        hdr_len = len(FRAME_SYNC) + struct.calcsize(self.fmt_frame_len)
+        fcs_len = struct.calcsize(self.fmt_frame_fcs)
 
-            if msg_type == MSG_TYPE_DROPPED:
-                num_dropped = struct.unpack_from(self.fmt_dropped_cnt, logdata, offset)
-                offset += struct.calcsize(self.fmt_dropped_cnt)
+        while True:
+            frame = logdata.find(FRAME_SYNC, offset)
+            if frame < 0:
+                break
 
-                print("--- %d messages dropped ---" % num_dropped)
+            if frame != offset:
+                logger.debug("------ Skipped %d bytes at offset %d", frame - offset, offset)
 
-            elif msg_type == MSG_TYPE_NORMAL:
-                ret = self.parse_one_normal_msg(logdata, offset)
-                if ret is None:
-                    return False
+            if frame + hdr_len + fcs_len > len(logdata):
+                logger.debug("------ Truncated frame at offset %d", frame)
+                break
 
-                offset = ret
+            rec_len = struct.unpack_from(self.fmt_frame_len, logdata,
+                                         frame + len(FRAME_SYNC))[0]
+            rec_start = frame + hdr_len
+            rec_end = rec_start + rec_len
 
-            else:
-                logger.error("------ Unknown message type: %s", msg_type)
+            if rec_end + fcs_len > len(logdata):
+                # Either the log data was cut short or the length is
+                # corrupted, look for a frame further on.
+                logger.debug("------ Truncated frame at offset %d", frame)
+                offset = frame + 1
+                continue
+
+            fcs = struct.unpack_from(self.fmt_frame_fcs, logdata, rec_end)[0]
+            if binascii.crc_hqx(logdata[(frame + len(FRAME_SYNC)):rec_end],
+                                FRAME_FCS_INIT) != fcs:
+                logger.error("------ Frame check failed at offset %d", frame)
+                ret = False
+                offset = frame + 1
+                continue
+
+            if self.parse_one_record(logdata[rec_start:rec_end], 0) != rec_len:
+                logger.error("------ Malformed record at offset %d", rec_start)
+                ret = False
+
+            offset = rec_end + fcs_len
+
+        return ret
+
+
+    def parse_log_data(self, logdata, debug=False):
+        """Parse binary log data and print the encoded log messages"""
+        if self.framed:
+            return self.parse_framed_log_data(logdata)
+
+        offset = 0
+
+        while offset < len(logdata):
+            offset = self.parse_one_record(logdata, offset)
+            if offset is None:
                 return False
 
         return True
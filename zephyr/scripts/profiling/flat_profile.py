@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2021 Microchip Inc.
+#
+# SPDX-License-Identifier: Apache-2.0
+"""
+Turn the output of sampling_profiler_dump() into a flat profile.
+
+Capture the console of a target built with CONFIG_SAMPLING_PROFILER,
+then resolve the sampled program counters against the image:
+
+    ./scripts/profiling/flat_profile.py build/zephyr/zephyr.elf console.log
+
+With --folded, print one "cpuN;function count" line per function and
+CPU instead, which flamegraph.pl and similar tools accept. The profiler
+does not unwind the stack, so each stack is a single frame below its
+CPU.
+
+With event counters configured, each sample carries the counter
+increments since the previous sample of its CPU; --weight N uses those
+of event N instead of the sample count.
+"""
+
+import argparse
+import bisect
+import collections
+import re
+import sys
+
+try:
+    from elftools.elf.elffile import ELFFile
+    from elftools.elf.sections import SymbolTableSection
+except ImportError:
+    sys.exit("Missing dependency: You need to install pyelftools.")
+
+SAMPLE_RE = re.compile(r"prof: (\d+) 0x([0-9a-fA-F]+)((?: \d+)*)\s*$")
+DROPPED_RE = re.compile(r"prof: cpu (\d+) dropped (\d+)")
+
+UNKNOWN = "[unknown]"
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+            description=__doc__,
+            formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="zephyr.elf of the profiled image")
+    parser.add_argument("log", nargs="?", default="-",
+            help="console output holding the dump (default: stdin)")
+    parser.add_argument("-f", "--folded", action="store_true",
+            help="print folded stacks for flame graph tools")
+    parser.add_argument("-w", "--weight", type=int, metavar="N",
+            help="weigh samples by the increments of event N")
+    parser.add_argument("-c", "--cpu", type=int,
+            help="only count the samples of this CPU")
+    return parser.parse_args()
+
+
+class Symbols:
+    """Function symbols of an ELF file, looked up by address."""
+
+    def __init__(self, path):
+        funcs = {}
+
+        with open(path, "rb") as f:
+            elf = ELFFile(f)
+            for section in elf.iter_sections():
+                if not isinstance(section, SymbolTableSection):
+                    continue
+                for sym in section.iter_symbols():
+                    if sym["st_info"]["type"] != "STT_FUNC":
+                        continue
+                    funcs[sym["st_value"]] = (sym["st_size"], sym.name)
+
+        self.starts = sorted(funcs)
+        self.funcs = [funcs[addr] for addr in self.starts]
+
+    def lookup(self, addr):
+        i = bisect.bisect_right(self.starts, addr) - 1
+        if i < 0:
+            return UNKNOWN
+
+        size, name = self.funcs[i]
+        if addr >= self.starts[i] + max(size, 1):
+            return UNKNOWN
+        return name
+
+
+def read_samples(stream):
+    """Return the (cpu, pc, events) samples and the drops per CPU."""
+    dropped = {}
+    samples = []
+
+    for line in stream:
+        m = SAMPLE_RE.search(line)
+        if m:
+            events = [int(e) for e in m.group(3).split()]
+            samples.append((int(m.group(1)), int(m.group(2), 16), events))
+            continue
+        m = DROPPED_RE.search(line)
+        if m:
+            cpu = int(m.group(1))
+            dropped[cpu] = dropped.get(cpu, 0) + int(m.group(2))
+
+    return samples, dropped
+
+
+def main():
+    args = parse_args()
+    symbols = Symbols(args.elf)
+
+    if args.log == "-":
+        samples, dropped = read_samples(sys.stdin)
+    else:
+        with open(args.log, errors="replace") as f:
+            samples, dropped = read_samples(f)
+
+    per_func = collections.Counter()
+    per_stack = collections.Counter()
+    total = 0
+
+    for cpu, pc, events in samples:
+        if args.cpu is not None and cpu != args.cpu:
+            continue
+        if args.weight is None:
+            weight = 1
+        elif args.weight < len(events):
+            weight = events[args.weight]
+        else:
+            sys.exit(f"Samples only have {len(events)} event(s)")
+
+        func = symbols.lookup(pc)
+        per_func[func] += weight
+        per_stack[f"cpu{cpu};{func}"] += weight
+        total += weight
+
+    if args.folded:
+        for stack, weight in sorted(per_stack.items()):
+            print(f"{stack} {weight}")
+        return
+
+    unit = "samples" if args.weight is None else f"event {args.weight}"
+    print(f"{len(samples)} samples, {sum(dropped.values())} dropped")
+    print(f"{'%':>6} {unit:>12}  function")
+    for func, weight in per_func.most_common():
+        pct = 100.0 * weight / total if total else 0.0
+        print(f"{pct:6.2f} {weight:12}  {func}")
+
+
+if __name__ == "__main__":
+    main()
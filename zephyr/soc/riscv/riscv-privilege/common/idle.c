@@ -14,11 +14,16 @@
 static ALWAYS_INLINE void riscv_idle(unsigned int key)
 {
 	sys_trace_idle();
-	/* unlock interrupts */
-	irq_unlock(key);
 
-	/* Wait for interrupt */
+	/* Wait for interrupt. This is done with interrupts still locked:
+	 * a pending interrupt wakes the hart up regardless of mstatus.MIE,
+	 * while unlocking first could take the wakeup interrupt before the
+	 * wfi and then sleep until the next one.
+	 */
 	__asm__ volatile("wfi");
+
+	/* unlock interrupts */
+	irq_unlock(key);
 }
 
 /**
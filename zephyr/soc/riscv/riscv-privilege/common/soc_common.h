@@ -17,6 +17,9 @@
 #define RISCV_MACHINE_TIMER_IRQ      7  /* Machine Timer Interrupt */
 #define RISCV_MACHINE_EXT_IRQ        11 /* Machine External Interrupt */
 
+/* Illegal instruction exception number */
+#define SOC_MCAUSE_ILLEGAL_INSN_EXP  2
+
 /* ECALL Exception numbers */
 #define SOC_MCAUSE_ECALL_EXP         11 /* Machine ECALL instruction */
 #define SOC_MCAUSE_USER_ECALL_EXP    8  /* User ECALL instruction */
@@ -49,6 +52,9 @@ void riscv_plic_irq_disable(uint32_t irq);
 int riscv_plic_irq_is_enabled(uint32_t irq);
 void riscv_plic_set_priority(uint32_t irq, uint32_t priority);
 int riscv_plic_get_irq(void);
+#if defined(CONFIG_PLIC_PER_HART_CONTEXT)
+int riscv_plic_irq_set_affinity(uint32_t irq, uint32_t cpu_mask);
+#endif
 #endif
 
 #endif /* !_ASMLANGUAGE */
@@ -10,6 +10,7 @@
 	  privileged architecture specification
  */
 #include <irq.h>
+#include <errno.h>
 
 void arch_irq_enable(unsigned int irq)
 {
@@ -89,6 +90,18 @@ int arch_irq_is_enabled(unsigned int irq)
 	return !!(mie & (1 << irq));
 }
 
+#if defined(CONFIG_PLIC_PER_HART_CONTEXT)
+int arch_irq_set_affinity(unsigned int irq, uint32_t cpu_mask)
+{
+	/* Local interrupts are always taken by the hart raising them */
+	if (irq_get_level(irq) != 2) {
+		return -ENOTSUP;
+	}
+
+	return riscv_plic_irq_set_affinity(irq_from_level_2(irq), cpu_mask);
+}
+#endif
+
 #if defined(CONFIG_RISCV_SOC_INTERRUPT_INIT)
 __weak void soc_interrupt_init(void)
 {
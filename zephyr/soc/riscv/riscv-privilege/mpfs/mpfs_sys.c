@@ -30,6 +30,10 @@ static int pre_mpfs_init(const struct device *dev)
     /* Remove soft reset */
    SYSREG->SOFT_RESET_CR  &= ~(SOFT_RESET_CR_MMUART0_MASK | SOFT_RESET_CR_GPIO2_MASK | SOFT_RESET_CR_TIMER_MASK);
    SYSREG->SUBBLK_CLOCK_CR = 0xffffffff;
+#ifdef CONFIG_ETH_XLNX_GEM
+   /* MSS MACs are clocked now, take them out of reset */
+   SYSREG->SOFT_RESET_CR  &= ~(SOFT_RESET_CR_MAC0_MASK | SOFT_RESET_CR_MAC1_MASK);
+#endif
 }
 
 static int mpfs_init(const struct device *dev)
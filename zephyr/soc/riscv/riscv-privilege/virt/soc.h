@@ -13,5 +13,6 @@
 #define SIFIVE_SYSCON_TEST           0x00100000
 #define RISCV_MTIME_BASE             0x0200BFF8
 #define RISCV_MTIMECMP_BASE          0x02004000
+#define RISCV_MTIMECMP_BY_HART(h)    (0x02004000ULL + (8ULL * (h)))
 
 #endif
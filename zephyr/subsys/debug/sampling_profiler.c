@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2021 Microchip Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Sampling profiler
+ *
+ * Each CPU stores its own samples, from its sampling interrupt, into its
+ * own ring buffer. Readers on any CPU remove records from the other end,
+ * so each ring has a single producer and the tail is only moved under
+ * the reader lock.
+ */
+
+#include <kernel.h>
+#include <sys/atomic.h>
+#include <sys/printk.h>
+#include <debug/sampling_profiler.h>
+
+#define NUM_RECORDS CONFIG_SAMPLING_PROFILER_BUF_RECORDS
+#define NUM_EVENTS CONFIG_SAMPLING_PROFILER_EVENTS
+
+/* One slot is kept empty to tell a full ring from an empty one */
+struct profiler_buf {
+	/* Next record written, only moved by the owning CPU */
+	atomic_t head;
+	/* Next record read, only moved under read_lock */
+	atomic_t tail;
+	atomic_t dropped;
+#if NUM_EVENTS > 0
+	/* Raw counters at the previous sample, valid once primed */
+	uint32_t last[NUM_EVENTS];
+	bool primed;
+#endif
+	struct sampling_profiler_record records[NUM_RECORDS];
+} __aligned(64);
+
+/* Not static, so that a debugger can pull the samples from RAM */
+struct profiler_buf z_sampling_profiler_bufs[CONFIG_MP_NUM_CPUS];
+
+static struct k_spinlock read_lock;
+static struct k_spinlock state_lock;
+static bool running;
+static uint32_t period;
+
+void z_sampling_profiler_record(uintptr_t pc, const uint32_t *events)
+{
+	struct profiler_buf *buf = &z_sampling_profiler_bufs[arch_curr_cpu()->id];
+	uint32_t head = (uint32_t)atomic_get(&buf->head);
+	uint32_t next = (head + 1U) % NUM_RECORDS;
+	struct sampling_profiler_record *rec = &buf->records[head];
+	bool full = (next == (uint32_t)atomic_get(&buf->tail));
+
+#if NUM_EVENTS > 0
+	/* Keep following the counters through dropped samples, so that
+	 * their increments are not charged to the next recorded one
+	 */
+	for (int i = 0; i < NUM_EVENTS; i++) {
+		if (!full) {
+			rec->events[i] = buf->primed ?
+					 events[i] - buf->last[i] : 0U;
+		}
+		buf->last[i] = events[i];
+	}
+	buf->primed = true;
+#else
+	ARG_UNUSED(events);
+#endif
+
+	if (full) {
+		(void)atomic_inc(&buf->dropped);
+		return;
+	}
+
+	rec->pc = pc;
+
+	/* Publish the record only once it is complete */
+	(void)atomic_set(&buf->head, next);
+}
+
+int sampling_profiler_start(uint32_t period_us)
+{
+	k_spinlock_key_t key;
+
+	if (period_us == 0U) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&state_lock);
+	if (running) {
+		k_spin_unlock(&state_lock, key);
+		return -EALREADY;
+	}
+
+	for (int cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+		atomic_clear(&z_sampling_profiler_bufs[cpu].dropped);
+#if NUM_EVENTS > 0
+		z_sampling_profiler_bufs[cpu].primed = false;
+#endif
+	}
+
+	period = period_us;
+	running = true;
+	z_sampling_profiler_timer_set(k_us_to_cyc_ceil32(period_us));
+	k_spin_unlock(&state_lock, key);
+
+	return 0;
+}
+
+void sampling_profiler_stop(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&state_lock);
+
+	if (running) {
+		z_sampling_profiler_timer_set(0U);
+		running = false;
+	}
+	k_spin_unlock(&state_lock, key);
+}
+
+size_t sampling_profiler_read(int cpu, struct sampling_profiler_record *records,
+			      size_t count)
+{
+	struct profiler_buf *buf;
+	k_spinlock_key_t key;
+	uint32_t head, tail;
+	size_t n = 0;
+
+	__ASSERT_NO_MSG(cpu >= 0 && cpu < CONFIG_MP_NUM_CPUS);
+
+	buf = &z_sampling_profiler_bufs[cpu];
+	key = k_spin_lock(&read_lock);
+	head = (uint32_t)atomic_get(&buf->head);
+	tail = (uint32_t)atomic_get(&buf->tail);
+
+	while ((n < count) && (tail != head)) {
+		records[n++] = buf->records[tail];
+		tail = (tail + 1U) % NUM_RECORDS;
+	}
+
+	/* Hand the slots back to the producer once they are copied */
+	(void)atomic_set(&buf->tail, tail);
+	k_spin_unlock(&read_lock, key);
+
+	return n;
+}
+
+uint32_t sampling_profiler_dropped(int cpu)
+{
+	__ASSERT_NO_MSG(cpu >= 0 && cpu < CONFIG_MP_NUM_CPUS);
+
+	return (uint32_t)atomic_get(&z_sampling_profiler_bufs[cpu].dropped);
+}
+
+void sampling_profiler_dump(void)
+{
+	struct sampling_profiler_record rec;
+
+	printk("prof: start period %u events %d\n", period, NUM_EVENTS);
+
+	for (int cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+		while (sampling_profiler_read(cpu, &rec, 1) != 0U) {
+			printk("prof: %d 0x%lx", cpu, (unsigned long)rec.pc);
+#if NUM_EVENTS > 0
+			for (int i = 0; i < NUM_EVENTS; i++) {
+				printk(" %u", rec.events[i]);
+			}
+#endif
+			printk("\n");
+		}
+		printk("prof: cpu %d dropped %u\n", cpu,
+		       sampling_profiler_dropped(cpu));
+	}
+
+	printk("prof: end\n");
+}
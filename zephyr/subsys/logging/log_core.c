@@ -100,6 +100,53 @@ static uint32_t __aligned(Z_LOG_MSG2_ALIGNMENT)
 static void notify_drop(const struct mpsc_pbuf_buffer *buffer,
 			const union mpsc_pbuf_generic *item);
 
+#ifdef CONFIG_LOG_PERCPU_BUFFERS
+static struct mpsc_pbuf_percpu log_pcbuf;
+
+#define LOG_CPU_CNT_ALIGN __aligned(CONFIG_LOG_PERCPU_CACHE_LINE_SIZE)
+
+/* Counters of a CPU, each in its own cache line, updated by the code
+ * logging on it. Messages committed to the CPU's buffer are counted
+ * there, those processed out of it in log_cpu_processed, so that the
+ * processing thread does not write to the CPU's cache line.
+ */
+static struct log_cpu_cnt {
+	atomic_t committed;
+	atomic_t dropped;
+} LOG_CPU_CNT_ALIGN log_cpu_cnt[CONFIG_MP_NUM_CPUS];
+
+static atomic_t LOG_CPU_CNT_ALIGN log_cpu_processed[CONFIG_MP_NUM_CPUS];
+
+static bool msg_is_older(const union mpsc_pbuf_generic *a,
+			 const union mpsc_pbuf_generic *b)
+{
+	return ((const union log_msg2_generic *)a)->log.hdr.timestamp <
+	       ((const union log_msg2_generic *)b)->log.hdr.timestamp;
+}
+
+/* The counters of another CPU are used if the caller migrates meanwhile,
+ * which only costs a cache line transfer.
+ */
+static inline struct log_cpu_cnt *cpu_cnt_get(void)
+{
+	return &log_cpu_cnt[arch_curr_cpu()->id];
+}
+
+static inline int msg_cpu_idx_get(union log_msg2_generic *msg)
+{
+	struct mpsc_pbuf_buffer *buffer =
+		mpsc_pbuf_percpu_find(&log_pcbuf, &msg->buf);
+
+	return mpsc_pbuf_percpu_idx(&log_pcbuf, buffer);
+}
+
+static inline uint32_t cpu_buffered_cnt(int idx)
+{
+	return (uint32_t)atomic_get(&log_cpu_cnt[idx].committed) -
+	       (uint32_t)atomic_get(&log_cpu_processed[idx]);
+}
+#endif
+
 static const struct mpsc_pbuf_buffer_config mpsc_config = {
 	.buf = (uint32_t *)buf32,
 	.size = ARRAY_SIZE(buf32),
@@ -216,18 +263,20 @@ static void detect_missed_strdup(struct log_msg *msg)
 #undef ERR_MSG
 }
 
-static void z_log_msg_post_finalize(void)
+/* cnt is the number of buffered messages, first whether the processing
+ * timer is to be started for the message.
+ */
+static void z_log_msg_post_finalize(uint32_t cnt, bool first)
 {
-	atomic_inc(&buffered_cnt);
 	if (panic_mode) {
 		unsigned int key = irq_lock();
 		(void)log_process(false);
 		irq_unlock(key);
-	} else if (proc_tid != NULL && buffered_cnt == 1) {
+	} else if (proc_tid != NULL && first) {
 		k_timer_start(&log_process_thread_timer,
 			K_MSEC(CONFIG_LOG_PROCESS_THREAD_SLEEP_MS), K_NO_WAIT);
 	} else if (CONFIG_LOG_PROCESS_TRIGGER_THRESHOLD) {
-		if ((buffered_cnt == CONFIG_LOG_PROCESS_TRIGGER_THRESHOLD) &&
+		if ((cnt == CONFIG_LOG_PROCESS_TRIGGER_THRESHOLD) &&
 		    (proc_tid != NULL)) {
 			k_timer_stop(&log_process_thread_timer);
 			k_sem_give(&log_process_thread_sem);
@@ -245,6 +294,7 @@ static inline void msg_finalize(struct log_msg *msg,
 				struct log_msg_ids src_level)
 {
 	unsigned int key;
+	atomic_val_t cnt;
 
 	msg->hdr.ids = src_level;
 	msg->hdr.timestamp = timestamp_func();
@@ -255,7 +305,8 @@ static inline void msg_finalize(struct log_msg *msg,
 
 	irq_unlock(key);
 
-	z_log_msg_post_finalize();
+	cnt = atomic_inc(&buffered_cnt) + 1;
+	z_log_msg_post_finalize(cnt, cnt == 1);
 }
 
 void log_0(const char *str, struct log_msg_ids src_level)
@@ -614,7 +665,7 @@ static void thread_set(k_tid_t process_tid)
 
 	if (CONFIG_LOG_PROCESS_TRIGGER_THRESHOLD &&
 	    process_tid &&
-	    buffered_cnt >= CONFIG_LOG_PROCESS_TRIGGER_THRESHOLD) {
+	    z_impl_log_buffered_cnt() >= CONFIG_LOG_PROCESS_TRIGGER_THRESHOLD) {
 		k_sem_give(&log_process_thread_sem);
 	}
 }
@@ -811,7 +862,11 @@ bool z_impl_log_process(bool bypass)
 
 	msg = get_msg();
 	if (msg.msg) {
+#ifdef CONFIG_LOG_PERCPU_BUFFERS
+		atomic_inc(&log_cpu_processed[msg_cpu_idx_get(msg.msg2)]);
+#else
 		atomic_dec(&buffered_cnt);
+#endif
 		msg_process(msg, bypass);
 	}
 
@@ -832,7 +887,17 @@ bool z_vrfy_log_process(bool bypass)
 
 uint32_t z_impl_log_buffered_cnt(void)
 {
+#ifdef CONFIG_LOG_PERCPU_BUFFERS
+	uint32_t cnt = 0;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		cnt += cpu_buffered_cnt(i);
+	}
+
+	return cnt;
+#else
 	return buffered_cnt;
+#endif
 }
 
 #ifdef CONFIG_USERSPACE
@@ -843,6 +908,53 @@ uint32_t z_vrfy_log_buffered_cnt(void)
 #include <syscalls/log_buffered_cnt_mrsh.c>
 #endif
 
+#ifdef CONFIG_LOG_PERCPU_BUFFERS
+void z_log_dropped(void)
+{
+	atomic_inc(&cpu_cnt_get()->dropped);
+}
+
+uint32_t z_log_dropped_cpu_read_and_clear(unsigned int cpu)
+{
+	return atomic_set(&log_cpu_cnt[cpu].dropped, 0);
+}
+
+uint32_t z_log_dropped_read_and_clear(void)
+{
+	uint32_t dropped = 0;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		dropped += z_log_dropped_cpu_read_and_clear(i);
+	}
+
+	return dropped;
+}
+
+bool z_log_dropped_pending(void)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if (atomic_get(&log_cpu_cnt[i].dropped) > 0) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void notify_drop(const struct mpsc_pbuf_buffer *buffer,
+			const union mpsc_pbuf_generic *item)
+{
+	int idx = mpsc_pbuf_percpu_idx(&log_pcbuf, buffer);
+
+	ARG_UNUSED(item);
+
+	/* Counted for the CPU whose buffer overflowed. The message was
+	 * committed, so it leaves the buffered count as if processed.
+	 */
+	atomic_inc(&log_cpu_cnt[idx].dropped);
+	atomic_inc(&log_cpu_processed[idx]);
+}
+#else
 void z_log_dropped(void)
 {
 	atomic_inc(&dropped_cnt);
@@ -866,6 +978,7 @@ static void notify_drop(const struct mpsc_pbuf_buffer *buffer,
 
 	z_log_dropped();
 }
+#endif /* CONFIG_LOG_PERCPU_BUFFERS */
 
 
 char *z_log_strdup(const char *str)
@@ -1169,36 +1282,89 @@ void log_hexdump_from_user(struct log_msg_ids src_level, const char *metadata,
 /* LCOV_EXCL_STOP */
 #endif /* !defined(CONFIG_USERSPACE) */
 
+#ifdef CONFIG_LOG_PERCPU_BUFFERS
 void z_log_msg2_init(void)
 {
-	mpsc_pbuf_init(&log_buffer, &mpsc_config);
+	mpsc_pbuf_percpu_init(&log_pcbuf, &mpsc_config, msg_is_older);
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		atomic_clear(&log_cpu_cnt[i].committed);
+		atomic_clear(&log_cpu_cnt[i].dropped);
+		atomic_clear(&log_cpu_processed[i]);
+	}
 }
 
 struct log_msg2 *z_log_msg2_alloc(uint32_t wlen)
 {
-	return (struct log_msg2 *)mpsc_pbuf_alloc(&log_buffer, wlen,
+	return (struct log_msg2 *)mpsc_pbuf_alloc(
+				mpsc_pbuf_percpu_get(&log_pcbuf), wlen,
 				K_MSEC(CONFIG_LOG_BLOCK_IN_THREAD_TIMEOUT_MS));
 }
 
-void z_log_msg2_commit(struct log_msg2 *msg)
+/* Returns the number of buffered messages, and in first whether the
+ * processing timer is to be started. Only the counter of the message's
+ * buffer is updated. The timer is started by the first message buffered
+ * on a CPU, unless another CPU's first message already started it. The
+ * other CPUs' counters are only read when a trigger threshold is set.
+ */
+static inline uint32_t msg2_commit(struct log_msg2 *msg, bool *first)
 {
-	msg->hdr.timestamp = timestamp_func();
+	union mpsc_pbuf_generic *item = (union mpsc_pbuf_generic *)msg;
+	struct mpsc_pbuf_buffer *buffer;
+	uint32_t cnt;
+	int idx;
 
-	if (IS_ENABLED(CONFIG_LOG2_MODE_IMMEDIATE)) {
-		union log_msgs msgs = {
-			.msg2 = (union log_msg2_generic *)msg
-		};
+	/* The caller may have migrated since the allocation */
+	buffer = mpsc_pbuf_percpu_find(&log_pcbuf, item);
+	idx = mpsc_pbuf_percpu_idx(&log_pcbuf, buffer);
 
-		msg_process(msgs, false);
+	mpsc_pbuf_commit(buffer, item);
 
-		return;
-	}
+	cnt = (uint32_t)atomic_inc(&log_cpu_cnt[idx].committed) + 1 -
+	      (uint32_t)atomic_get(&log_cpu_processed[idx]);
+
+	*first = (cnt == 1) &&
+		 (k_timer_remaining_ticks(&log_process_thread_timer) == 0);
+
+	return CONFIG_LOG_PROCESS_TRIGGER_THRESHOLD ?
+	       z_impl_log_buffered_cnt() : cnt;
+}
+
+union log_msg2_generic *z_log_msg2_claim(void)
+{
+	return (union log_msg2_generic *)mpsc_pbuf_percpu_claim(&log_pcbuf);
+}
+
+void z_log_msg2_free(union log_msg2_generic *msg)
+{
+	mpsc_pbuf_percpu_free(&log_pcbuf, (union mpsc_pbuf_generic *)msg);
+}
+
+bool z_log_msg2_pending(void)
+{
+	return mpsc_pbuf_percpu_is_pending(&log_pcbuf);
+}
+#else
+void z_log_msg2_init(void)
+{
+	mpsc_pbuf_init(&log_buffer, &mpsc_config);
+}
+
+struct log_msg2 *z_log_msg2_alloc(uint32_t wlen)
+{
+	return (struct log_msg2 *)mpsc_pbuf_alloc(&log_buffer, wlen,
+				K_MSEC(CONFIG_LOG_BLOCK_IN_THREAD_TIMEOUT_MS));
+}
+
+static inline uint32_t msg2_commit(struct log_msg2 *msg, bool *first)
+{
+	uint32_t cnt;
 
 	mpsc_pbuf_commit(&log_buffer, (union mpsc_pbuf_generic *)msg);
 
-	if (IS_ENABLED(CONFIG_LOG2_MODE_DEFERRED)) {
-		z_log_msg_post_finalize();
-	}
+	cnt = atomic_inc(&buffered_cnt) + 1;
+	*first = (cnt == 1);
+
+	return cnt;
 }
 
 union log_msg2_generic *z_log_msg2_claim(void)
@@ -1216,6 +1382,31 @@ bool z_log_msg2_pending(void)
 {
 	return mpsc_pbuf_is_pending(&log_buffer);
 }
+#endif /* CONFIG_LOG_PERCPU_BUFFERS */
+
+void z_log_msg2_commit(struct log_msg2 *msg)
+{
+	uint32_t cnt;
+	bool first;
+
+	msg->hdr.timestamp = timestamp_func();
+
+	if (IS_ENABLED(CONFIG_LOG2_MODE_IMMEDIATE)) {
+		union log_msgs msgs = {
+			.msg2 = (union log_msg2_generic *)msg
+		};
+
+		msg_process(msgs, false);
+
+		return;
+	}
+
+	cnt = msg2_commit(msg, &first);
+
+	if (IS_ENABLED(CONFIG_LOG2_MODE_DEFERRED)) {
+		z_log_msg_post_finalize(cnt, first);
+	}
+}
 
 static void log_process_thread_timer_expiry_fn(struct k_timer *timer)
 {
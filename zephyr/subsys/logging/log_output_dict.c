@@ -10,6 +10,7 @@
 #include <logging/log_output.h>
 #include <logging/log_output_dict.h>
 #include <sys/__assert.h>
+#include <sys/crc.h>
 #include <sys/util.h>
 
 static void buffer_write(log_output_func_t outf, uint8_t *buf, size_t len,
@@ -24,6 +25,43 @@ static void buffer_write(log_output_func_t outf, uint8_t *buf, size_t len,
 	} while (len != 0);
 }
 
+/* Write part of a record, folding it into the frame check sequence. */
+static void record_write(const struct log_output *output, const void *buf,
+			 size_t len, uint16_t *fcs)
+{
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY_FRAMED)) {
+		*fcs = crc16_itu_t(*fcs, buf, len);
+	}
+
+	buffer_write(output->func, (uint8_t *)buf, len, (void *)output);
+}
+
+static void record_start(const struct log_output *output, size_t len,
+			 uint16_t *fcs)
+{
+	*fcs = LOG_DICT_FRAME_FCS_INIT;
+
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY_FRAMED)) {
+		struct log_dict_output_frame_hdr_t hdr = {
+			.sync = { LOG_DICT_FRAME_SYNC0, LOG_DICT_FRAME_SYNC1 },
+			.len = (uint16_t)len,
+		};
+
+		/* Sync bytes are left out of the frame check sequence. */
+		buffer_write(output->func, hdr.sync, sizeof(hdr.sync),
+			     (void *)output);
+		record_write(output, &hdr.len, sizeof(hdr.len), fcs);
+	}
+}
+
+static void record_end(const struct log_output *output, uint16_t fcs)
+{
+	if (IS_ENABLED(CONFIG_LOG_DICTIONARY_FRAMED)) {
+		buffer_write(output->func, (uint8_t *)&fcs, sizeof(fcs),
+			     (void *)output);
+	}
+}
+
 void log_dict_output_msg2_process(const struct log_output *output,
 				  struct log_msg2 *msg, uint32_t flags)
 {
@@ -44,31 +82,36 @@ void log_dict_output_msg2_process(const struct log_output *output,
 					log_const_source_id(source)) :
 				0U;
 
-	buffer_write(output->func, (uint8_t *)&output_hdr, sizeof(output_hdr),
-		     (void *)output);
+	size_t pkg_len, data_len;
+	uint8_t *package = log_msg2_get_package(msg, &pkg_len);
+	uint8_t *data = log_msg2_get_data(msg, &data_len);
+	uint16_t fcs;
 
-	size_t len;
-	uint8_t *data = log_msg2_get_package(msg, &len);
+	record_start(output, sizeof(output_hdr) + pkg_len + data_len, &fcs);
+	record_write(output, &output_hdr, sizeof(output_hdr), &fcs);
 
-	if (len > 0U) {
-		buffer_write(output->func, data, len, (void *)output);
+	if (pkg_len > 0U) {
+		record_write(output, package, pkg_len, &fcs);
 	}
 
-	data = log_msg2_get_data(msg, &len);
-	if (len > 0U) {
-		buffer_write(output->func, data, len, (void *)output);
+	if (data_len > 0U) {
+		record_write(output, data, data_len, &fcs);
 	}
 
+	record_end(output, fcs);
+
 	log_output_flush(output);
 }
 
 void log_dict_output_dropped_process(const struct log_output *output, uint32_t cnt)
 {
 	struct log_dict_output_dropped_msg_t msg;
+	uint16_t fcs;
 
 	msg.type = MSG_DROPPED_MSG;
 	msg.num_dropped_messages = MIN(cnt, 9999);
 
-	buffer_write(output->func, (uint8_t *)&msg, sizeof(msg),
-		     (void *)output);
+	record_start(output, sizeof(msg), &fcs);
+	record_write(output, &msg, sizeof(msg), &fcs);
+	record_end(output, fcs);
 }
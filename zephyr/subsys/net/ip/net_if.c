@@ -3953,6 +3953,24 @@ bool net_if_need_calc_rx_checksum(struct net_if *iface)
 	return need_calc_checksum(iface, ETHERNET_HW_RX_CHKSUM_OFFLOAD);
 }
 
+bool net_if_is_tcp_tso_supported(struct net_if *iface)
+{
+#if defined(CONFIG_NET_TCP_TSO)
+	enum ethernet_hw_caps caps = ETHERNET_HW_TX_TSO |
+				     ETHERNET_HW_TX_CHKSUM_OFFLOAD;
+
+	if (net_if_l2(iface) != &NET_L2_GET_NAME(ETHERNET)) {
+		return false;
+	}
+
+	return (net_eth_get_hw_capabilities(iface) & caps) == caps;
+#else
+	ARG_UNUSED(iface);
+
+	return false;
+#endif
+}
+
 int net_if_get_by_iface(struct net_if *iface)
 {
 	if (!(iface >= _net_if_list_start && iface < _net_if_list_end)) {
@@ -844,6 +844,13 @@ static int tcp_out_ext(struct tcp *conn, uint8_t flags, struct net_pkt *data,
 	}
 
 	if (data) {
+		/* More than one segment of data is only passed in here when
+		 * the network device does the segmentation.
+		 */
+		if (net_pkt_get_len(data) > conn_mss(conn)) {
+			net_pkt_set_tso_mss(pkt, conn_mss(conn));
+		}
+
 		/* Append the data buffer to the pkt */
 		net_pkt_append_buffer(pkt, data->buffer);
 		data->buffer = NULL;
@@ -955,6 +962,22 @@ static int tcp_unsent_len(struct tcp *conn)
 	return unsent_len;
 }
 
+/* Amount of data to send in one packet: a single segment, or several of them
+ * if the network device does TCP segmentation offload.
+ */
+static int tcp_send_len_max(struct tcp *conn)
+{
+	int mss = conn_mss(conn);
+
+#if defined(CONFIG_NET_TCP_TSO)
+	if (net_if_is_tcp_tso_supported(conn->iface)) {
+		return MAX(mss, ROUND_DOWN(CONFIG_NET_TCP_TSO_MAX_SIZE, mss));
+	}
+#endif
+
+	return mss;
+}
+
 static int tcp_send_data(struct tcp *conn)
 {
 	int ret = 0;
@@ -964,7 +987,7 @@ static int tcp_send_data(struct tcp *conn)
 	pos = conn->unacked_len;
 	len = MIN3(conn->send_data_total - conn->unacked_len,
 		   conn->send_win - conn->unacked_len,
-		   conn_mss(conn));
+		   tcp_send_len_max(conn));
 	if (len == 0) {
 		NET_DBG("conn: %p no data to send", conn);
 		ret = -ENODATA;
@@ -2442,6 +2465,9 @@ int net_tcp_finalize(struct net_pkt *pkt)
 
 	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
 		tcp_hdr->chksum = net_calc_chksum_tcp(pkt);
+	} else {
+		net_pkt_set_tx_chksum_offset(pkt,
+					     offsetof(struct net_tcp_hdr, chksum));
 	}
 
 	return net_pkt_set_data(pkt, &tcp_access);
@@ -2454,6 +2480,7 @@ struct net_tcp_hdr *net_tcp_input(struct net_pkt *pkt,
 
 	if (IS_ENABLED(CONFIG_NET_TCP_CHECKSUM) &&
 			net_if_need_calc_rx_checksum(net_pkt_iface(pkt)) &&
+			!net_pkt_is_chksum_done(pkt) &&
 			net_calc_chksum_tcp(pkt) != 0U) {
 		NET_DBG("DROP: checksum mismatch");
 		goto drop;
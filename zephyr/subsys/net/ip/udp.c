@@ -53,6 +53,10 @@ int net_udp_finalize(struct net_pkt *pkt)
 
 	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
 		udp_hdr->chksum = net_calc_chksum_udp(pkt);
+	} else {
+		udp_hdr->chksum = 0U;
+		net_pkt_set_tx_chksum_offset(pkt,
+					     offsetof(struct net_udp_hdr, chksum));
 	}
 
 	return net_pkt_set_data(pkt, &udp_access);
@@ -163,7 +167,8 @@ struct net_udp_hdr *net_udp_input(struct net_pkt *pkt,
 	}
 
 	if (IS_ENABLED(CONFIG_NET_UDP_CHECKSUM) &&
-	    net_if_need_calc_rx_checksum(net_pkt_iface(pkt))) {
+	    net_if_need_calc_rx_checksum(net_pkt_iface(pkt)) &&
+	    !net_pkt_is_chksum_done(pkt)) {
 		if (!udp_hdr->chksum) {
 			if (IS_ENABLED(CONFIG_NET_UDP_MISSING_CHECKSUM) &&
 			    net_pkt_family(pkt) == AF_INET) {
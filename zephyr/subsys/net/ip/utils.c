@@ -487,37 +487,107 @@ int z_vrfy_net_addr_pton(sa_family_t family, const char *src,
 #include <syscalls/net_addr_pton_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+static inline uint16_t chksum_add(uint16_t sum, uint16_t val)
+{
+	sum += val;
+	if (sum < val) {
+		sum++;
+	}
+
+	return sum;
+}
+
+/* The data is read in words, which may alias any type stored in the packet */
+typedef uint16_t __may_alias chksum_u16_t;
+typedef uint32_t __may_alias chksum_u32_t;
+typedef uint64_t __may_alias chksum_u64_t;
+
+/* Adds len bytes of data, taken as 16-bit words in network byte order, to
+ * the one's complement sum. The bytes are summed in memory order in a 64-bit
+ * accumulator, 8 at a time, which is folded and byte swapped as needed only
+ * at the end (RFC 1071). If data starts at an odd address, the first byte is
+ * added on its own, and the sum over the remaining bytes is byte swapped as
+ * all of them are in the other half of their words.
+ */
 static uint16_t calc_chksum(uint16_t sum, const uint8_t *data, size_t len)
 {
-	const uint8_t *end;
-	uint16_t tmp;
+	uint64_t acc = 0U;
+	bool swapped = false;
+	uint16_t part;
 
-	end = data + len - 1;
+	if (len == 0U) {
+		return sum;
+	}
 
-	while (data < end) {
-		tmp = (data[0] << 8) + data[1];
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
+	if ((uintptr_t)data & 1U) {
+		sum = chksum_add(sum, data[0] << 8);
+		data++;
+		len--;
+		swapped = true;
+	}
 
+	if (((uintptr_t)data & 2U) && len >= 2U) {
+		acc += *(const chksum_u16_t *)data;
 		data += 2;
+		len -= 2U;
 	}
 
-	if (data == end) {
-		tmp = data[0] << 8;
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
-		}
+	if (((uintptr_t)data & 4U) && len >= 4U) {
+		acc += *(const chksum_u32_t *)data;
+		data += 4;
+		len -= 4U;
 	}
 
-	return sum;
+	for (; len >= 8U; data += 8, len -= 8U) {
+#if defined(CONFIG_64BIT)
+		uint64_t word = *(const chksum_u64_t *)data;
+
+		/* End-around carry keeps the 64-bit sum a one's complement
+		 * sum of the 16-bit words.
+		 */
+		acc += word;
+		acc += (acc < word);
+#else
+		acc += ((const chksum_u32_t *)data)[0];
+		acc += ((const chksum_u32_t *)data)[1];
+#endif
+	}
+
+	acc = (acc & 0xffffffffU) + (acc >> 32);
+	acc = (acc & 0xffffffffU) + (acc >> 32);
+
+	if (len >= 4U) {
+		acc += *(const chksum_u32_t *)data;
+		data += 4;
+		len -= 4U;
+	}
+
+	if (len >= 2U) {
+		acc += *(const chksum_u16_t *)data;
+		data += 2;
+		len -= 2U;
+	}
+
+	if (len) {
+		/* Last byte, padded with a zero byte */
+		acc += ntohs(data[0] << 8);
+	}
+
+	acc = (acc & 0xffffffffU) + (acc >> 32);
+	acc = (acc & 0xffffU) + (acc >> 16);
+	acc = (acc & 0xffffU) + (acc >> 16);
+	acc = (acc & 0xffffU) + (acc >> 16);
+
+	part = ntohs((uint16_t)acc);
+
+	return chksum_add(sum, swapped ? __bswap_16(part) : part);
 }
 
 static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 {
 	struct net_pkt_cursor *cur = &pkt->cursor;
+	bool odd = false;
+	uint16_t part;
 	size_t len;
 
 	if (!cur->buf || !cur->pos) {
@@ -527,7 +597,12 @@ static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 	len = cur->buf->len - (cur->pos - cur->buf->data);
 
 	while (cur->buf) {
-		sum = calc_chksum(sum, cur->pos, len);
+		/* After an odd number of bytes, the bytes of this fragment
+		 * are in the other half of their words.
+		 */
+		part = calc_chksum(0U, cur->pos, len);
+		sum = chksum_add(sum, odd ? __bswap_16(part) : part);
+		odd ^= (len & 1U);
 
 		cur->buf = cur->buf->frags;
 		if (!cur->buf || !cur->buf->len) {
@@ -535,18 +610,7 @@ static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 		}
 
 		cur->pos = cur->buf->data;
-
-		if (len % 2) {
-			sum += *cur->pos;
-			if (sum < *cur->pos) {
-				sum++;
-			}
-
-			cur->pos++;
-			len = cur->buf->len - 1;
-		} else {
-			len = cur->buf->len;
-		}
+		len = cur->buf->len;
 	}
 
 	return sum;
@@ -160,6 +160,130 @@ static void uart_callback(const struct device *dev, void *user_data)
 }
 #endif /* CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN */
 
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+/* Received data is reported as soon as the RX FIFO is drained. */
+#define ASYNC_RX_TIMEOUT_US 0
+
+static void async_tx_start(const struct shell_uart *sh_uart)
+{
+	struct shell_uart_ctrl_blk *ctrl_blk = sh_uart->ctrl_blk;
+	uint8_t *data;
+
+	do {
+		if (atomic_set(&ctrl_blk->tx_busy, 1) != 0) {
+			return;
+		}
+
+		ctrl_blk->tx_len = ring_buf_get_claim(sh_uart->tx_ringbuf,
+						      &data,
+						      sh_uart->tx_ringbuf->size);
+		if (ctrl_blk->tx_len > 0) {
+			if (uart_tx(ctrl_blk->dev, data, ctrl_blk->tx_len,
+				    SYS_FOREVER_US) == 0) {
+				return;
+			}
+
+			/* Leave the data to the next attempt */
+			(void)ring_buf_get_finish(sh_uart->tx_ringbuf, 0);
+			atomic_clear(&ctrl_blk->tx_busy);
+			return;
+		}
+
+		atomic_clear(&ctrl_blk->tx_busy);
+
+		/* Data may have been queued before tx_busy was cleared. */
+	} while (!ring_buf_is_empty(sh_uart->tx_ringbuf));
+}
+
+static void async_rx_handle(const struct shell_uart *sh_uart,
+			    const uint8_t *data, size_t len)
+{
+#ifdef CONFIG_MCUMGR_SMP_SHELL
+	/* Divert bytes from shell handling if it is part of an mcumgr
+	 * frame.
+	 */
+	size_t i = smp_shell_rx_bytes(&sh_uart->ctrl_blk->smp, data, len);
+
+	data += i;
+	len -= i;
+#endif /* CONFIG_MCUMGR_SMP_SHELL */
+
+	if (ring_buf_put(sh_uart->rx_ringbuf, data, len) < len) {
+		LOG_WRN("RX ring buffer full.");
+	}
+
+	sh_uart->ctrl_blk->handler(SHELL_TRANSPORT_EVT_RX_RDY,
+				   sh_uart->ctrl_blk->context);
+}
+
+static void async_rx_enable(const struct shell_uart *sh_uart)
+{
+	struct shell_uart_ctrl_blk *ctrl_blk = sh_uart->ctrl_blk;
+
+	ctrl_blk->rx_buf_idx = 0;
+	(void)uart_rx_enable(ctrl_blk->dev, ctrl_blk->rx_buf[0],
+			     sizeof(ctrl_blk->rx_buf[0]), ASYNC_RX_TIMEOUT_US);
+}
+
+static void async_callback(const struct device *dev, struct uart_event *evt,
+			   void *user_data)
+{
+	const struct shell_uart *sh_uart = (struct shell_uart *)user_data;
+	struct shell_uart_ctrl_blk *ctrl_blk = sh_uart->ctrl_blk;
+	int err;
+
+	switch (evt->type) {
+	case UART_TX_DONE:
+		err = ring_buf_get_finish(sh_uart->tx_ringbuf,
+					  ctrl_blk->tx_len);
+		__ASSERT_NO_MSG(err == 0);
+		atomic_clear(&ctrl_blk->tx_busy);
+		async_tx_start(sh_uart);
+		ctrl_blk->handler(SHELL_TRANSPORT_EVT_TX_RDY,
+				  ctrl_blk->context);
+		break;
+	case UART_TX_ABORTED:
+		(void)ring_buf_get_finish(sh_uart->tx_ringbuf, evt->data.tx.len);
+		atomic_clear(&ctrl_blk->tx_busy);
+		break;
+	case UART_RX_RDY:
+		async_rx_handle(sh_uart, evt->data.rx.buf + evt->data.rx.offset,
+				evt->data.rx.len);
+		break;
+	case UART_RX_BUF_REQUEST:
+		ctrl_blk->rx_buf_idx ^= 1;
+		(void)uart_rx_buf_rsp(dev, ctrl_blk->rx_buf[ctrl_blk->rx_buf_idx],
+				      sizeof(ctrl_blk->rx_buf[0]));
+		break;
+	case UART_RX_STOPPED:
+		LOG_WRN("RX stopped (0x%x).", evt->data.rx_stop.reason);
+		break;
+	case UART_RX_DISABLED:
+		/* Reception stops on line errors, resume it */
+		if (!ctrl_blk->rx_stop) {
+			async_rx_enable(sh_uart);
+		}
+		break;
+	default:
+		break;
+	}
+}
+#endif /* CONFIG_SHELL_BACKEND_SERIAL_ASYNC */
+
+static void uart_async_init(const struct shell_uart *sh_uart)
+{
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+	const struct device *dev = sh_uart->ctrl_blk->dev;
+
+	ring_buf_reset(sh_uart->tx_ringbuf);
+	ring_buf_reset(sh_uart->rx_ringbuf);
+	sh_uart->ctrl_blk->tx_busy = 0;
+	sh_uart->ctrl_blk->rx_stop = false;
+	(void)uart_callback_set(dev, async_callback, (void *)sh_uart);
+	async_rx_enable(sh_uart);
+#endif
+}
+
 static void uart_irq_init(const struct shell_uart *sh_uart)
 {
 #ifdef CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN
@@ -206,6 +330,8 @@ static int init(const struct shell_transport *transport,
 
 	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN)) {
 		uart_irq_init(sh_uart);
+	} else if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_ASYNC)) {
+		uart_async_init(sh_uart);
 	} else {
 		k_timer_init(sh_uart->timer, timer_handler, NULL);
 		k_timer_user_data_set(sh_uart->timer, (void *)sh_uart);
@@ -224,6 +350,14 @@ static int uninit(const struct shell_transport *transport)
 
 		uart_irq_tx_disable(dev);
 		uart_irq_rx_disable(dev);
+	} else if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_ASYNC)) {
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+		const struct device *dev = sh_uart->ctrl_blk->dev;
+
+		sh_uart->ctrl_blk->rx_stop = true;
+		(void)uart_tx_abort(dev);
+		(void)uart_rx_disable(dev);
+#endif
 	} else {
 		k_timer_stop(sh_uart->timer);
 	}
@@ -240,6 +374,9 @@ static int enable(const struct shell_transport *transport, bool blocking_tx)
 	if (blocking_tx) {
 #ifdef CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN
 		uart_irq_tx_disable(sh_uart->ctrl_blk->dev);
+#endif
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+		(void)uart_tx_abort(sh_uart->ctrl_blk->dev);
 #endif
 	}
 
@@ -258,6 +395,16 @@ static void irq_write(const struct shell_uart *sh_uart, const void *data,
 	}
 }
 
+static void async_write(const struct shell_uart *sh_uart, const void *data,
+			size_t length, size_t *cnt)
+{
+	*cnt = ring_buf_put(sh_uart->tx_ringbuf, data, length);
+
+#ifdef CONFIG_SHELL_BACKEND_SERIAL_ASYNC
+	async_tx_start(sh_uart);
+#endif
+}
+
 static int write(const struct shell_transport *transport,
 		 const void *data, size_t length, size_t *cnt)
 {
@@ -267,6 +414,9 @@ static int write(const struct shell_transport *transport,
 	if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_INTERRUPT_DRIVEN) &&
 		!sh_uart->ctrl_blk->blocking_tx) {
 		irq_write(sh_uart, data, length, cnt);
+	} else if (IS_ENABLED(CONFIG_SHELL_BACKEND_SERIAL_ASYNC) &&
+		!sh_uart->ctrl_blk->blocking_tx) {
+		async_write(sh_uart, data, length, cnt);
 	} else {
 		for (size_t i = 0; i < length; i++) {
 			uart_poll_out(sh_uart->ctrl_blk->dev, data8[i]);
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2021 Microchip Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <sys/crc.h>
+#include <timing/timing.h>
+
+/* This is a CRC throughput benchmark.  Every CRC of sys/crc.h with a
+ * table driven implementation runs over buffers of increasing size,
+ * enough times to process about 1 MiB per measurement, and reports the
+ * throughput in KiB per second of the timing counter.  Comparing the
+ * scenarios shows what each implementation selected in lib/os/Kconfig
+ * buys for its flash.
+ */
+
+#define MAX_SIZE 16384
+#define BYTES_PER_RUN (1024 * 1024)
+
+static const size_t sizes[] = { 64, 1024, MAX_SIZE };
+
+static uint8_t buf[MAX_SIZE] __aligned(8);
+
+/* Keeps the results alive */
+static volatile uint32_t sink;
+
+enum crc_func {
+	CRC32_IEEE,
+	CRC32_C,
+	CRC16_CCITT,
+	CRC16_ITU_T,
+	CRC8_CCITT,
+	NUM_FUNCS
+};
+
+static const char *const func_names[] = {
+	"crc32_ieee", "crc32_c", "crc16_ccitt", "crc16_itu_t", "crc8_ccitt"
+};
+
+static uint32_t compute(enum crc_func func, size_t len)
+{
+	switch (func) {
+	case CRC32_IEEE:
+		return crc32_ieee(buf, len);
+	case CRC32_C:
+		return crc32_c(0, buf, len, true, true);
+	case CRC16_CCITT:
+		return crc16_ccitt(0, buf, len);
+	case CRC16_ITU_T:
+		return crc16_itu_t(0, buf, len);
+	default:
+		return crc8_ccitt(CRC8_CCITT_INITIAL_VALUE, buf, len);
+	}
+}
+
+static void run(enum crc_func func, size_t len)
+{
+	uint32_t rounds = BYTES_PER_RUN / len;
+	timing_t start, end;
+	uint64_t ns;
+
+	start = timing_counter_get();
+	for (uint32_t i = 0; i < rounds; i++) {
+		sink = compute(func, len);
+	}
+	end = timing_counter_get();
+
+	ns = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+	printk("%-11s %5zu B: %8u KiB/s\n", func_names[func], len,
+	       (uint32_t)((uint64_t)BYTES_PER_RUN * NSEC_PER_SEC /
+			  1024U / MAX(ns, 1U)));
+}
+
+void main(void)
+{
+	const char *impl =
+		IS_ENABLED(CONFIG_CRC_SLICING_BY_8) ? "slicing-by-8" :
+		IS_ENABLED(CONFIG_CRC_SLICING_BY_4) ? "slicing-by-4" :
+		IS_ENABLED(CONFIG_CRC_BYTE_TABLES) ? "256-entry tables" :
+		"16-entry tables";
+
+	for (size_t i = 0; i < sizeof(buf); i++) {
+		buf[i] = (uint8_t)(i * 131U + 7U);
+	}
+
+	timing_init();
+	timing_start();
+
+	printk("CRC %s%s, %u KiB per measurement\n", impl,
+	       IS_ENABLED(CONFIG_CRC_RISCV_ZBC) ? ", CRC32 on Zbc" : "",
+	       BYTES_PER_RUN / 1024);
+
+	for (int f = 0; f < NUM_FUNCS; f++) {
+		for (int i = 0; i < ARRAY_SIZE(sizes); i++) {
+			run(f, sizes[i]);
+		}
+	}
+
+	timing_stop();
+	printk("fin\n");
+}
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2021 Microchip Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @brief Memory slab allocation patterns
+ *
+ * Measures the cost of k_mem_slab_alloc() and k_mem_slab_free() for the
+ * ways blocks are commonly used: bursts freed in reverse or in
+ * allocation order, a steady window of blocks in use, and blocks
+ * allocated on one CPU and freed on another, the way packet descriptors
+ * are handed over in samples/arch/smp/pktqueue.
+ */
+
+#include <ztest.h>
+
+#define BLOCK_SIZE 64
+#define NUM_BLOCKS 32
+#define ROUNDS 1000
+
+/* Blocks in use in the steady pattern */
+#define WINDOW (NUM_BLOCKS / 2)
+
+/* Blocks in flight between the CPUs, a power of 2 below NUM_BLOCKS */
+#define RING_SIZE 8
+#define HANDOFFS (NUM_BLOCKS * ROUNDS)
+
+#define STACK_SIZE 1024
+
+K_MEM_SLAB_DEFINE(bench_slab, BLOCK_SIZE, NUM_BLOCKS, 8);
+
+static void *blocks[NUM_BLOCKS];
+
+static void *block_alloc(void)
+{
+	void *block;
+
+	zassert_equal(k_mem_slab_alloc(&bench_slab, &block, K_NO_WAIT), 0,
+		      "slab empty");
+
+	return block;
+}
+
+static void report(const char *pattern, uint32_t cycles, uint32_t ops)
+{
+	zassert_equal(k_mem_slab_num_used_get(&bench_slab), 0,
+		      "blocks leaked");
+
+	TC_PRINT("%-10s %5u ns/op\n", pattern,
+		 (uint32_t)(k_cyc_to_ns_floor64(cycles) / ops));
+}
+
+/**
+ * @brief Allocate all blocks and free them in reverse order
+ */
+void test_mem_slab_lifo(void)
+{
+	uint32_t start = k_cycle_get_32();
+
+	for (int r = 0; r < ROUNDS; r++) {
+		for (int i = 0; i < NUM_BLOCKS; i++) {
+			blocks[i] = block_alloc();
+		}
+		for (int i = NUM_BLOCKS - 1; i >= 0; i--) {
+			k_mem_slab_free(&bench_slab, &blocks[i]);
+		}
+	}
+
+	report("lifo", k_cycle_get_32() - start, 2 * NUM_BLOCKS * ROUNDS);
+}
+
+/**
+ * @brief Allocate all blocks and free them in allocation order
+ *
+ * The free list ends up reversed at every round, so that consecutive
+ * allocations do not return neighbouring blocks.
+ */
+void test_mem_slab_fifo(void)
+{
+	uint32_t start = k_cycle_get_32();
+
+	for (int r = 0; r < ROUNDS; r++) {
+		for (int i = 0; i < NUM_BLOCKS; i++) {
+			blocks[i] = block_alloc();
+		}
+		for (int i = 0; i < NUM_BLOCKS; i++) {
+			k_mem_slab_free(&bench_slab, &blocks[i]);
+		}
+	}
+
+	report("fifo", k_cycle_get_32() - start, 2 * NUM_BLOCKS * ROUNDS);
+}
+
+/**
+ * @brief Keep WINDOW blocks in use, replacing the oldest one
+ */
+void test_mem_slab_steady(void)
+{
+	uint32_t start;
+
+	for (int i = 0; i < WINDOW; i++) {
+		blocks[i] = block_alloc();
+	}
+
+	start = k_cycle_get_32();
+
+	for (int n = 0; n < NUM_BLOCKS * ROUNDS; n++) {
+		k_mem_slab_free(&bench_slab, &blocks[n % WINDOW]);
+		blocks[n % WINDOW] = block_alloc();
+	}
+
+	start = k_cycle_get_32() - start;
+
+	for (int i = 0; i < WINDOW; i++) {
+		k_mem_slab_free(&bench_slab, &blocks[i]);
+	}
+
+	report("steady", start, 2 * NUM_BLOCKS * ROUNDS);
+}
+
+#if defined(CONFIG_SMP) && (CONFIG_MP_NUM_CPUS > 1)
+/* Single producer, single consumer ring of allocated blocks */
+static void *ring[RING_SIZE];
+static atomic_t ring_head;
+static atomic_t ring_tail;
+static bool handoff_corrupted;
+
+static struct k_thread consumer_thread;
+static K_THREAD_STACK_DEFINE(consumer_stack, STACK_SIZE);
+
+static void consumer_fn(void *arg1, void *arg2, void *arg3)
+{
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	for (uint32_t seq = 0; seq < HANDOFFS; seq++) {
+		void *block;
+
+		while (atomic_get(&ring_tail) == atomic_get(&ring_head)) {
+		}
+
+		block = ring[seq % RING_SIZE];
+		/* The first word links free blocks, the second is the mark */
+		if (((volatile uintptr_t *)block)[1] != seq) {
+			handoff_corrupted = true;
+		}
+		k_mem_slab_free(&bench_slab, &block);
+		atomic_inc(&ring_tail);
+	}
+}
+
+/**
+ * @brief Allocate blocks on this CPU and free them on another
+ *
+ * Every block is marked with its sequence number, so that a block handed
+ * out twice while the other CPU frees fails the test.
+ */
+void test_mem_slab_cross_cpu(void)
+{
+	uint32_t start;
+
+	atomic_clear(&ring_head);
+	atomic_clear(&ring_tail);
+	handoff_corrupted = false;
+
+	/* Cooperative, so that the consumer is scheduled on another CPU */
+	k_thread_priority_set(k_current_get(), K_PRIO_COOP(0));
+
+	k_thread_create(&consumer_thread, consumer_stack, STACK_SIZE,
+			consumer_fn, NULL, NULL, NULL, K_PRIO_PREEMPT(1), 0,
+			K_NO_WAIT);
+
+	start = k_cycle_get_32();
+
+	for (uint32_t seq = 0; seq < HANDOFFS; seq++) {
+		void *block = block_alloc();
+
+		((volatile uintptr_t *)block)[1] = seq;
+
+		while (atomic_get(&ring_head) - atomic_get(&ring_tail) ==
+		       RING_SIZE) {
+		}
+
+		ring[seq % RING_SIZE] = block;
+		atomic_inc(&ring_head);
+	}
+
+	k_thread_join(&consumer_thread, K_FOREVER);
+
+	start = k_cycle_get_32() - start;
+
+	zassert_false(handoff_corrupted, "block allocated twice");
+
+	report("cross-cpu", start, 2 * HANDOFFS);
+}
+#else
+void test_mem_slab_cross_cpu(void)
+{
+	ztest_test_skip();
+}
+#endif
+
+void test_main(void)
+{
+	TC_PRINT("%s slab, %d blocks of %d bytes\n",
+		 IS_ENABLED(CONFIG_MEM_SLAB_LOCKFREE) ? "lock-free" : "locked",
+		 NUM_BLOCKS, BLOCK_SIZE);
+
+	ztest_test_suite(mem_slab_perf,
+			 ztest_unit_test(test_mem_slab_lifo),
+			 ztest_unit_test(test_mem_slab_fifo),
+			 ztest_unit_test(test_mem_slab_steady),
+			 ztest_unit_test(test_mem_slab_cross_cpu));
+	ztest_run_test_suite(mem_slab_perf);
+}
@@ -62,3 +62,104 @@ void heap_malloc_free(void)
 
 	timing_stop();
 }
+
+#if CONFIG_MP_NUM_CPUS > 1
+/* Multi-CPU variant: 1 to CONFIG_MP_NUM_CPUS workers allocate and free
+ * SMP_BATCH blocks at a time, all at once.  Workers may migrate between
+ * CPUs, whose timing counters may be distinct, so the elapsed time is
+ * taken from the system clock by the test thread, and reported per
+ * malloc and free pair of a worker: flat numbers mean perfect scaling.
+ */
+#define SMP_PAIRS 2000
+#define SMP_BATCH 4
+#define SMP_STACK_SIZE 1024
+
+#ifdef CONFIG_HEAP_CPU_CACHE
+/* The k_malloc() pool, see kernel/mempool.c */
+extern struct k_heap _system_heap;
+#endif
+
+static struct k_thread heap_threads[CONFIG_MP_NUM_CPUS];
+static K_THREAD_STACK_ARRAY_DEFINE(heap_stacks, CONFIG_MP_NUM_CPUS,
+				   SMP_STACK_SIZE);
+static volatile bool heap_go;
+static atomic_t heap_failures;
+
+static void heap_worker(void *p1, void *p2, void *p3)
+{
+	void *mem[SMP_BATCH];
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (!heap_go) {
+	}
+
+	for (int i = 0; i < SMP_PAIRS / SMP_BATCH; i++) {
+		for (int j = 0; j < SMP_BATCH; j++) {
+			mem[j] = k_malloc(TEST_SIZE);
+			if (mem[j] == NULL) {
+				atomic_inc(&heap_failures);
+			}
+		}
+		for (int j = 0; j < SMP_BATCH; j++) {
+			k_free(mem[j]);
+		}
+	}
+}
+
+void heap_malloc_free_smp(void)
+{
+	for (int n = 1; n <= CONFIG_MP_NUM_CPUS; n++) {
+		uint32_t start, cycles, per_pair;
+		char label[64];
+
+#ifdef CONFIG_HEAP_CPU_CACHE
+		struct k_heap_cache_stats before, after;
+
+		k_heap_cache_stats_get(&_system_heap, &before);
+#endif
+
+		heap_go = false;
+		atomic_clear(&heap_failures);
+
+		/* Below the test thread, which then only waits */
+		for (int i = 0; i < n; i++) {
+			k_thread_create(&heap_threads[i], heap_stacks[i],
+					SMP_STACK_SIZE, heap_worker,
+					NULL, NULL, NULL,
+					K_PRIO_PREEMPT(11), 0, K_NO_WAIT);
+		}
+
+		start = k_cycle_get_32();
+		heap_go = true;
+		for (int i = 0; i < n; i++) {
+			k_thread_join(&heap_threads[i], K_FOREVER);
+		}
+		cycles = k_cycle_get_32() - start;
+		per_pair = cycles / SMP_PAIRS;
+
+		if (atomic_get(&heap_failures) != 0) {
+			printk("Failed to alloc memory from heap %d times\n",
+			       (int)atomic_get(&heap_failures));
+			error_count++;
+		}
+
+		snprintk(label, sizeof(label),
+			 "Heap malloc + free with %d CPUs, system clock", n);
+		PRINT_F(label, per_pair,
+			(uint32_t)(k_cyc_to_ns_floor64(cycles) / SMP_PAIRS));
+
+#ifdef CONFIG_HEAP_CPU_CACHE
+		k_heap_cache_stats_get(&_system_heap, &after);
+		uint32_t hits = after.alloc_hits - before.alloc_hits;
+		uint32_t misses = after.alloc_misses - before.alloc_misses;
+
+		printk("  cache hits %u%%, heap lock taken %u times\n",
+		       hits * 100U / MAX(hits + misses, 1U),
+		       after.heap_locks - before.heap_locks);
+#endif
+	}
+}
+#endif /* CONFIG_MP_NUM_CPUS > 1 */
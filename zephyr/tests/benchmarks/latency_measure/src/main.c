@@ -28,6 +28,7 @@ extern int sema_test(void);
 extern int sema_context_switch(void);
 extern int suspend_resume(void);
 extern void heap_malloc_free(void);
+extern void heap_malloc_free_smp(void);
 
 void test_thread(void *arg1, void *arg2, void *arg3)
 {
@@ -42,6 +43,12 @@ void test_thread(void *arg1, void *arg2, void *arg3)
 	TC_START("Time Measurement");
 	TC_PRINT("Timing results: Clock frequency: %u MHz\n", freq);
 
+#if CONFIG_MP_NUM_CPUS > 1
+	/* The other measurements rely on running on a single CPU */
+	heap_malloc_free();
+
+	heap_malloc_free_smp();
+#else
 	thread_switch_yield();
 
 	coop_ctx_switch();
@@ -59,6 +66,7 @@ void test_thread(void *arg1, void *arg2, void *arg3)
 	mutex_lock_unlock();
 
 	heap_malloc_free();
+#endif
 
 	TC_END_REPORT(error_count);
 }
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2021 Microchip Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <sys/p4wq.h>
+#include <string.h>
+
+/* This is a fork/join benchmark for the P4 work queues, after
+ * samples/arch/smp/pi.  A frame is split in ITEMS independent
+ * computations of the first DIGITS digits of Pi, submitted as one
+ * batch and waited for with k_p4wq_wait_all().  The time per frame is
+ * reported for the frame computed serially by main, for a regular P4
+ * queue, and for a work-stealing one when enabled, each with one
+ * thread per CPU.
+ */
+
+#define FRAMES 50
+#define ITEMS 48
+
+/* A multiple of 4, the algorithm produces 4 digits per iteration */
+#define DIGITS 32
+#define LENGTH ((DIGITS / 4) * 14)
+
+#define STACK_SIZE 1024
+#define ITEM_PRIO 1
+
+static const char pi_digits[] = "31415926535897932384626433832795";
+
+BUILD_ASSERT(sizeof(pi_digits) - 1 == DIGITS);
+
+struct pi_item {
+	struct k_p4wq_work work;
+	int array[LENGTH + 1];
+	char digits[DIGITS + 1];
+};
+
+static struct pi_item items[ITEMS];
+static struct k_p4wq_work *item_ptrs[ITEMS];
+static struct k_p4wq_batch batch;
+
+K_P4WQ_DEFINE(pool, CONFIG_MP_NUM_CPUS, STACK_SIZE);
+#ifdef CONFIG_P4WQ_WORK_STEALING
+K_P4WQ_WORK_STEALING_DEFINE(steal_pool, CONFIG_MP_NUM_CPUS, STACK_SIZE, 0);
+#endif
+
+/* Spigot of samples/arch/smp/pi, see there */
+static void pi_compute(struct pi_item *it)
+{
+	char *out = it->digits;
+	int carry = 0;
+
+	for (int i = 0; i < LENGTH; i++) {
+		it->array[i] = 2000;
+	}
+	it->array[LENGTH] = 0;
+
+	for (int i = LENGTH; i > 0; i -= 14) {
+		int sum = 0, value;
+
+		for (int j = i; j > 0; --j) {
+			sum = sum * j + 10000 * it->array[j];
+			it->array[j] = sum % (j * 2 - 1);
+			sum /= j * 2 - 1;
+		}
+
+		value = carry + sum / 10000;
+		carry = sum % 10000;
+
+		for (int k = 3; k >= 0; k--) {
+			out[k] = '0' + value % 10;
+			value /= 10;
+		}
+		out += 4;
+	}
+	*out = '\0';
+}
+
+static void pi_handler(struct k_p4wq_work *work)
+{
+	pi_compute(CONTAINER_OF(work, struct pi_item, work));
+}
+
+static bool check(void)
+{
+	for (int i = 0; i < ITEMS; i++) {
+		if (strcmp(items[i].digits, pi_digits) != 0) {
+			printk("item %d computed %s\n", i, items[i].digits);
+			return false;
+		}
+		items[i].digits[0] = '\0';
+	}
+
+	return true;
+}
+
+static uint32_t frame_us(uint32_t start, uint32_t end)
+{
+	return (uint32_t)(k_cyc_to_ns_floor64(end - start) /
+			  (FRAMES * NSEC_PER_USEC));
+}
+
+static uint32_t run_serial(void)
+{
+	uint32_t start = k_cycle_get_32();
+
+	for (int f = 0; f < FRAMES; f++) {
+		for (int i = 0; i < ITEMS; i++) {
+			pi_compute(&items[i]);
+		}
+	}
+
+	return frame_us(start, k_cycle_get_32());
+}
+
+static uint32_t run_queue(struct k_p4wq *queue)
+{
+	uint32_t start = k_cycle_get_32();
+
+	for (int f = 0; f < FRAMES; f++) {
+		for (int i = 0; i < ITEMS; i++) {
+			items[i].work.priority = ITEM_PRIO;
+			items[i].work.deadline = 0;
+			items[i].work.handler = pi_handler;
+		}
+
+		k_p4wq_submit_batch(queue, &batch, item_ptrs, ITEMS);
+		k_p4wq_wait_all(queue, &batch, K_FOREVER);
+	}
+
+	return frame_us(start, k_cycle_get_32());
+}
+
+static void report(const char *name, uint32_t us, uint32_t serial_us)
+{
+	printk("%-14s %6u us/frame speedup %u.%02u%s\n", name, us,
+	       serial_us / MAX(us, 1U), (serial_us * 100U / MAX(us, 1U)) % 100U,
+	       check() ? "" : " WRONG DIGITS");
+}
+
+void main(void)
+{
+	uint32_t serial_us;
+
+	for (int i = 0; i < ITEMS; i++) {
+		item_ptrs[i] = &items[i].work;
+	}
+
+	printk("%d items of %d digits of Pi per frame, %d cpus\n",
+	       ITEMS, DIGITS, CONFIG_MP_NUM_CPUS);
+
+	serial_us = run_serial();
+	report("serial", serial_us, serial_us);
+
+	report("p4wq", run_queue(&pool), serial_us);
+
+#ifdef CONFIG_P4WQ_WORK_STEALING
+	report("work-stealing", run_queue(&steal_pool), serial_us);
+#endif
+
+	printk("fin\n");
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2021 Microchip Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+/* This is a scheduler scaling benchmark.  For 1 to CONFIG_MP_NUM_CPUS
+ * workers, the main thread starts the workers and sleeps for
+ * RUN_TIME_MS.  Each worker loops over scheduler operations only:
+ *
+ * 1. k_sem_give() on its own semaphore (nobody is pending on it)
+ * 2. k_sem_take() of the same semaphore, without waiting
+ * 3. k_yield()
+ *
+ * With one worker per CPU, there is no contention apart from the
+ * scheduler itself, so the reported throughput should scale with the
+ * number of workers.
+ */
+
+#define RUN_TIME_MS 1000
+#define STACK_SIZE 1024
+
+/* Workers are preemptible and below main, which only sleeps */
+#define WORKER_PRIO K_PRIO_PREEMPT(1)
+
+struct worker {
+	struct k_sem sem;
+	uint64_t count;
+} __aligned(64);
+
+static struct worker workers[CONFIG_MP_NUM_CPUS];
+static struct k_thread worker_threads[CONFIG_MP_NUM_CPUS];
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, CONFIG_MP_NUM_CPUS,
+				   STACK_SIZE);
+
+static volatile bool running;
+
+static void worker_fn(void *arg1, void *arg2, void *arg3)
+{
+	struct worker *w = arg1;
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	while (running) {
+		k_sem_give(&w->sem);
+		k_sem_take(&w->sem, K_NO_WAIT);
+		k_yield();
+		w->count++;
+	}
+}
+
+static uint64_t run(int num_workers)
+{
+	uint64_t total = 0U;
+
+	running = true;
+
+	for (int i = 0; i < num_workers; i++) {
+		k_sem_init(&workers[i].sem, 0, 1);
+		workers[i].count = 0U;
+		k_thread_create(&worker_threads[i], worker_stacks[i],
+				STACK_SIZE, worker_fn, &workers[i], NULL, NULL,
+				WORKER_PRIO, 0, K_NO_WAIT);
+	}
+
+	k_msleep(RUN_TIME_MS);
+	running = false;
+
+	for (int i = 0; i < num_workers; i++) {
+		k_thread_join(&worker_threads[i], K_FOREVER);
+		total += workers[i].count;
+	}
+
+	return total * MSEC_PER_SEC / RUN_TIME_MS;
+}
+
+void main(void)
+{
+	uint64_t base = 0U;
+
+	/* Stay above the workers so that the measurement window is
+	 * not stretched by them
+	 */
+	k_thread_priority_set(k_current_get(), K_PRIO_COOP(0));
+
+	for (int n = 1; n <= CONFIG_MP_NUM_CPUS; n++) {
+		uint64_t ops = run(n);
+		uint32_t speedup;
+
+		if (n == 1) {
+			base = ops;
+		}
+		speedup = (base != 0U) ? (uint32_t)(ops * 100U / base) : 0U;
+
+		printk("workers %d ops/s %8u (x%u.%02u)\n", n, (uint32_t)ops,
+		       speedup / 100U, speedup % 100U);
+	}
+	printk("fin\n");
+}
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2021 Microchip Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <timing/timing.h>
+
+/* This is a spinlock contention benchmark.  For 1 to CONFIG_MP_NUM_CPUS
+ * workers, one per CPU, every worker loops over:
+ *
+ * 1. k_spin_lock() on a single shared lock, timed
+ * 2. HOLD_LOOPS iterations of work on shared data
+ * 3. k_spin_unlock()
+ * 4. GAP_LOOPS iterations of work outside of the lock
+ *
+ * The acquire times of the last SAMPLES acquisitions of each worker
+ * are merged to report percentiles, and the spread of the acquisition
+ * counts between workers shows how fair the lock is.  Both ends of an
+ * acquire time are read on the same CPU, as the timing counter may be
+ * local to each CPU.
+ */
+
+#define RUN_TIME_MS 500
+#define STACK_SIZE 1024
+#define SAMPLES 1024
+#define HOLD_LOOPS 20
+#define GAP_LOOPS 20
+
+/* Workers are preemptible and below main, which only sleeps */
+#define WORKER_PRIO K_PRIO_PREEMPT(1)
+
+struct worker {
+	uint32_t count;
+	uint32_t samples[SAMPLES];
+} __aligned(64);
+
+static struct worker workers[CONFIG_MP_NUM_CPUS];
+static struct k_thread worker_threads[CONFIG_MP_NUM_CPUS];
+static K_THREAD_STACK_ARRAY_DEFINE(worker_stacks, CONFIG_MP_NUM_CPUS,
+				   STACK_SIZE);
+
+static uint32_t all_samples[CONFIG_MP_NUM_CPUS * SAMPLES];
+
+static struct k_spinlock bench_lock;
+static volatile uint32_t shared_data;
+static volatile bool go, running;
+
+static inline void work(int loops)
+{
+	for (int i = 0; i < loops; i++) {
+		shared_data++;
+	}
+}
+
+static void worker_fn(void *arg1, void *arg2, void *arg3)
+{
+	struct worker *w = arg1;
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	/* Start contending all at once */
+	while (!go) {
+	}
+
+	while (running) {
+		timing_t start, end;
+		k_spinlock_key_t key;
+
+		start = timing_counter_get();
+		key = k_spin_lock(&bench_lock);
+		end = timing_counter_get();
+		work(HOLD_LOOPS);
+		k_spin_unlock(&bench_lock, key);
+
+		w->samples[w->count % SAMPLES] =
+			(uint32_t)timing_cycles_get(&start, &end);
+		w->count++;
+		work(GAP_LOOPS);
+	}
+}
+
+/* Shell sort, the samples are too many for an insertion sort */
+static void sort(uint32_t *a, size_t n)
+{
+	for (size_t gap = n / 2; gap > 0; gap /= 2) {
+		for (size_t i = gap; i < n; i++) {
+			uint32_t v = a[i];
+			size_t j = i;
+
+			while (j >= gap && a[j - gap] > v) {
+				a[j] = a[j - gap];
+				j -= gap;
+			}
+			a[j] = v;
+		}
+	}
+}
+
+static uint32_t to_ns(uint32_t cycles)
+{
+	return (uint32_t)timing_cycles_to_ns(cycles);
+}
+
+static void run(int num_workers)
+{
+	uint32_t min_count = UINT32_MAX, max_count = 0U;
+	uint64_t total = 0U;
+	size_t n = 0;
+
+	go = false;
+	running = true;
+
+	for (int i = 0; i < num_workers; i++) {
+		workers[i].count = 0U;
+		k_thread_create(&worker_threads[i], worker_stacks[i],
+				STACK_SIZE, worker_fn, &workers[i], NULL, NULL,
+				WORKER_PRIO, 0, K_NO_WAIT);
+	}
+
+	go = true;
+	k_msleep(RUN_TIME_MS);
+	running = false;
+
+	for (int i = 0; i < num_workers; i++) {
+		struct worker *w = &workers[i];
+		uint32_t kept = MIN(w->count, SAMPLES);
+
+		k_thread_join(&worker_threads[i], K_FOREVER);
+
+		for (uint32_t j = 0; j < kept; j++) {
+			all_samples[n++] = w->samples[j];
+		}
+		min_count = MIN(min_count, w->count);
+		max_count = MAX(max_count, w->count);
+		total += w->count;
+	}
+
+	if (n == 0U) {
+		printk("cpus %d no acquisitions\n", num_workers);
+		return;
+	}
+	sort(all_samples, n);
+
+	printk("cpus %d acq/s %8u p50 %6u p90 %6u p99 %6u max %6u ns "
+	       "(per cpu min %u max %u)\n", num_workers,
+	       (uint32_t)(total * MSEC_PER_SEC / RUN_TIME_MS),
+	       to_ns(all_samples[n / 2]), to_ns(all_samples[n * 9 / 10]),
+	       to_ns(all_samples[n * 99 / 100]), to_ns(all_samples[n - 1]),
+	       min_count, max_count);
+}
+
+void main(void)
+{
+	/* Stay above the workers so that the measurement window is
+	 * not stretched by them
+	 */
+	k_thread_priority_set(k_current_get(), K_PRIO_COOP(0));
+
+	timing_init();
+	timing_start();
+
+	printk("%s spinlocks, %d loops held, %d loops between\n",
+	       IS_ENABLED(CONFIG_SPINLOCK_TICKET) ? "ticket" : "cas",
+	       HOLD_LOOPS, GAP_LOOPS);
+
+	for (int n = 1; n <= CONFIG_MP_NUM_CPUS; n++) {
+		run(n);
+	}
+
+	timing_stop();
+	printk("fin\n");
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2021 Microchip Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <timeout_q.h>
+
+/* This is a timeout queue microbenchmark.  Increasing numbers of kernel
+ * timeouts with pseudo-random expiries spread over a long range are
+ * added with z_add_timeout() and then aborted in a different order with
+ * z_abort_timeout(), and the average cost of each operation is reported.
+ * The timeouts never expire, so this measures the queue alone, as pending
+ * protocol timers that are mostly cancelled before they fire would load
+ * it.  A final run lets short timeouts expire and checks that they do in
+ * order of expiry, and in order of addition for the same expiry.
+ */
+
+#define MAX_TIMEOUTS 10000
+#define MAX_TICKS 1000000
+#define EXPIRY_TIMEOUTS 1000
+#define EXPIRY_DELAY 100
+#define EXPIRY_TICKS 20
+
+static const uint32_t counts[] = { 100, 1000, MAX_TIMEOUTS };
+
+static struct _timeout timeouts[MAX_TIMEOUTS];
+static k_ticks_t deadlines[MAX_TIMEOUTS];
+
+static uint32_t expired;
+static uint32_t out_of_order;
+static int64_t last_deadline;
+static uint32_t last_index;
+
+static uint32_t rand_state = 2463534242U;
+
+/* xorshift32, for the same sequence on every platform */
+static uint32_t rand32(void)
+{
+	rand_state ^= rand_state << 13;
+	rand_state ^= rand_state >> 17;
+	rand_state ^= rand_state << 5;
+
+	return rand_state;
+}
+
+static void nop_handler(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+}
+
+static void expiry_handler(struct _timeout *t)
+{
+	uint32_t i = t - timeouts;
+
+	if ((deadlines[i] < last_deadline) ||
+	    ((deadlines[i] == last_deadline) && (i < last_index))) {
+		out_of_order++;
+	}
+
+	last_deadline = deadlines[i];
+	last_index = i;
+	expired++;
+}
+
+static void run(uint32_t count)
+{
+	uint32_t start, add_cycles, abort_cycles;
+
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < count; i++) {
+		z_add_timeout(&timeouts[i], nop_handler,
+			      K_TICKS(1 + (rand32() % MAX_TICKS)));
+	}
+	add_cycles = k_cycle_get_32() - start;
+
+	/* Every other one from the start, then the rest from the end */
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < count; i += 2) {
+		z_abort_timeout(&timeouts[i]);
+	}
+	/* The odd indices, down to 1: i wraps past 0 and ends the loop */
+	for (uint32_t i = count - 1 - (count % 2); i < count; i -= 2) {
+		z_abort_timeout(&timeouts[i]);
+	}
+	abort_cycles = k_cycle_get_32() - start;
+
+	printk("timeouts %5u add %6u abort %6u ns/op\n", count,
+	       (uint32_t)(k_cyc_to_ns_floor64(add_cycles) / count),
+	       (uint32_t)(k_cyc_to_ns_floor64(abort_cycles) / count));
+}
+
+static bool run_expiry(void)
+{
+	int64_t start = k_uptime_ticks() + EXPIRY_DELAY;
+
+	/* Absolute deadlines, far enough to be all added before the first
+	 * one expires, are known exactly.
+	 */
+	for (uint32_t i = 0; i < EXPIRY_TIMEOUTS; i++) {
+		deadlines[i] = start + (rand32() % EXPIRY_TICKS);
+		z_add_timeout(&timeouts[i], expiry_handler,
+			      K_TIMEOUT_ABS_TICKS(deadlines[i]));
+	}
+
+	k_sleep(K_TIMEOUT_ABS_TICKS(start + EXPIRY_TICKS + 1));
+
+	printk("expired %5u in order, %u out of order\n", expired,
+	       out_of_order);
+
+	return (expired == EXPIRY_TIMEOUTS) && (out_of_order == 0U);
+}
+
+void main(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(counts); i++) {
+		run(counts[i]);
+	}
+
+	if (run_expiry()) {
+		printk("fin\n");
+	}
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2021 Microchip Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <timing/timing.h>
+
+/* This is a console output benchmark.  A thread prints a line every
+ * millisecond for a fixed window while a thread at the lowest application
+ * priority counts loop iterations on the same CPU.  The time spent in
+ * printk() per line and the share of the window the counting thread did
+ * not get, against a window without output, are reported.  With the
+ * polled console printk() waits for every character to go out on the
+ * line, with CONFIG_UART_CONSOLE_ASYNC it only queues them.  Note that
+ * emulated UARTs do not pace the output at the baud rate, so the
+ * difference only shows on hardware.
+ */
+
+#define WINDOW_MS 1000
+#define STACK_SIZE 1024
+
+static const char line[] =
+	"0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+static volatile uint64_t idle_count;
+
+K_THREAD_STACK_DEFINE(bench_stack, STACK_SIZE);
+static struct k_thread bench_thread;
+K_THREAD_STACK_DEFINE(idle_stack, STACK_SIZE);
+static struct k_thread idle_thread;
+
+static void idle_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		idle_count++;
+	}
+}
+
+/* Iterations of the counting thread over one window. */
+static uint64_t window(bool output, uint64_t *printk_cycles,
+		       uint32_t *lines)
+{
+	int64_t end;
+	uint64_t start_count;
+
+	*printk_cycles = 0;
+	*lines = 0;
+
+	/* Start on a tick boundary */
+	k_msleep(1);
+	start_count = idle_count;
+	end = k_uptime_get() + WINDOW_MS;
+
+	while (k_uptime_get() < end) {
+		if (output) {
+			timing_t start, stop;
+
+			start = timing_counter_get();
+			printk("%s\n", line);
+			stop = timing_counter_get();
+
+			*printk_cycles += timing_cycles_get(&start, &stop);
+			(*lines)++;
+		}
+		k_msleep(1);
+	}
+
+	return idle_count - start_count;
+}
+
+static void bench_entry(void *p1, void *p2, void *p3)
+{
+	uint64_t base, loaded, cycles;
+	uint32_t lines;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	base = window(false, &cycles, &lines);
+	loaded = window(true, &cycles, &lines);
+
+	/* Let the output drain before reporting */
+	k_msleep(WINDOW_MS);
+
+	printk("printk %6u ns/line, cpu busy %3u%%\n",
+	       (uint32_t)(timing_cycles_to_ns(cycles) / MAX(lines, 1U)),
+	       (uint32_t)((loaded < base) ? (100 * (base - loaded) / base) : 0));
+}
+
+void main(void)
+{
+	timing_init();
+	timing_start();
+
+	k_thread_create(&bench_thread, bench_stack, STACK_SIZE, bench_entry,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, K_FOREVER);
+	k_thread_create(&idle_thread, idle_stack, STACK_SIZE, idle_entry,
+			NULL, NULL, NULL, K_LOWEST_APPLICATION_THREAD_PRIO, 0,
+			K_FOREVER);
+
+	/* On SMP the counting thread would otherwise get a CPU of its own
+	 * and see nothing of the time spent in printk()
+	 */
+	(void)k_thread_cpu_mask_clear(&bench_thread);
+	(void)k_thread_cpu_mask_enable(&bench_thread, 0);
+	(void)k_thread_cpu_mask_clear(&idle_thread);
+	(void)k_thread_cpu_mask_enable(&idle_thread, 0);
+
+	k_thread_start(&idle_thread);
+	k_thread_start(&bench_thread);
+	k_thread_join(&bench_thread, K_FOREVER);
+	k_thread_abort(&idle_thread);
+
+	timing_stop();
+	printk("fin\n");
+}
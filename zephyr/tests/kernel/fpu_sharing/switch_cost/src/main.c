@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2021 Microchip Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Measure the cost of a cooperative context switch between two threads,
+ * with and without floating-point users. With lazy FP sharing a thread
+ * that is allowed to use the FPU but does not touch it should switch as
+ * fast as an integer-only thread.
+ */
+
+#include <ztest.h>
+#include <timing/timing.h>
+
+#define STACKSIZE 1024
+
+/* Both threads are cooperative so that k_yield() ping-pongs between them */
+#define PRIORITY K_PRIO_COOP(0)
+
+#define NUM_SWITCHES 2000
+
+struct k_thread peer_thread;
+K_THREAD_STACK_DEFINE(peer_thread_stack, STACKSIZE);
+
+static volatile double peer_result;
+
+/*
+ * The loops are kept apart so that the integer-only threads never run a
+ * floating-point instruction, which would fault without K_FP_REGS.
+ */
+static void __noinline yield_loop(int count)
+{
+	for (int i = 0; i < count; i++) {
+		k_yield();
+	}
+}
+
+/* The sum stays in an FP register across the switches */
+static double __noinline yield_loop_fp(int count)
+{
+	double acc = 0.0;
+
+	for (int i = 0; i < count; i++) {
+		acc += 0.5;
+		k_yield();
+	}
+
+	return acc;
+}
+
+static void peer_entry(void *p1, void *p2, void *p3)
+{
+	bool use_fp = (bool)(uintptr_t)p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	if (use_fp) {
+		peer_result = yield_loop_fp(NUM_SWITCHES);
+	} else {
+		yield_loop(NUM_SWITCHES);
+	}
+}
+
+/**
+ * @brief Ping-pong with a peer thread and report the cost of a switch
+ *
+ * @param name Description of the threads in the report
+ * @param peer_options Thread options of the peer thread
+ * @param use_fp Whether both threads do floating-point work between
+ *               switches
+ */
+static void measure_switch(const char *name, uint32_t peer_options,
+			   bool use_fp)
+{
+	timing_t start, end;
+	uint64_t cycles;
+
+	k_thread_priority_set(k_current_get(), PRIORITY);
+
+	if (use_fp) {
+		/* The ztest thread is not created with K_FP_REGS */
+		zassert_equal(k_float_enable(k_current_get(), K_FP_REGS), 0,
+			      "cannot enable FP for the main thread");
+	}
+
+	k_thread_create(&peer_thread, peer_thread_stack, STACKSIZE,
+			peer_entry, (void *)(uintptr_t)use_fp, NULL, NULL,
+			PRIORITY, peer_options, K_NO_WAIT);
+
+	/* Let the peer thread start so that thread creation is not timed */
+	k_yield();
+
+	if (use_fp) {
+		double acc;
+
+		start = timing_counter_get();
+		acc = yield_loop_fp(NUM_SWITCHES - 1);
+		end = timing_counter_get();
+
+		k_thread_join(&peer_thread, K_FOREVER);
+
+		/* Each thread must see its own FP registers across switches */
+		zassert_equal(acc, (NUM_SWITCHES - 1) * 0.5,
+			      "FP context of the main thread corrupted");
+		zassert_equal(peer_result, NUM_SWITCHES * 0.5,
+			      "FP context of the peer thread corrupted");
+
+		k_float_disable(k_current_get());
+	} else {
+		start = timing_counter_get();
+		yield_loop(NUM_SWITCHES - 1);
+		end = timing_counter_get();
+
+		k_thread_join(&peer_thread, K_FOREVER);
+	}
+
+	cycles = timing_cycles_get(&start, &end) / ((NUM_SWITCHES - 1) * 2);
+	TC_PRINT("%s: %u cycles, %u ns per switch\n", name, (uint32_t)cycles,
+		 (uint32_t)timing_cycles_to_ns(cycles));
+}
+
+/**
+ * @brief Switch cost between integer-only threads
+ */
+void test_switch_no_fp(void)
+{
+	measure_switch("integer-only threads", 0, false);
+}
+
+/**
+ * @brief Switch cost with an FP-capable thread that does not use the FPU
+ */
+void test_switch_fp_idle(void)
+{
+	measure_switch("idle FP-capable thread", K_FP_REGS, false);
+}
+
+/**
+ * @brief Switch cost between threads using the FPU between switches
+ */
+void test_switch_fp_users(void)
+{
+	measure_switch("FP users", K_FP_REGS, true);
+}
+
+void test_main(void)
+{
+	timing_init();
+	timing_start();
+
+	ztest_test_suite(fpu_switch_cost,
+			 ztest_unit_test(test_switch_no_fp),
+			 ztest_unit_test(test_switch_fp_idle),
+			 ztest_unit_test(test_switch_fp_users));
+	ztest_run_test_suite(fpu_switch_cost);
+
+	timing_stop();
+}
@@ -190,3 +190,61 @@ void test_k_heap_alloc_pending(void)
 
 	k_thread_join(tid, K_FOREVER);
 }
+
+/**
+ * @brief Validate the per-CPU caches of small blocks
+ *
+ * @details A freed small block is served again from the cache of the
+ * CPU, and small blocks held in the caches do not make a large
+ * allocation fail: the caches are flushed before the heap gives up.
+ *
+ * @ingroup kernel_heap_tests
+ *
+ * @see k_heap_cache_stats_get(), k_heap_cache_flush()
+ */
+void test_k_heap_cpu_cache(void)
+{
+#ifdef CONFIG_HEAP_CPU_CACHE
+	struct k_heap_cache_stats before, after;
+	static void *small[HEAP_SIZE / 16];
+	int n;
+
+	k_heap_cache_flush(&k_heap_test);
+	k_heap_cache_stats_get(&k_heap_test, &before);
+
+	/* The thread does not block between these, so it stays on the
+	 * same CPU
+	 */
+	void *p = k_heap_alloc(&k_heap_test, 24, K_NO_WAIT);
+
+	zassert_not_null(p, "k_heap_alloc operation failed");
+	k_heap_free(&k_heap_test, p);
+	zassert_equal_ptr(k_heap_alloc(&k_heap_test, 24, K_NO_WAIT), p,
+			  "freed block not served from the cache");
+	k_heap_free(&k_heap_test, p);
+
+	k_heap_cache_stats_get(&k_heap_test, &after);
+	zassert_true(after.alloc_hits - before.alloc_hits >= 1U, NULL);
+	zassert_true(after.free_hits - before.free_hits >= 2U, NULL);
+
+	/* Fill the heap with small blocks, then free them all, most of
+	 * them into the caches
+	 */
+	for (n = 0; n < ARRAY_SIZE(small); n++) {
+		small[n] = k_heap_alloc(&k_heap_test, 16, K_NO_WAIT);
+		if (small[n] == NULL) {
+			break;
+		}
+	}
+	zassert_true(n > 0, "no small block allocated");
+	while (n > 0) {
+		k_heap_free(&k_heap_test, small[--n]);
+	}
+
+	p = k_heap_alloc(&k_heap_test, ALLOC_SIZE_2, K_NO_WAIT);
+	zassert_not_null(p, "cached blocks were not flushed");
+	k_heap_free(&k_heap_test, p);
+#else
+	ztest_test_skip();
+#endif
+}
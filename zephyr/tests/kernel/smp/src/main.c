@@ -630,6 +630,107 @@ void test_smp_ipi(void)
 	}
 }
 
+/**
+ * @brief Test directed interprocessor interrupt
+ *
+ * @ingroup kernel_smp_integration_tests
+ *
+ * @details Send a scheduler IPI to a single other CPU with
+ * arch_sched_directed_ipi() and check with the per-CPU IPI counters
+ * that this CPU took it.
+ *
+ * @see arch_sched_directed_ipi(), z_smp_ipi_count_get()
+ */
+void test_smp_directed_ipi(void)
+{
+#if defined(CONFIG_ARCH_HAS_DIRECTED_IPIS) && defined(CONFIG_SCHED_IPI_STATS)
+	for (int i = 0; i < 3 ; i++) {
+		unsigned int key = arch_irq_lock();
+		int target = (arch_curr_cpu()->id + 1) % CONFIG_MP_NUM_CPUS;
+		uint32_t before = z_smp_ipi_count_get(target);
+
+		arch_sched_directed_ipi(BIT(target));
+		arch_irq_unlock(key);
+
+		/* Busy wait rather than sleep, a wakeup may signal
+		 * other CPUs too
+		 */
+		k_busy_wait(DELAY_US);
+
+		/**TESTPOINT: check the target CPU took the IPI */
+		zassert_true(z_smp_ipi_count_get(target) != before,
+			     "CPU %d did not receive IPI", target);
+	}
+#else
+	ztest_test_skip();
+#endif
+}
+
+#define SLICE_THREADS (CONFIG_MP_NUM_CPUS + 1)
+#define SLICE_MS 20
+#define SLICE_RUN_MS 500
+
+static struct k_thread slice_threads[SLICE_THREADS];
+static K_THREAD_STACK_ARRAY_DEFINE(slice_stacks, SLICE_THREADS, STACK_SIZE);
+static volatile int slice_counts[SLICE_THREADS];
+static volatile bool slice_running;
+
+static void slice_entry(void *p1, void *p2, void *p3)
+{
+	volatile int *count = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (slice_running) {
+		(*count)++;
+	}
+}
+
+/**
+ * @brief Test time slicing on every CPU
+ *
+ * @ingroup kernel_smp_tests
+ *
+ * @details Run one more busy thread of equal priority than there are
+ * CPUs. Whatever CPU the extra thread waits for, it can only run if
+ * the time slices of that CPU expire, so every thread must have made
+ * progress at the end.
+ *
+ * @see k_sched_time_slice_set()
+ */
+void test_smp_time_slice(void)
+{
+#ifdef CONFIG_TIMESLICING
+	slice_running = true;
+	k_sched_time_slice_set(SLICE_MS, K_PRIO_PREEMPT(EQUAL_PRIORITY));
+
+	for (int i = 0; i < SLICE_THREADS; i++) {
+		slice_counts[i] = 0;
+		k_thread_create(&slice_threads[i], slice_stacks[i],
+				STACK_SIZE, slice_entry,
+				(void *)&slice_counts[i], NULL, NULL,
+				K_PRIO_PREEMPT(EQUAL_PRIORITY), 0, K_NO_WAIT);
+	}
+
+	k_msleep(SLICE_RUN_MS);
+	slice_running = false;
+
+	for (int i = 0; i < SLICE_THREADS; i++) {
+		k_thread_join(&slice_threads[i], K_FOREVER);
+	}
+	k_sched_time_slice_set(0, K_PRIO_PREEMPT(0));
+
+	for (int i = 0; i < SLICE_THREADS; i++) {
+		/**TESTPOINT: every thread got a time slice */
+		zassert_true(slice_counts[i] != 0,
+			     "thread %d never ran", i);
+	}
+#else
+	ztest_test_skip();
+#endif
+}
+
 void k_sys_fatal_error_handler(unsigned int reason, const z_arch_esf_t *pEsf)
 {
 	static int trigger;
@@ -787,6 +888,62 @@ void test_smp_release_global_lock(void)
 	cleanup_resources();
 }
 
+#define STATS_LOCKS 100
+
+/* Generous bound of the size of lock_known_site() */
+#define KNOWN_SITE_MAX_SIZE 64
+
+static __noinline void lock_known_site(void)
+{
+	unsigned int key = irq_lock();
+
+	irq_unlock(key);
+}
+
+/**
+ * @brief Test the attribution of global lock use to call sites
+ *
+ * @ingroup kernel_smp_tests
+ *
+ * @details Take the global lock from one function a known number of
+ * times and check that its call site shows up with that count.
+ *
+ * @see z_smp_global_lock_stats_get()
+ */
+void test_smp_global_lock_stats(void)
+{
+#ifdef CONFIG_SMP_GLOBAL_LOCK_STATS
+	static struct z_smp_global_lock_site
+		sites[CONFIG_SMP_GLOBAL_LOCK_STATS_SITES];
+	uintptr_t start = (uintptr_t)lock_known_site;
+	bool found = false;
+	int n;
+
+	z_smp_global_lock_stats_reset();
+
+	for (int i = 0; i < STATS_LOCKS; i++) {
+		lock_known_site();
+	}
+
+	n = z_smp_global_lock_stats_get(sites, ARRAY_SIZE(sites), NULL);
+	for (int i = 0; i < n; i++) {
+		uintptr_t site = (uintptr_t)sites[i].site;
+
+		if ((site >= start) && (site < start + KNOWN_SITE_MAX_SIZE)) {
+			/**TESTPOINT: every lock is attributed to the site */
+			zassert_equal(sites[i].count, STATS_LOCKS,
+				      "%u locks counted", sites[i].count);
+			found = true;
+		}
+	}
+	zassert_true(found, "call site not recorded");
+
+	z_smp_global_lock_stats_print();
+#else
+	ztest_test_skip();
+#endif
+}
+
 #define LOOP_COUNT 20000
 
 enum sync_t {
@@ -965,10 +1122,13 @@ void test_main(void)
 			 ztest_unit_test(test_sleep_threads),
 			 ztest_unit_test(test_wakeup_threads),
 			 ztest_unit_test(test_smp_ipi),
+			 ztest_unit_test(test_smp_directed_ipi),
+			 ztest_unit_test(test_smp_time_slice),
 			 ztest_unit_test(test_get_cpu),
 			 ztest_unit_test(test_fatal_on_smp),
 			 ztest_unit_test(test_workq_on_smp),
 			 ztest_unit_test(test_smp_release_global_lock),
+			 ztest_unit_test(test_smp_global_lock_stats),
 			 ztest_unit_test(test_inc_concurrency)
 			 );
 	ztest_run_test_suite(smp);
@@ -20,6 +20,15 @@ static struct k_spinlock bounce_lock;
 
 volatile int bounce_owner, bounce_done;
 
+static bool spin_is_locked(struct k_spinlock *l)
+{
+#ifdef CONFIG_SPINLOCK_TICKET
+	return atomic_get(&l->next) != atomic_get(&l->owner);
+#else
+	return l->locked;
+#endif
+}
+
 /**
  * @brief Tests for spinlock
  *
@@ -43,15 +52,15 @@ void test_spinlock_basic(void)
 	k_spinlock_key_t key;
 	static struct k_spinlock l;
 
-	zassert_true(!l.locked, "Spinlock initialized to locked");
+	zassert_true(!spin_is_locked(&l), "Spinlock initialized to locked");
 
 	key = k_spin_lock(&l);
 
-	zassert_true(l.locked, "Spinlock failed to lock");
+	zassert_true(spin_is_locked(&l), "Spinlock failed to lock");
 
 	k_spin_unlock(&l, key);
 
-	zassert_true(!l.locked, "Spinlock failed to unlock");
+	zassert_true(!spin_is_locked(&l), "Spinlock failed to unlock");
 }
 
 void bounce_once(int id)
@@ -151,7 +160,7 @@ void test_spinlock_mutual_exclusion(void)
 
 	key = k_spin_lock(&lock_runtime);
 
-	zassert_true(lock_runtime.locked, "Spinlock failed to lock");
+	zassert_true(spin_is_locked(&lock_runtime), "Spinlock failed to lock");
 
 	/* check irq has not locked */
 	zassert_true(arch_irq_unlocked(key.key),
@@ -171,7 +180,7 @@ void test_spinlock_mutual_exclusion(void)
 
 	k_spin_unlock(&lock_runtime, key);
 
-	zassert_true(!lock_runtime.locked, "Spinlock failed to unlock");
+	zassert_true(!spin_is_locked(&lock_runtime), "Spinlock failed to unlock");
 }
 
 
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2021 Microchip Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Check that idle CPUs actually sleep with a tickless kernel, and measure
+ * how late a sleeping thread is woken up.
+ *
+ * Every time a CPU enters its idle routine it has been woken up, so the
+ * number of idle entries over a quiet period is the number of interrupts
+ * taken by that CPU while it had nothing to do.
+ */
+
+#include <ztest.h>
+#include <tracing_user.h>
+
+#define QUIET_MS 1000
+
+#define NUM_SLEEPS 20
+#define SLEEP_MS 10
+
+static volatile uint32_t idle_entries[CONFIG_MP_NUM_CPUS];
+
+void sys_trace_idle_user(void)
+{
+	idle_entries[arch_curr_cpu()->id]++;
+}
+
+/**
+ * @brief Count the wakeups of each CPU while the system is quiet
+ *
+ * With a periodic tick every CPU would wake up once per tick. Tickless
+ * idle CPUs should only see the few interrupts needed to end the sleep
+ * of the test thread.
+ */
+void test_idle_wakeups(void)
+{
+	uint32_t start[CONFIG_MP_NUM_CPUS];
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		start[i] = idle_entries[i];
+	}
+
+	k_msleep(QUIET_MS);
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		uint32_t wakeups = idle_entries[i] - start[i];
+
+		TC_PRINT("cpu %d: %u idle wakeups in %d ms (tick rate %d Hz)\n",
+			 i, wakeups, QUIET_MS, CONFIG_SYS_CLOCK_TICKS_PER_SEC);
+		zassert_true(wakeups < CONFIG_SYS_CLOCK_TICKS_PER_SEC / 2,
+			     "cpu %d is woken up by the tick", i);
+	}
+}
+
+/**
+ * @brief Measure how late k_msleep() returns
+ */
+void test_wakeup_latency(void)
+{
+	uint32_t expected = k_ms_to_cyc_ceil32(SLEEP_MS);
+	uint32_t tick = k_ticks_to_cyc_ceil32(1);
+	uint32_t min = UINT32_MAX, max = 0U;
+	uint64_t total = 0U;
+
+	for (int i = 0; i < NUM_SLEEPS; i++) {
+		uint32_t late, start;
+
+		/* Start the sleep right after a tick boundary */
+		k_sleep(K_TICKS(1));
+
+		start = k_cycle_get_32();
+		k_msleep(SLEEP_MS);
+		late = k_cycle_get_32() - start;
+
+		zassert_true(late + tick >= expected, "woken up early");
+		late = (late > expected) ? late - expected : 0U;
+
+		min = MIN(min, late);
+		max = MAX(max, late);
+		total += late;
+	}
+
+	TC_PRINT("wakeup latency after %d ms: min %u max %u avg %u us\n",
+		 SLEEP_MS, k_cyc_to_us_floor32(min), k_cyc_to_us_floor32(max),
+		 k_cyc_to_us_floor32((uint32_t)(total / NUM_SLEEPS)));
+}
+
+void test_main(void)
+{
+	ztest_test_suite(tickless_idle,
+			 ztest_unit_test(test_idle_wakeups),
+			 ztest_unit_test(test_wakeup_latency));
+	ztest_run_test_suite(tickless_idle);
+}
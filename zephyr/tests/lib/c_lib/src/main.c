@@ -594,6 +594,136 @@ void test_memmove(void)
 		     "memmove failed");
 }
 
+#define ALIGN_TEST_MAX 200
+
+static uint8_t align_src[ALIGN_TEST_MAX + 16] __aligned(8);
+static uint8_t align_dst[ALIGN_TEST_MAX + 16] __aligned(8);
+static uint8_t align_ref[ALIGN_TEST_MAX + 16] __aligned(8);
+
+/* Byte loops through volatile, so that the compiler does not turn
+ * them back into calls of the functions under test
+ */
+static void ref_copy(uint8_t *d, const uint8_t *s, size_t n)
+{
+	volatile uint8_t *vd = d;
+
+	for (size_t i = 0; i < n; i++) {
+		vd[i] = s[i];
+	}
+}
+
+/* Whether align_dst matches align_ref, without relying on memcmp() */
+static bool ref_equal(void)
+{
+	volatile uint8_t *vd = align_dst;
+	volatile uint8_t *vr = align_ref;
+
+	for (size_t i = 0; i < sizeof(align_dst); i++) {
+		if (vd[i] != vr[i]) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void align_fill(void)
+{
+	volatile uint8_t *vs = align_src;
+	volatile uint8_t *vd = align_dst;
+
+	for (int i = 0; i < sizeof(align_src); i++) {
+		vs[i] = (uint8_t)(i * 7 + 1) & 0x7f;
+		vd[i] = (uint8_t)~i;
+	}
+	ref_copy(align_ref, align_dst, sizeof(align_ref));
+}
+
+/**
+ * @brief Test memory functions over all relative alignments
+ *
+ * @details Word-at-a-time implementations take different paths
+ * depending on the alignment of each buffer and on the length, so
+ * check every combination of offsets within a word over a range of
+ * lengths, including that nothing around the destination is touched.
+ *
+ * @see memcpy(), memmove(), memset(), memcmp().
+ */
+void test_mem_alignments(void)
+{
+	for (int d_off = 0; d_off < 8; d_off++) {
+		for (int s_off = 0; s_off < 8; s_off++) {
+			for (size_t n = 0; n <= ALIGN_TEST_MAX; n += (n < 72) ? 1 : 17) {
+				uint8_t *d = align_dst + d_off;
+				uint8_t *s = align_src + s_off;
+
+				align_fill();
+				ref_copy(align_ref + d_off, s, n);
+				zassert_equal(memcpy(d, s, n), d, "memcpy return");
+				zassert_true(ref_equal(),
+					     "memcpy %zu bytes, offsets %d %d",
+					     n, d_off, s_off);
+				zassert_equal(memcmp(d, s, n), 0,
+					      "memcmp %zu bytes, offsets %d %d",
+					      n, d_off, s_off);
+
+				if (n == 0) {
+					continue;
+				}
+
+				/* Last byte differing, in both directions and
+				 * only when compared as unsigned char
+				 */
+				align_dst[d_off + n - 1] =
+					align_src[s_off + n - 1] | 0x80;
+				zassert_true(memcmp(d, s, n) > 0,
+					     "memcmp %zu bytes, offsets %d %d",
+					     n, d_off, s_off);
+				zassert_true(memcmp(s, d, n) < 0,
+					     "memcmp %zu bytes, offsets %d %d",
+					     n, d_off, s_off);
+
+				align_fill();
+				volatile uint8_t *vr = align_ref + d_off;
+
+				for (size_t i = 0; i < n; i++) {
+					vr[i] = 0xa5;
+				}
+				zassert_equal(memset(d, 0xa5, n), d, "memset return");
+				zassert_true(ref_equal(),
+					     "memset %zu bytes, offset %d",
+					     n, d_off);
+			}
+		}
+	}
+}
+
+/**
+ * @brief Test memmove over overlapping areas in both directions
+ *
+ * @see memmove().
+ */
+void test_memmove_overlap(void)
+{
+	static const int shifts[] = { -9, -8, -3, -1, 1, 3, 8, 9 };
+
+	for (int i = 0; i < ARRAY_SIZE(shifts); i++) {
+		for (size_t n = 0; n <= ALIGN_TEST_MAX - 16; n += 13) {
+			uint8_t *s = align_dst + 9;
+			uint8_t *d = s + shifts[i];
+			uint8_t tmp[ALIGN_TEST_MAX];
+
+			align_fill();
+			ref_copy(tmp, s, n);
+			ref_copy(align_ref + 9 + shifts[i], tmp, n);
+
+			zassert_equal(memmove(d, s, n), d, "memmove return");
+			zassert_true(ref_equal(),
+				     "memmove %zu bytes by %d", n, shifts[i]);
+		}
+	}
+}
+
 /**
  *
  * @brief test str operate functions
@@ -1071,6 +1201,8 @@ void test_main(void)
 			 ztest_unit_test(test_memchr),
 			 ztest_unit_test(test_memcpy),
 			 ztest_unit_test(test_memmove),
+			 ztest_unit_test(test_mem_alignments),
+			 ztest_unit_test(test_memmove_overlap),
 			 ztest_unit_test(test_time),
 			 ztest_unit_test(test_rand),
 			 ztest_unit_test(test_srand),
@@ -966,6 +966,210 @@ void test_overwrite_consistency(void)
 	}
 }
 
+static bool is_older(const union mpsc_pbuf_generic *a,
+		     const union mpsc_pbuf_generic *b)
+{
+	return ((union test_item *)a)->data.data <
+	       ((union test_item *)b)->data.data;
+}
+
+/* Packets put in the buffers of different CPUs come out merged by the
+ * order callback.
+ */
+void test_percpu_merge(void)
+{
+	static struct mpsc_pbuf_percpu pcbuf;
+	struct mpsc_pbuf_buffer_config pcfg = cfg;
+	int repeat = 20;
+	int id = 0;
+
+	pcfg.flags = 0;
+	mpsc_pbuf_percpu_init(&pcbuf, &pcfg, is_older);
+	zassert_false(mpsc_pbuf_percpu_is_pending(&pcbuf), NULL);
+
+	for (int i = 0; i < repeat; i++) {
+		for (int cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+			union test_item item = {
+				.data = {
+					.valid = 1,
+					.len = 1,
+					.data = cpu + i * CONFIG_MP_NUM_CPUS
+				}
+			};
+
+			/* Fill the buffers in reverse CPU order */
+			mpsc_pbuf_put_word(&pcbuf.bufs[CONFIG_MP_NUM_CPUS - 1 - cpu],
+					   item.item);
+		}
+	}
+
+	for (int i = 0; i < repeat * CONFIG_MP_NUM_CPUS; i++) {
+		union test_item *t;
+		uint32_t cpu = i % CONFIG_MP_NUM_CPUS;
+
+		t = (union test_item *)mpsc_pbuf_percpu_claim(&pcbuf);
+		zassert_true(t, NULL);
+		zassert_equal(t->data.data, id++, NULL);
+		zassert_equal(mpsc_pbuf_percpu_find(&pcbuf, &t->item),
+			      &pcbuf.bufs[CONFIG_MP_NUM_CPUS - 1 - cpu], NULL);
+		mpsc_pbuf_percpu_free(&pcbuf, &t->item);
+	}
+
+	zassert_equal(mpsc_pbuf_percpu_claim(&pcbuf), NULL, NULL);
+	zassert_false(mpsc_pbuf_percpu_is_pending(&pcbuf), NULL);
+}
+
+#if defined(CONFIG_SMP) && (CONFIG_MP_NUM_CPUS > 1)
+#define BENCH_WLEN 4
+#define BENCH_PACKETS 20000
+
+K_THREAD_STACK_ARRAY_DEFINE(bench_stacks, CONFIG_MP_NUM_CPUS, 1024);
+static struct k_thread bench_threads[CONFIG_MP_NUM_CPUS];
+static struct mpsc_pbuf_buffer bench_buffer;
+static struct mpsc_pbuf_percpu bench_pcbuf;
+static atomic_t bench_drops;
+static atomic_t bench_alloc_fails;
+static atomic_t bench_done;
+
+static void bench_drop(const struct mpsc_pbuf_buffer *buffer,
+		       const union mpsc_pbuf_generic *item)
+{
+	atomic_inc(&bench_drops);
+}
+
+static void bench_producer(void *p0, void *p1, void *p2)
+{
+	bool percpu = (bool)(uintptr_t)p0;
+
+	for (int i = 0; i < BENCH_PACKETS; i++) {
+		struct mpsc_pbuf_buffer *buffer = percpu ?
+			mpsc_pbuf_percpu_get(&bench_pcbuf) : &bench_buffer;
+		struct test_data_var *t;
+
+		t = (struct test_data_var *)mpsc_pbuf_alloc(buffer, BENCH_WLEN,
+							    K_NO_WAIT);
+		if (t == NULL) {
+			atomic_inc(&bench_alloc_fails);
+			continue;
+		}
+
+		t->hdr.len = BENCH_WLEN;
+		t->hdr.data = i;
+		for (int j = 0; j < BENCH_WLEN - 1; j++) {
+			t->data[j] = i + j;
+		}
+
+		mpsc_pbuf_commit(buffer, (union mpsc_pbuf_generic *)t);
+	}
+
+	atomic_inc(&bench_done);
+}
+
+static uint32_t bench_consume(bool percpu)
+{
+	union test_item *t;
+
+	t = percpu ? (union test_item *)mpsc_pbuf_percpu_claim(&bench_pcbuf) :
+		     (union test_item *)mpsc_pbuf_claim(&bench_buffer);
+	if (t == NULL) {
+		return 0;
+	}
+
+	zassert_equal(t->data.len, BENCH_WLEN, NULL);
+	if (percpu) {
+		mpsc_pbuf_percpu_free(&bench_pcbuf, &t->item);
+	} else {
+		mpsc_pbuf_free(&bench_buffer, &t->item);
+	}
+
+	return 1;
+}
+
+/* Producers on 1 to CONFIG_MP_NUM_CPUS threads allocate and commit packets
+ * as fast as they can, while the test thread consumes them. Packets that
+ * the consumer cannot keep up with are overwritten, and count as sent, as
+ * do the ones that could not be allocated. The test thread sleeps when it
+ * finds the buffer empty, so that a producer sharing its CPU can run.
+ */
+static void benchmark_cpus(bool percpu)
+{
+	struct mpsc_pbuf_buffer_config bcfg = {
+		.buf = buf32,
+		.size = ARRAY_SIZE(buf32),
+		.notify_drop = bench_drop,
+		.get_wlen = get_wlen,
+		.flags = MPSC_PBUF_MODE_OVERWRITE
+	};
+
+	for (int n = 1; n <= CONFIG_MP_NUM_CPUS; n++) {
+		uint32_t consumed = 0;
+		uint32_t total = n * BENCH_PACKETS;
+		int64_t t;
+
+		if (percpu) {
+			mpsc_pbuf_percpu_init(&bench_pcbuf, &bcfg, NULL);
+		} else {
+			mpsc_pbuf_init(&bench_buffer, &bcfg);
+		}
+
+		atomic_clear(&bench_drops);
+		atomic_clear(&bench_alloc_fails);
+		atomic_clear(&bench_done);
+		t = k_uptime_ticks();
+
+		for (int i = 0; i < n; i++) {
+			k_thread_create(&bench_threads[i], bench_stacks[i],
+					K_THREAD_STACK_SIZEOF(bench_stacks[i]),
+					bench_producer,
+					(void *)(uintptr_t)percpu, NULL, NULL,
+					K_PRIO_PREEMPT(1), 0, K_NO_WAIT);
+		}
+
+		while (atomic_get(&bench_done) < n) {
+			if (bench_consume(percpu)) {
+				consumed++;
+			} else {
+				k_sleep(K_TICKS(1));
+			}
+		}
+
+		t = k_uptime_ticks() - t;
+
+		for (int i = 0; i < n; i++) {
+			k_thread_join(&bench_threads[i], K_FOREVER);
+		}
+
+		while (bench_consume(percpu)) {
+			consumed++;
+		}
+
+		zassert_equal(consumed + atomic_get(&bench_drops) +
+			      atomic_get(&bench_alloc_fails), total,
+			      "%u consumed, %u dropped, %u not allocated, %u sent",
+			      consumed, (uint32_t)atomic_get(&bench_drops),
+			      (uint32_t)atomic_get(&bench_alloc_fails), total);
+
+		PRINT("%s buffer, %d producer(s): %u messages/s, %u%% dropped\n",
+		      percpu ? "per-CPU" : "shared", n,
+		      (uint32_t)(total * 1000000ULL /
+				 MAX(k_ticks_to_us_ceil64(t), 1)),
+		      (uint32_t)(atomic_get(&bench_drops) * 100ULL / total));
+	}
+}
+
+void test_benchmark_cpus(void)
+{
+	benchmark_cpus(false);
+	benchmark_cpus(true);
+}
+#else
+void test_benchmark_cpus(void)
+{
+	/* The producers need CPUs of their own */
+	ztest_test_skip();
+}
+#endif /* CONFIG_SMP && CONFIG_MP_NUM_CPUS > 1 */
+
 K_THREAD_STACK_DEFINE(t1_stack, 1024);
 K_THREAD_STACK_DEFINE(t2_stack, 1024);
 
@@ -1081,6 +1285,8 @@ void test_main(void)
 		ztest_unit_test(test_overwrite_while_claimed),
 		ztest_unit_test(test_overwrite_while_claimed2),
 		ztest_unit_test(test_overwrite_consistency),
+		ztest_unit_test(test_percpu_merge),
+		ztest_unit_test(test_benchmark_cpus),
 		ztest_unit_test(test_pending_alloc)
 		);
 	ztest_run_test_suite(test_log_buffer);
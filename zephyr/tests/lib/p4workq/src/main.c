@@ -14,6 +14,24 @@
 
 K_P4WQ_DEFINE(wq, NUM_THREADS, 2048);
 
+#ifdef CONFIG_P4WQ_WORK_STEALING
+/* One thread per CPU, so that fork/join must run nested items */
+K_P4WQ_WORK_STEALING_DEFINE(swq, CONFIG_MP_NUM_CPUS, 2048, 0);
+#endif
+
+#define BATCH_ITEMS 32
+#define FORK_ITEMS 4
+#define JOIN_ITEMS 8
+
+struct batch_item {
+	struct k_p4wq_work item;
+	atomic_t runs;
+};
+
+static struct batch_item batch_items[BATCH_ITEMS];
+static struct k_p4wq_work *batch_ptrs[BATCH_ITEMS];
+static struct k_p4wq_batch batch;
+
 static struct k_p4wq_work simple_item;
 static volatile int has_run;
 static volatile int run_count;
@@ -270,13 +288,163 @@ static void test_p4wq_simple(void)
 	zassert_true(has_run, "high-priority item didn't run");
 }
 
+static void batch_handler(struct k_p4wq_work *item)
+{
+	struct batch_item *bi = CONTAINER_OF(item, struct batch_item, item);
+
+	atomic_inc(&bi->runs);
+	k_busy_wait(10);
+}
+
+static void run_batch(struct k_p4wq *queue)
+{
+	for (int i = 0; i < BATCH_ITEMS; i++) {
+		batch_items[i] = (struct batch_item){};
+		batch_items[i].item.priority = 1;
+		batch_items[i].item.handler = batch_handler;
+		batch_ptrs[i] = &batch_items[i].item;
+	}
+
+	k_p4wq_submit_batch(queue, &batch, batch_ptrs, BATCH_ITEMS);
+	zassert_equal(k_p4wq_wait_all(queue, &batch, K_MSEC(1000)), 0,
+		      "batch didn't complete");
+
+	for (int i = 0; i < BATCH_ITEMS; i++) {
+		zassert_equal(atomic_get(&batch_items[i].runs), 1,
+			      "item %d ran %d times", i,
+			      (int)atomic_get(&batch_items[i].runs));
+	}
+
+	/* An empty batch is complete right away */
+	k_p4wq_submit_batch(queue, &batch, NULL, 0);
+	zassert_equal(k_p4wq_wait_all(queue, &batch, K_NO_WAIT), 0,
+		      "empty batch not complete");
+}
+
+/* Validate that every item of a batch runs once before the wait returns */
+static void test_batch(void)
+{
+	k_thread_priority_set(k_current_get(), 2);
+	run_batch(&wq);
+}
+
+#ifdef CONFIG_P4WQ_WORK_STEALING
+struct fork_item {
+	struct k_p4wq_work item;
+	struct k_p4wq_batch batch;
+	struct batch_item children[JOIN_ITEMS];
+	struct k_p4wq_work *child_ptrs[JOIN_ITEMS];
+	bool joined;
+};
+
+static struct fork_item fork_items[FORK_ITEMS];
+static struct k_p4wq_work *fork_ptrs[FORK_ITEMS];
+
+static void fork_handler(struct k_p4wq_work *item)
+{
+	struct fork_item *fi = CONTAINER_OF(item, struct fork_item, item);
+
+	for (int i = 0; i < JOIN_ITEMS; i++) {
+		fi->children[i] = (struct batch_item){};
+		fi->children[i].item.priority = item->priority;
+		fi->children[i].item.handler = batch_handler;
+		fi->child_ptrs[i] = &fi->children[i].item;
+	}
+
+	k_p4wq_submit_batch(&swq, &fi->batch, fi->child_ptrs, JOIN_ITEMS);
+	fi->joined = k_p4wq_wait_all(&swq, &fi->batch, K_MSEC(1000)) == 0;
+
+	/* Running children on this thread must leave its state alone */
+	zassert_equal(k_thread_priority_get(k_current_get()),
+		      item->priority, "priority not restored");
+}
+
+/* Validate batches on a work-stealing queue */
+static void test_steal_batch(void)
+{
+	k_thread_priority_set(k_current_get(), 2);
+	run_batch(&swq);
+}
+
+/* Validate nested fork/join, with more levels of waiting handlers
+ * than there are threads
+ */
+static void test_steal_fork_join(void)
+{
+	k_thread_priority_set(k_current_get(), 2);
+
+	for (int i = 0; i < FORK_ITEMS; i++) {
+		fork_items[i] = (struct fork_item){};
+		fork_items[i].item.priority = 1;
+		fork_items[i].item.handler = fork_handler;
+		fork_ptrs[i] = &fork_items[i].item;
+	}
+
+	k_p4wq_submit_batch(&swq, &batch, fork_ptrs, FORK_ITEMS);
+	zassert_equal(k_p4wq_wait_all(&swq, &batch, K_MSEC(2000)), 0,
+		      "fork/join didn't complete");
+
+	for (int i = 0; i < FORK_ITEMS; i++) {
+		zassert_true(fork_items[i].joined, "item %d didn't join", i);
+		for (int j = 0; j < JOIN_ITEMS; j++) {
+			zassert_equal(atomic_get(&fork_items[i].children[j].runs),
+				      1, "child %d of %d ran %d times", j, i,
+				      (int)atomic_get(&fork_items[i].children[j].runs));
+		}
+	}
+}
+
+/* Validate that queued items can be cancelled, completing their batch */
+static void test_steal_cancel(void)
+{
+	/* Above the queue threads, so that nothing runs meanwhile */
+	k_thread_priority_set(k_current_get(), -1);
+
+	for (int i = 0; i < BATCH_ITEMS; i++) {
+		batch_items[i] = (struct batch_item){};
+		batch_items[i].item.priority = 1;
+		batch_items[i].item.handler = batch_handler;
+		batch_ptrs[i] = &batch_items[i].item;
+	}
+
+	k_p4wq_submit_batch(&swq, &batch, batch_ptrs, BATCH_ITEMS);
+	for (int i = 0; i < BATCH_ITEMS; i++) {
+		zassert_true(k_p4wq_cancel(&swq, batch_ptrs[i]) ||
+			     atomic_get(&batch_items[i].runs) != 0,
+			     "item %d neither cancelled nor run", i);
+	}
+
+	zassert_equal(k_p4wq_wait_all(&swq, &batch, K_MSEC(1000)), 0,
+		      "cancelled batch didn't complete");
+}
+#else
+static void test_steal_batch(void)
+{
+	ztest_test_skip();
+}
+
+static void test_steal_fork_join(void)
+{
+	ztest_test_skip();
+}
+
+static void test_steal_cancel(void)
+{
+	ztest_test_skip();
+}
+#endif /* CONFIG_P4WQ_WORK_STEALING */
+
 void test_main(void)
 {
 	ztest_test_suite(lib_p4wq_test,
 			 ztest_1cpu_unit_test(test_p4wq_simple),
 			 ztest_unit_test(test_resubmit),
 			 ztest_unit_test(test_fill_queue),
-			 ztest_unit_test(test_stress));
+			 ztest_unit_test(test_stress),
+			 ztest_unit_test(test_batch),
+			 ztest_unit_test(test_steal_batch),
+			 ztest_unit_test(test_steal_fork_join),
+			 ztest_1cpu_unit_test(test_steal_cancel));
 
 	ztest_run_test_suite(lib_p4wq_test);
 }
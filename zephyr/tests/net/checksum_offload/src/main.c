@@ -79,6 +79,7 @@ static struct net_context *udp_v4_ctx_2;
 static bool test_failed;
 static bool test_started;
 static bool start_receiving;
+static bool rx_chksum_done;
 
 static K_SEM_DEFINE(wait_data, 0, UINT_MAX);
 
@@ -152,6 +153,7 @@ static int eth_tx_offloading_disabled(const struct device *dev,
 
 	if (start_receiving) {
 		struct net_udp_hdr hdr, *udp_hdr;
+		struct net_pkt *rx_pkt;
 		uint16_t port;
 		uint8_t lladdr[6];
 
@@ -183,6 +185,14 @@ static int eth_tx_offloading_disabled(const struct device *dev,
 		udp_hdr->src_port = udp_hdr->dst_port;
 		udp_hdr->dst_port = port;
 
+		if (rx_chksum_done) {
+			/* Break the checksum, the packet is marked as
+			 * verified by the device below.
+			 */
+			udp_hdr->chksum = (udp_hdr->chksum == htons(0x1234)) ?
+					  htons(0x4321) : htons(0x1234);
+		}
+
 		memcpy(lladdr,
 		       ((struct net_eth_hdr *)net_pkt_data(pkt))->src.addr,
 		       sizeof(lladdr));
@@ -192,8 +202,12 @@ static int eth_tx_offloading_disabled(const struct device *dev,
 		memcpy(((struct net_eth_hdr *)net_pkt_data(pkt))->dst.addr,
 		       lladdr, sizeof(lladdr));
 
-		if (net_recv_data(net_pkt_iface(pkt),
-				  net_pkt_clone(pkt, K_NO_WAIT)) < 0) {
+		rx_pkt = net_pkt_clone(pkt, K_NO_WAIT);
+		zassert_not_null(rx_pkt, "Cannot clone pkt");
+
+		net_pkt_set_chksum_done(rx_pkt, rx_chksum_done);
+
+		if (net_recv_data(net_pkt_iface(pkt), rx_pkt) < 0) {
 			test_failed = true;
 			zassert_true(false, "Packet %p receive failed\n", pkt);
 		}
@@ -209,6 +223,8 @@ static int eth_tx_offloading_disabled(const struct device *dev,
 		DBG("Chksum 0x%x offloading disabled\n", chksum);
 
 		zassert_not_equal(chksum, 0, "Checksum calculated");
+		zassert_false(net_pkt_is_tx_chksum_offload(pkt),
+			      "Checksum left to the device");
 
 		k_sem_give(&wait_data);
 	}
@@ -238,6 +254,9 @@ static int eth_tx_offloading_enabled(const struct device *dev,
 		DBG("Chksum 0x%x offloading enabled\n", chksum);
 
 		zassert_equal(chksum, 0, "Checksum calculated");
+		zassert_equal(net_pkt_tx_chksum_offset(pkt),
+			      offsetof(struct net_udp_hdr, chksum),
+			      "Checksum offset not set");
 
 		k_sem_give(&wait_data);
 	}
@@ -928,6 +947,42 @@ static void test_rx_chksum_offload_enabled_test_v4(void)
 	k_sleep(K_MSEC(10));
 }
 
+static void test_rx_chksum_done_test_v4(void)
+{
+	int ret, len;
+	struct sockaddr_in dst_addr4 = {
+		.sin_family = AF_INET,
+		.sin_port = htons(TEST_PORT),
+	};
+
+	memcpy(&dst_addr4.sin_addr, &in4addr_dst, sizeof(struct in_addr));
+
+	len = strlen(test_data);
+
+	/* The context is still bound to the interface without offloading
+	 * and receives the looped back packets. Their UDP checksum is
+	 * invalid, but as the packets are flagged as verified by the
+	 * device they must reach the receive callback nevertheless.
+	 */
+	test_started = true;
+	start_receiving = true;
+	rx_chksum_done = true;
+
+	ret = net_context_sendto(udp_v4_ctx_1, test_data, len,
+				 (struct sockaddr *)&dst_addr4,
+				 sizeof(struct sockaddr_in),
+				 NULL, K_FOREVER, NULL);
+	zassert_equal(ret, len, "Send UDP pkt failed (%d)\n", ret);
+
+	if (k_sem_take(&wait_data, WAIT_TIME)) {
+		DBG("Timeout while waiting interface data\n");
+		zassert_false(true, "Timeout");
+	}
+
+	start_receiving = false;
+	rx_chksum_done = false;
+}
+
 void test_main(void)
 {
 	ztest_test_suite(net_chksum_offload_test,
@@ -940,7 +995,8 @@ void test_main(void)
 			 ztest_unit_test(test_rx_chksum_offload_disabled_test_v6),
 			 ztest_unit_test(test_rx_chksum_offload_disabled_test_v4),
 			 ztest_unit_test(test_rx_chksum_offload_enabled_test_v6),
-			 ztest_unit_test(test_rx_chksum_offload_enabled_test_v4)
+			 ztest_unit_test(test_rx_chksum_offload_enabled_test_v4),
+			 ztest_unit_test(test_rx_chksum_done_test_v4)
 			 );
 
 	ztest_run_test_suite(net_chksum_offload_test);
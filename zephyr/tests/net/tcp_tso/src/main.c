@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2021 Microchip Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define NET_LOG_LEVEL CONFIG_NET_TCP_LOG_LEVEL
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_test, NET_LOG_LEVEL);
+
+#include <zephyr/types.h>
+#include <stddef.h>
+#include <string.h>
+#include <errno.h>
+#include <random/rand32.h>
+
+#include <ztest.h>
+
+#include <net/ethernet.h>
+#include <net/net_ip.h>
+#include <net/net_pkt.h>
+#include <net/net_context.h>
+
+#include "ipv6.h"
+#include "tcp2.h"
+#include "tcp2_priv.h"
+#include "net_private.h"
+
+/* The test interface reports TCP segmentation and TX checksum offload. Its
+ * send function plays the peer of the connection: it answers the SYN with
+ * a SYN-ACK announcing TEST_MSS and a large window, and never acknowledges
+ * data. Each send call queues at most one MTU worth of data, which goes
+ * out at once, so the retransmission of the unacknowledged data is the
+ * packet carrying all TEST_DATA_LEN bytes. It is larger than one segment
+ * and, as an IPv6 packet, larger than the interface MTU: it is expected
+ * unfragmented, tagged with the MSS and with the TCP checksum left to the
+ * device.
+ */
+
+#define TEST_MSS 1000
+#define TEST_DATA_LEN (4 * TEST_MSS + 100)
+#define TEST_PEER_PORT 4242
+#define TEST_PEER_ISN 1000
+
+#define WAIT_TIME K_SECONDS(1)
+#define RETRANSMIT_WAIT_TIME K_SECONDS(2)
+
+static struct in6_addr my_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+				       0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+static struct in6_addr peer_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					 0, 0, 0, 0, 0, 0, 0, 0x2 } } };
+
+static uint8_t test_data[TEST_DATA_LEN];
+
+static struct net_if *test_iface;
+
+/* First packet with all of the data seen by the test interface */
+static bool data_seen;
+static bool data_fragmented;
+static uint16_t data_tso_mss;
+static uint8_t data_chksum_offset;
+
+static K_SEM_DEFINE(wait_data, 0, 1);
+
+struct eth_context {
+	uint8_t mac_addr[6];
+};
+
+static struct eth_context eth_context_tso;
+
+static void eth_iface_init(struct net_if *iface)
+{
+	const struct device *dev = net_if_get_device(iface);
+	struct eth_context *context = dev->data;
+
+	net_if_set_link_addr(iface, context->mac_addr,
+			     sizeof(context->mac_addr),
+			     NET_LINK_ETHERNET);
+
+	test_iface = iface;
+
+	ethernet_init(iface);
+}
+
+static void send_syn_ack(struct net_eth_hdr *syn_eth, struct tcphdr *syn)
+{
+	uint8_t mss_opt[NET_TCP_MSS_SIZE] = {
+		NET_TCP_MSS_OPT, NET_TCP_MSS_SIZE, TEST_MSS >> 8,
+		TEST_MSS & 0xff,
+	};
+	struct net_eth_hdr eth = { 0 };
+	struct net_ipv6_hdr ip = { 0 };
+	struct tcphdr th = { 0 };
+	struct net_pkt *rx_pkt;
+	int ret;
+
+	memcpy(&eth.dst, &syn_eth->src, sizeof(eth.dst));
+	memcpy(&eth.src, &syn_eth->dst, sizeof(eth.src));
+	eth.type = htons(NET_ETH_PTYPE_IPV6);
+
+	ip.vtc = 0x60;
+	ip.len = htons(sizeof(th) + sizeof(mss_opt));
+	ip.nexthdr = IPPROTO_TCP;
+	ip.hop_limit = 64;
+	net_ipaddr_copy(&ip.src, &peer_addr);
+	net_ipaddr_copy(&ip.dst, &my_addr);
+
+	th.th_sport = syn->th_dport;
+	th.th_dport = syn->th_sport;
+	th.th_seq = htonl(TEST_PEER_ISN);
+	th.th_ack = htonl(th_seq(syn) + 1);
+	th.th_off = (sizeof(th) + sizeof(mss_opt)) / 4;
+	th.th_flags = SYN | ACK;
+	th.th_win = htons(UINT16_MAX);
+
+	rx_pkt = net_pkt_rx_alloc_with_buffer(test_iface,
+					      sizeof(eth) + sizeof(ip) +
+					      sizeof(th) + sizeof(mss_opt),
+					      AF_UNSPEC, 0, K_NO_WAIT);
+	zassert_not_null(rx_pkt, "Cannot allocate SYN-ACK");
+
+	ret = net_pkt_write(rx_pkt, &eth, sizeof(eth));
+	ret |= net_pkt_write(rx_pkt, &ip, sizeof(ip));
+	ret |= net_pkt_write(rx_pkt, &th, sizeof(th));
+	ret |= net_pkt_write(rx_pkt, mss_opt, sizeof(mss_opt));
+	zassert_equal(ret, 0, "Cannot write SYN-ACK");
+
+	/* The TCP checksum is left to the device on TX, and the device is
+	 * trusted to have verified it on RX.
+	 */
+	net_pkt_set_chksum_done(rx_pkt, true);
+
+	ret = net_recv_data(test_iface, rx_pkt);
+	zassert_equal(ret, 0, "Cannot receive SYN-ACK");
+}
+
+static int eth_tx(const struct device *dev, struct net_pkt *pkt)
+{
+	struct net_eth_hdr eth;
+	struct net_ipv6_hdr ip;
+	struct tcphdr th;
+	size_t len;
+
+	ARG_UNUSED(dev);
+
+	net_pkt_cursor_init(pkt);
+
+	if (net_pkt_read(pkt, &eth, sizeof(eth)) ||
+	    ntohs(eth.type) != NET_ETH_PTYPE_IPV6 ||
+	    net_pkt_read(pkt, &ip, sizeof(ip))) {
+		return 0;
+	}
+
+	if (ip.nexthdr == NET_IPV6_NEXTHDR_FRAG) {
+		data_fragmented = true;
+		return 0;
+	}
+
+	if (ip.nexthdr != IPPROTO_TCP) {
+		return 0;
+	}
+
+	if (net_pkt_read(pkt, &th, sizeof(th))) {
+		return 0;
+	}
+
+	if (th_flags(&th) & SYN) {
+		send_syn_ack(&eth, &th);
+		return 0;
+	}
+
+	len = net_pkt_get_len(pkt) - sizeof(eth) - sizeof(ip) -
+	      th_off(&th) * 4;
+	if (len != TEST_DATA_LEN || data_seen) {
+		return 0;
+	}
+
+	data_seen = true;
+	data_tso_mss = net_pkt_tso_mss(pkt);
+	data_chksum_offset = net_pkt_tx_chksum_offset(pkt);
+
+	k_sem_give(&wait_data);
+
+	return 0;
+}
+
+static enum ethernet_hw_caps eth_capabilities(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	return ETHERNET_HW_TX_TSO | ETHERNET_HW_TX_CHKSUM_OFFLOAD;
+}
+
+static struct ethernet_api api_funcs_tso = {
+	.iface_api.init = eth_iface_init,
+
+	.get_capabilities = eth_capabilities,
+	.send = eth_tx,
+};
+
+static int eth_init(const struct device *dev)
+{
+	struct eth_context *context = dev->data;
+
+	/* 00-00-5E-00-53-xx Documentation RFC 7042 */
+	context->mac_addr[0] = 0x00;
+	context->mac_addr[1] = 0x00;
+	context->mac_addr[2] = 0x5E;
+	context->mac_addr[3] = 0x00;
+	context->mac_addr[4] = 0x53;
+	context->mac_addr[5] = sys_rand32_get();
+
+	return 0;
+}
+
+ETH_NET_DEVICE_INIT(eth_tso_test, "eth_tso_test",
+		    eth_init, NULL, &eth_context_tso, NULL,
+		    CONFIG_ETH_INIT_PRIORITY, &api_funcs_tso, NET_ETH_MTU);
+
+static void test_setup(void)
+{
+	struct net_linkaddr_storage llstorage = {
+		.addr = { 0x00, 0x00, 0x5E, 0x00, 0x53, 0xff },
+	};
+	struct net_linkaddr lladdr = {
+		.addr = llstorage.addr,
+		.len = 6U,
+		.type = NET_LINK_ETHERNET,
+	};
+	struct net_if_addr *ifaddr;
+
+	zassert_not_null(test_iface, "No test interface");
+	zassert_true(net_if_is_tcp_tso_supported(test_iface),
+		     "TSO not supported by the test interface");
+
+	ifaddr = net_if_ipv6_addr_add(test_iface, &my_addr, NET_ADDR_MANUAL, 0);
+	zassert_not_null(ifaddr, "Cannot add IPv6 address");
+
+	/* For testing purposes we need to set the address preferred */
+	ifaddr->addr_state = NET_ADDR_PREFERRED;
+
+	zassert_not_null(net_ipv6_nbr_add(test_iface, &peer_addr, &lladdr,
+					  false, NET_IPV6_NBR_STATE_REACHABLE),
+			 "Cannot add neighbor");
+
+	for (size_t i = 0; i < sizeof(test_data); i++) {
+		test_data[i] = (uint8_t)i;
+	}
+}
+
+static void test_tso_send(void)
+{
+	struct sockaddr_in6 src = {
+		.sin6_family = AF_INET6,
+		.sin6_port = 0,
+	};
+	struct sockaddr_in6 dst = {
+		.sin6_family = AF_INET6,
+		.sin6_port = htons(TEST_PEER_PORT),
+	};
+	struct net_context *ctx;
+	size_t sent;
+	int ret;
+
+	net_ipaddr_copy(&src.sin6_addr, &my_addr);
+	net_ipaddr_copy(&dst.sin6_addr, &peer_addr);
+
+	ret = net_context_get(AF_INET6, SOCK_STREAM, IPPROTO_TCP, &ctx);
+	zassert_equal(ret, 0, "Cannot get TCP context (%d)", ret);
+
+	ret = net_context_bind(ctx, (struct sockaddr *)&src, sizeof(src));
+	zassert_equal(ret, 0, "Cannot bind TCP context (%d)", ret);
+
+	ret = net_context_connect(ctx, (struct sockaddr *)&dst, sizeof(dst),
+				  NULL, WAIT_TIME, NULL);
+	zassert_equal(ret, 0, "Cannot connect (%d)", ret);
+
+	for (sent = 0; sent < sizeof(test_data); sent += ret) {
+		ret = net_context_send(ctx, test_data + sent,
+				       sizeof(test_data) - sent, NULL,
+				       K_NO_WAIT, NULL);
+		zassert_true(ret > 0, "Cannot send data (%d)", ret);
+	}
+
+	ret = k_sem_take(&wait_data, RETRANSMIT_WAIT_TIME);
+
+	zassert_false(data_fragmented, "Packet for TSO was IPv6 fragmented");
+	zassert_equal(ret, 0, "Data not sent in one packet");
+	zassert_equal(data_tso_mss, TEST_MSS, "Wrong TSO MSS (%u)",
+		      data_tso_mss);
+	zassert_equal(data_chksum_offset,
+		      offsetof(struct net_tcp_hdr, chksum),
+		      "Wrong TX checksum offset (%u)", data_chksum_offset);
+
+	net_context_put(ctx);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(net_tcp_tso_test,
+			 ztest_unit_test(test_setup),
+			 ztest_unit_test(test_tso_send));
+
+	ztest_run_test_suite(net_tcp_tso_test);
+}
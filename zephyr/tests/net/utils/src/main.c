@@ -848,11 +848,119 @@ void test_addr_parse(void)
 #endif
 }
 
+#define CHKSUM_MAX_LEN (NET_IPV4H_LEN + 600)
+#define CHKSUM_BUF_SIZE 128
+
+NET_BUF_POOL_DEFINE(chksum_pool, 32, CHKSUM_BUF_SIZE, 0, NULL);
+
+static uint8_t chksum_data[CHKSUM_MAX_LEN];
+
+/* Word by word sum of the UDP pseudo header and the payload. The addresses
+ * of the pseudo header are the last bytes of the IPv4 header, right in front
+ * of the payload.
+ */
+static uint16_t ref_chksum_udp(const uint8_t *data, size_t len)
+{
+	uint32_t sum = len - NET_IPV4H_LEN + IPPROTO_UDP;
+	size_t i;
+
+	for (i = NET_IPV4H_LEN - 2 * sizeof(struct in_addr); i < len; i += 2) {
+		sum += (data[i] << 8) | ((i + 1 < len) ? data[i + 1] : 0);
+	}
+
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	sum = (sum == 0U) ? 0xffff : htons(sum);
+
+	return ~sum;
+}
+
+/* Spreads len bytes of chksum_data over fragments of various lengths and
+ * alignments, the variant selects where the pattern starts.
+ */
+static struct net_pkt *chksum_pkt_alloc(size_t len, int variant)
+{
+	static const uint8_t frag_lens[] = { 1, 2, 3, 8, 13, 57, 100 };
+	struct net_buf *frag;
+	struct net_pkt *pkt;
+	size_t pos = 0;
+	size_t chunk;
+	int i = variant;
+
+	pkt = net_pkt_alloc(K_NO_WAIT);
+	if (!pkt) {
+		return NULL;
+	}
+
+	net_pkt_set_family(pkt, AF_INET);
+	net_pkt_set_ip_hdr_len(pkt, NET_IPV4H_LEN);
+
+	while (pos < len) {
+		frag = net_buf_alloc(&chksum_pool, K_NO_WAIT);
+		if (!frag) {
+			net_pkt_unref(pkt);
+			return NULL;
+		}
+
+		net_buf_reserve(frag, i % 8);
+
+		/* The IPv4 header is always in the first fragment */
+		chunk = frag_lens[i % ARRAY_SIZE(frag_lens)] +
+			(pos ? 0 : NET_IPV4H_LEN);
+		chunk = MIN(chunk, len - pos);
+
+		net_buf_add_mem(frag, chksum_data + pos, chunk);
+		net_pkt_frag_add(pkt, frag);
+
+		pos += chunk;
+		i++;
+	}
+
+	return pkt;
+}
+
+void test_chksum(void)
+{
+	static const size_t lens[] = {
+		0, 1, 2, 3, 7, 8, 9, 15, 16, 17, 63, 64, 65, 255, 600
+	};
+	struct net_pkt *pkt;
+	size_t len;
+	int fill, l, v;
+	size_t i;
+
+	/* All ones data makes every addition carry */
+	for (fill = 0; fill < 2; fill++) {
+		for (i = 0; i < sizeof(chksum_data); i++) {
+			chksum_data[i] = fill ? 0xff : (uint8_t)(i * 131U + 7U);
+		}
+
+		for (l = 0; l < ARRAY_SIZE(lens); l++) {
+			len = NET_IPV4H_LEN + lens[l];
+
+			for (v = 0; v < 8; v++) {
+				pkt = chksum_pkt_alloc(len, v);
+				zassert_not_null(pkt, "Cannot allocate pkt");
+
+				zassert_equal(net_calc_chksum(pkt, IPPROTO_UDP),
+					      ref_chksum_udp(chksum_data, len),
+					      "Checksum mismatch, %zu bytes, "
+					      "variant %d", lens[l], v);
+
+				net_pkt_unref(pkt);
+			}
+		}
+	}
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_utils_fn,
 			 ztest_user_unit_test(test_net_addr),
-			 ztest_unit_test(test_addr_parse));
+			 ztest_unit_test(test_addr_parse),
+			 ztest_unit_test(test_chksum));
 
 	ztest_run_test_suite(test_utils_fn);
 }
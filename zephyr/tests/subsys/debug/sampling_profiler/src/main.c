@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2021 Microchip Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Profile a busy loop and check that the samples land in it.
+ */
+
+#include <ztest.h>
+#include <debug/sampling_profiler.h>
+
+#define PERIOD_US 1000
+#define BUSY_MS 500
+#define EXPECTED_SAMPLES (BUSY_MS * USEC_PER_MSEC / PERIOD_US)
+
+/* Generous bound of the size of busy_loop() */
+#define BUSY_LOOP_MAX_SIZE 256
+
+static volatile uint32_t sink;
+
+static struct sampling_profiler_record records[CONFIG_SAMPLING_PROFILER_BUF_RECORDS];
+
+static __noinline void busy_loop(uint32_t ms)
+{
+	int64_t end = k_uptime_get() + ms;
+
+	/* Most of the time is spent in the inner loop, which calls
+	 * nothing
+	 */
+	do {
+		for (int i = 0; i < 1000; i++) {
+			sink = sink * 31U + i;
+		}
+	} while (k_uptime_get() < end);
+}
+
+static bool in_busy_loop(uintptr_t pc)
+{
+	uintptr_t start = (uintptr_t)busy_loop;
+
+	return (pc >= start) && (pc < start + BUSY_LOOP_MAX_SIZE);
+}
+
+static void drain(void)
+{
+	for (int cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+		while (sampling_profiler_read(cpu, records,
+					      ARRAY_SIZE(records)) != 0U) {
+		}
+	}
+}
+
+/**
+ * @brief Check the argument and state checks of start
+ */
+void test_start_errors(void)
+{
+	zassert_equal(sampling_profiler_start(0), -EINVAL, NULL);
+	zassert_equal(sampling_profiler_start(PERIOD_US), 0, NULL);
+	zassert_equal(sampling_profiler_start(PERIOD_US), -EALREADY, NULL);
+	sampling_profiler_stop();
+
+	/* Stopping twice is harmless */
+	sampling_profiler_stop();
+}
+
+/**
+ * @brief Check that a busy loop collects most of the samples of its CPU
+ */
+void test_busy_loop_samples(void)
+{
+	uint32_t total = 0U, hits = 0U;
+
+	drain();
+
+	zassert_equal(sampling_profiler_start(PERIOD_US), 0, NULL);
+	busy_loop(BUSY_MS);
+	sampling_profiler_stop();
+
+	for (int cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+		size_t n;
+
+		while ((n = sampling_profiler_read(cpu, records,
+						   ARRAY_SIZE(records))) != 0U) {
+			for (size_t i = 0; i < n; i++) {
+				hits += in_busy_loop(records[i].pc) ? 1U : 0U;
+			}
+			total += n;
+		}
+		zassert_equal(sampling_profiler_dropped(cpu), 0, NULL);
+	}
+
+	TC_PRINT("%u samples, %u in busy_loop, %u expected per CPU\n",
+		 total, hits, EXPECTED_SAMPLES);
+
+	zassert_true(total >= EXPECTED_SAMPLES / 2, "too few samples");
+	zassert_true(hits >= EXPECTED_SAMPLES / 2,
+		     "samples are not in the busy loop");
+}
+
+/**
+ * @brief Check that no samples are taken once stopped
+ */
+void test_stopped(void)
+{
+	zassert_equal(sampling_profiler_start(PERIOD_US), 0, NULL);
+	k_msleep(10);
+	sampling_profiler_stop();
+	drain();
+
+	busy_loop(10 * PERIOD_US / USEC_PER_MSEC);
+
+	for (int cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+		zassert_equal(sampling_profiler_read(cpu, records, 1), 0,
+			      "cpu %d sampled while stopped", cpu);
+	}
+}
+
+/**
+ * @brief Dump a short profile in the format of flat_profile.py
+ */
+void test_dump(void)
+{
+	zassert_equal(sampling_profiler_start(PERIOD_US), 0, NULL);
+	busy_loop(20);
+	sampling_profiler_stop();
+
+	sampling_profiler_dump();
+
+	for (int cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+		zassert_equal(sampling_profiler_read(cpu, records, 1), 0,
+			      "dump left records of cpu %d", cpu);
+	}
+}
+
+void test_main(void)
+{
+	ztest_test_suite(sampling_profiler,
+			 ztest_unit_test(test_start_errors),
+			 ztest_unit_test(test_busy_loop_samples),
+			 ztest_unit_test(test_stopped),
+			 ztest_unit_test(test_dump));
+	ztest_run_test_suite(sampling_profiler);
+}
@@ -0,0 +1,16 @@
+# Copyright (c) 2021 Microchip Inc.
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import pytest
+
+# Twister passes the build directory with "--cmdopt".
+def pytest_addoption(parser):
+    parser.addoption(
+        '--cmdopt'
+    )
+
+# Session scope so that the target only runs once for all test cases.
+@pytest.fixture(scope="session")
+def cmdopt(request):
+    return request.config.getoption('--cmdopt')
@@ -0,0 +1,169 @@
+# Copyright (c) 2021 Microchip Inc.
+#
+# SPDX-License-Identifier: Apache-2.0
+
+'''
+Round trip of dictionary-based logging: run the test image, capture the
+framed log records it writes to the console UART, decode them with
+scripts/logging/dictionary/log_parser.py and compare the result with the
+messages logged by src/main.c.
+'''
+
+import binascii
+import os
+import re
+import signal
+import struct
+import subprocess
+import sys
+import time
+
+import pytest
+
+ZEPHYR_BASE = os.environ.get('ZEPHYR_BASE',
+                             os.path.abspath(os.path.join(os.path.dirname(__file__),
+                                                          *[os.pardir] * 5)))
+LOG_PARSER = os.path.join(ZEPHYR_BASE, 'scripts', 'logging', 'dictionary',
+                          'log_parser.py')
+
+# Printed by src/main.c once all log records are out.
+DONE_MARKER = b'LOG_DICTIONARY_DONE'
+# Printed by the UART backend at init in hexadecimal mode.
+HEX_SEP = b'##ZLOGV1##'
+# Keep in sync with include/logging/log_output_dict.h
+FRAME_SYNC = b'\xa5\x5a'
+
+RUN_TIMEOUT = 60
+
+# Decoded output of src/main.c, without timestamps.
+EXPECTED = [
+    '<inf> test: dictionary round trip',
+    '<err> test: error -1',
+    '<wrn> test: int -32, uint 33, hex 0xbeef',
+    '<dbg> test: main: int64_t -64, uint64_t 18446744073709551615',
+    '<inf> test: char !, static static str',
+    '<inf> test: transient transient str',
+    '<inf> test: hexdump',
+    '64 69 63 74 69 6f 6e 61  72 79' + ' ' * 19 + '|dictiona ry',
+    '<inf> test: dictionary round trip done',
+]
+
+
+def read_config(build_dir):
+    config = {}
+    with open(os.path.join(build_dir, 'zephyr', '.config')) as cfile:
+        for line in cfile:
+            if line.startswith('CONFIG_') and '=' in line:
+                name, val = line.strip().split('=', 1)
+                config[name] = val
+    return config
+
+
+def run_target(build_dir):
+    '''Run the image and return its console output up to DONE_MARKER'''
+    proc = subprocess.Popen(['cmake', '--build', build_dir, '--target', 'run'],
+                            stdout=subprocess.PIPE, stderr=subprocess.DEVNULL,
+                            start_new_session=True)
+    output = b''
+    deadline = time.time() + RUN_TIMEOUT
+
+    try:
+        os.set_blocking(proc.stdout.fileno(), False)
+        while DONE_MARKER not in output and time.time() < deadline:
+            if proc.poll() is not None:
+                break
+            chunk = proc.stdout.read()
+            if chunk:
+                output += chunk
+            else:
+                time.sleep(0.1)
+    finally:
+        os.killpg(proc.pid, signal.SIGTERM)
+        proc.wait()
+
+    assert DONE_MARKER in output, 'target did not complete'
+    return output[:output.index(DONE_MARKER)]
+
+
+def decode(build_dir, logdata, tmp_path):
+    '''Decode binary log data, return exit code and normalized lines'''
+    logfile = os.path.join(tmp_path, 'log.bin')
+    with open(logfile, 'wb') as lfile:
+        lfile.write(logdata)
+
+    dbfile = os.path.join(build_dir, 'zephyr', 'log_dictionary.json')
+    ret = subprocess.run([sys.executable, LOG_PARSER, dbfile, logfile],
+                         stdout=subprocess.PIPE, check=False)
+
+    lines = []
+    for line in ret.stdout.decode('utf-8').splitlines():
+        line = re.sub(r'\x1b\[[0-9;]*m', '', line)
+        line = re.sub(r'^\[\s*\d+\] ', '', line).strip()
+        if line:
+            lines.append(line)
+
+    return ret.returncode, lines
+
+
+def frame_offsets(logdata):
+    '''Offsets of the frames in framed log data'''
+    offsets = []
+    offset = logdata.index(FRAME_SYNC)
+    while logdata[offset:(offset + len(FRAME_SYNC))] == FRAME_SYNC:
+        offsets.append(offset)
+        rec_len = struct.unpack_from('<H', logdata, offset + len(FRAME_SYNC))[0]
+        offset += len(FRAME_SYNC) + 2 + rec_len + 2
+    return offsets
+
+
+@pytest.fixture(scope='session')
+def logdata(cmdopt):
+    config = read_config(cmdopt)
+    assert config.get('CONFIG_LOG_DICTIONARY_FRAMED') == 'y'
+
+    output = run_target(cmdopt)
+
+    if config.get('CONFIG_LOG_BACKEND_UART_OUTPUT_DICTIONARY_HEX') == 'y':
+        assert HEX_SEP in output, 'no log data'
+        hexdata = output[output.index(HEX_SEP) + len(HEX_SEP):].strip()
+        return binascii.unhexlify(hexdata)
+
+    # Binary frames are found among any other console output.
+    return output
+
+
+def test_round_trip(cmdopt, logdata, tmp_path):
+    ret, lines = decode(cmdopt, logdata, tmp_path)
+
+    assert ret == 0
+    assert lines == EXPECTED
+
+
+def test_resync_after_corruption(cmdopt, logdata, tmp_path):
+    offsets = frame_offsets(logdata)
+    assert len(offsets) == 8
+
+    # Flip a byte in the record of the second frame (the error message):
+    # that message alone is lost and reported.
+    corrupted = bytearray(logdata)
+    corrupted[offsets[1] + 6] ^= 0xff
+
+    ret, lines = decode(cmdopt, bytes(corrupted), tmp_path)
+
+    assert ret != 0
+    assert lines == EXPECTED[:1] + EXPECTED[2:]
+
+
+def test_skip_foreign_output(cmdopt, logdata, tmp_path):
+    # Text interleaved with the frames, e.g. from printk(), is skipped.
+    offset = frame_offsets(logdata)[3]
+    mixed = logdata[:offset] + b'\r\nconsole text\r\n' + logdata[offset:]
+
+    ret, lines = decode(cmdopt, mixed, tmp_path)
+
+    assert ret == 0
+    assert lines == EXPECTED
+
+
+if __name__ == '__main__':
+    pytest.main()
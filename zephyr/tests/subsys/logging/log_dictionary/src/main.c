@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2021 Microchip Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Logs a fixed set of messages through the dictionary-based UART backend.
+ * The host side (pytest/test_log_dictionary.py) decodes the captured output
+ * with the dictionary log parser and compares it with the expected text, so
+ * any change here must be mirrored there.
+ */
+
+#include <inttypes.h>
+#include <zephyr.h>
+#include <string.h>
+#include <sys/printk.h>
+#include <logging/log.h>
+#include <logging/log_ctrl.h>
+
+LOG_MODULE_REGISTER(test, LOG_LEVEL_DBG);
+
+static const uint8_t hexdump_data[] = "dictionary";
+
+void main(void)
+{
+	char transient[16];
+
+	strcpy(transient, "transient str");
+
+	LOG_INF("dictionary round trip");
+	LOG_ERR("error %d", -1);
+	LOG_WRN("int %d, uint %u, hex 0x%x", -32, 33U, 0xbeefU);
+	LOG_DBG("int64_t %" PRId64 ", uint64_t %" PRIu64,
+		(int64_t)-64, (uint64_t)UINT64_MAX);
+	LOG_INF("char %c, static %s", '!', "static str");
+	LOG_INF("transient %s", transient);
+	LOG_HEXDUMP_INF(hexdump_data, strlen((const char *)hexdump_data),
+			"hexdump");
+	LOG_INF("dictionary round trip done");
+
+	while (log_process(false)) {
+	}
+
+	/* Not logged, so it reaches the console as plain text after all log
+	 * records and tells the host it can stop capturing.
+	 */
+	printk("\nLOG_DICTIONARY_DONE\n");
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2021 Microchip Inc.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Test per-CPU log message buffers
+ */
+
+#include <logging/log_core.h>
+#include <logging/log_msg2.h>
+#include <logging/log_internal.h>
+#include <logging/log_ctrl.h>
+
+#include <zephyr.h>
+#include <ztest.h>
+
+#define STACK_SIZE (1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define MSGS_PER_CPU 4
+#define FLOOD_MSGS 100
+
+static K_THREAD_STACK_DEFINE(stack, STACK_SIZE);
+static struct k_thread thread;
+
+static log_timestamp_t cpu_timestamp[CONFIG_MP_NUM_CPUS];
+
+/* CPU n gets timestamps n, n + CONFIG_MP_NUM_CPUS, n + 2 * ... */
+static log_timestamp_t timestamp_get(void)
+{
+	unsigned int key = arch_irq_lock();
+	log_timestamp_t *t = &cpu_timestamp[arch_curr_cpu()->id];
+	log_timestamp_t ret = *t;
+
+	*t += CONFIG_MP_NUM_CPUS;
+	arch_irq_unlock(key);
+
+	return ret;
+}
+
+static void test_init(void)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		cpu_timestamp[i] = i;
+	}
+
+	z_log_msg2_init();
+	log_set_timestamp_func(timestamp_get, 0);
+}
+
+static void log_entry(void *p1, void *p2, void *p3)
+{
+	int cnt = POINTER_TO_INT(p1);
+
+	for (int i = 0; i < cnt; i++) {
+		z_log_msg2_runtime_create(0, (void *)1, LOG_LEVEL_INF, NULL, 0,
+					  "test %d", i);
+	}
+}
+
+/* Log from a thread pinned to @p cpu */
+static void log_on_cpu(int cpu, int cnt)
+{
+	k_thread_create(&thread, stack, STACK_SIZE, log_entry,
+			INT_TO_POINTER(cnt), NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, K_FOREVER);
+	zassert_equal(k_thread_cpu_mask_clear(&thread), 0, NULL);
+	zassert_equal(k_thread_cpu_mask_enable(&thread, cpu), 0, NULL);
+	k_thread_start(&thread);
+	k_thread_join(&thread, K_FOREVER);
+}
+
+/* Messages of all CPUs come out in timestamp order */
+void test_percpu_merge(void)
+{
+	union log_msg2_generic *msg;
+
+	test_init();
+
+	for (int cpu = CONFIG_MP_NUM_CPUS - 1; cpu >= 0; cpu--) {
+		log_on_cpu(cpu, MSGS_PER_CPU);
+	}
+
+	zassert_equal(log_buffered_cnt(), MSGS_PER_CPU * CONFIG_MP_NUM_CPUS,
+		      NULL);
+
+	for (int i = 0; i < MSGS_PER_CPU * CONFIG_MP_NUM_CPUS; i++) {
+		msg = z_log_msg2_claim();
+		zassert_true(msg != NULL, NULL);
+		zassert_equal(log_msg2_get_timestamp(&msg->log), i,
+			      "Unexpected timestamp order");
+		z_log_msg2_free(msg);
+	}
+
+	zassert_equal(z_log_msg2_claim(), NULL, "Expected no pending messages");
+	zassert_false(z_log_msg2_pending(), NULL);
+	zassert_equal(z_log_dropped_read_and_clear(), 0, NULL);
+}
+
+/* A CPU overflowing its buffer does not take space from the others, and
+ * its drops are counted for it alone.
+ */
+void test_percpu_drop(void)
+{
+	int flood_cpu = CONFIG_MP_NUM_CPUS - 1;
+	union log_msg2_generic *msg;
+	uint32_t cnt = 0;
+
+	test_init();
+
+	log_on_cpu(flood_cpu, FLOOD_MSGS);
+	log_on_cpu(0, MSGS_PER_CPU);
+
+	while ((msg = z_log_msg2_claim()) != NULL) {
+		cnt++;
+		z_log_msg2_free(msg);
+	}
+
+	for (int cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+		uint32_t dropped = z_log_dropped_cpu_read_and_clear(cpu);
+
+		if (cpu == flood_cpu) {
+			zassert_true(dropped > 0, NULL);
+			zassert_equal(cnt + dropped, FLOOD_MSGS + MSGS_PER_CPU,
+				      NULL);
+		} else {
+			zassert_equal(dropped, 0, "CPU %d dropped %u", cpu,
+				      dropped);
+		}
+	}
+
+	zassert_false(z_log_dropped_pending(), NULL);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(test_log_percpu,
+			 ztest_unit_test(test_percpu_merge),
+			 ztest_unit_test(test_percpu_drop));
+	ztest_run_test_suite(test_log_percpu);
+}
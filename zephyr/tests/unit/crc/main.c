@@ -11,6 +11,7 @@
 #include "../../../lib/os/crc32_sw.c"
 #include "../../../lib/os/crc32c_sw.c"
 #include "../../../lib/os/crc7_sw.c"
+#include "../../../lib/os/crc_tables.c"
 
 void test_crc32c(void)
 {
@@ -229,10 +230,83 @@ void test_crc8(void)
 	zassert_equal(fcs, expected, "0x%02x vs 0x%02x", fcs, expected);
 }
 
+/* Bit by bit references of the table driven CRCs */
+static uint32_t ref_crc32_le(uint32_t poly, uint32_t crc, const uint8_t *data,
+			     size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		crc ^= data[i];
+		for (int b = 0; b < 8; b++) {
+			crc = (crc >> 1) ^ ((crc & 1U) ? poly : 0U);
+		}
+	}
+
+	return crc;
+}
+
+static uint16_t ref_crc16_itu_t(uint16_t crc, const uint8_t *data, size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		crc ^= (uint16_t)data[i] << 8;
+		for (int b = 0; b < 8; b++) {
+			crc = (crc << 1) ^ ((crc & 0x8000U) ? 0x1021U : 0U);
+		}
+	}
+
+	return crc;
+}
+
+/**
+ * @brief Check the selected implementation against bitwise references
+ *
+ * Word at a time implementations align the data first, so all start
+ * offsets within a word are covered, with lengths up to several words.
+ */
+void test_crc_lengths_alignments(void)
+{
+	uint8_t buf[300];
+	uint32_t seed = 1U;
+
+	for (size_t i = 0; i < sizeof(buf); i++) {
+		seed = seed * 1103515245U + 12345U;
+		buf[i] = (uint8_t)(seed >> 16);
+	}
+
+	for (size_t off = 0; off < 8; off++) {
+		for (size_t len = 0; len + off <= sizeof(buf);
+		     len += (len < 40) ? 1 : 29) {
+			const uint8_t *p = buf + off;
+
+			zassert_equal(crc32_ieee(p, len),
+				      ~ref_crc32_le(0xedb88320, ~0U, p, len),
+				      "crc32_ieee off %zu len %zu", off, len);
+			zassert_equal(crc32_c(0, p, len, true, true),
+				      ~ref_crc32_le(0x82f63b78, ~0U, p, len),
+				      "crc32_c off %zu len %zu", off, len);
+			zassert_equal(crc16_ccitt(0x1234, p, len),
+				      (uint16_t)ref_crc32_le(0x8408, 0x1234,
+							     p, len),
+				      "crc16_ccitt off %zu len %zu", off, len);
+			zassert_equal(crc16_itu_t(0x1234, p, len),
+				      ref_crc16_itu_t(0x1234, p, len),
+				      "crc16_itu_t off %zu len %zu", off, len);
+			zassert_equal(crc8_ccitt(0x5a, p, len),
+				      crc8(p, len, 0x07, 0x5a, false),
+				      "crc8_ccitt off %zu len %zu", off, len);
+		}
+	}
+
+	/* Updates in pieces give the CRC of the whole */
+	zassert_equal(crc32_ieee_update(crc32_ieee(buf, 13), buf + 13,
+					sizeof(buf) - 13),
+		      crc32_ieee(buf, sizeof(buf)), NULL);
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_crc,
 			 ztest_unit_test(test_crc32c),
+			 ztest_unit_test(test_crc_lengths_alignments),
 			 ztest_unit_test(test_crc32_ieee),
 			 ztest_unit_test(test_crc16),
 			 ztest_unit_test(test_crc16_ansi),